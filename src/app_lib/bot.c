@@ -0,0 +1,299 @@
+/**
+ *	\file		bot.c
+ *	\brief		Fichier implémentation des joueurs automatiques (choix des tirs)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <pthread.h>
+#include "placement.h"
+#include "bot.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      graine utilisée à la place d'une graine nulle (xorshift reste nul sinon)
+ */
+#define BOT_DEFAULT_SEED 	0x9E3779B97F4A7C15ULL
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * toutes les cases, les cases noires d'un damier, et celles ayant une voisine à
+ * droite ou en dessous
+ */
+static bitboard_t 		allCells, evenCells, rightLinks, downLinks;
+/**
+ * placements distincts de la flotte et nombre de navires qui les partagent (même
+ * longueur), pour la stratégie BOT_DENSITY
+ */
+static bitboard_t 		densityMasks[FLEET_SIZE * MAX_PLACEMENTS];
+static unsigned char 	densityCopies[FLEET_SIZE * MAX_PLACEMENTS];
+static int 				densityAmount;
+/**
+ * noms des stratégies
+ */
+static const char 		*strategyNames[BOT_STRATEGIES] = {"hasard", "chasse", "densite"};
+/**
+ * les masques ne sont calculés qu'une fois, au premier usage
+ */
+static pthread_once_t 	masksOnce = PTHREAD_ONCE_INIT;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Calcule les masques de la grille
+ */
+static void initMasks() {
+
+	for (int cell = 0; cell < BOARD_CELLS; cell++) {
+
+		int x = cell % BOARD_SIZE;
+		int y = cell / BOARD_SIZE;
+
+		allCells |= BIT(cell);
+
+		if ((x + y) % 2 == 0) 		evenCells |= BIT(cell);
+		if (x + 1 < BOARD_SIZE) 	rightLinks |= BIT(cell);
+		if (y + 1 < BOARD_SIZE) 	downLinks |= BIT(cell);
+
+	}
+
+	for (int ship = 0; ship < FLEET_SIZE; ship++) {
+
+		int same;
+
+		// un navire de même longueur qu'un précédent partage ses placements
+		for (same = 0; same < ship && shipLengths[same] != shipLengths[ship]; same++);
+
+		if (same < ship) {
+			for (int i = 0; i < densityAmount; i++) {
+				if (countCells(densityMasks[i]) == shipLengths[ship]) densityCopies[i]++;
+			}
+			continue;
+		}
+
+		for (int vertical = 0; vertical < 2; vertical++) {
+			for (int cell = 0; cell < BOARD_CELLS; cell++) {
+
+				bitboard_t cells = placementCells(ship, cell, vertical);
+
+				if (cells == 0) continue;
+
+				densityMasks[densityAmount] 	= cells;
+				densityCopies[densityAmount++] 	= 1;
+
+			}
+		}
+
+	}
+
+}
+/**
+ * @brief      Voisines horizontales d'un ensemble de cases
+ */
+static bitboard_t rowNeighbours(bitboard_t cells) {
+
+	return ((cells & rightLinks) << 1) | ((cells >> 1) & rightLinks);
+
+}
+/**
+ * @brief      Voisines verticales d'un ensemble de cases
+ */
+static bitboard_t columnNeighbours(bitboard_t cells) {
+
+	return ((cells & downLinks) << BOARD_SIZE) | ((cells >> BOARD_SIZE) & downLinks);
+
+}
+/**
+ * @brief      Tire une case uniformément parmi un ensemble non vide
+ */
+static int pickCell(bitboard_t cells, uint64_t *seed) {
+
+	uint64_t 	word 	= (uint64_t) cells;
+	int 		lows 	= __builtin_popcountll(word);
+	int 		total 	= lows + __builtin_popcountll((uint64_t) (cells >> 64));
+	int 		rank 	= ((nextRandom(seed) >> 32) * (uint64_t) total) >> 32;
+	int 		offset 	= 0;
+
+	if (rank >= lows) {
+		rank 	-= lows;
+		word 	= (uint64_t) (cells >> 64);
+		offset 	= 64;
+	}
+
+	// retire les rank cases les plus basses : la suivante est la case tirée
+	while (rank-- > 0) word &= word - 1;
+
+	return offset + __builtin_ctzll(word);
+
+}
+/**
+ * @brief      Cases à viser autour des touchés : dans l'alignement s'il est connu
+ */
+static bitboard_t targetCells(bot_t *bot) {
+
+	bitboard_t 	unshot 	= allCells & ~bot->shots;
+	bitboard_t 	aligned = 0;
+
+	// deux touchés voisins donnent la direction du navire
+	if (bot->open & rowNeighbours(bot->open)) 		aligned |= rowNeighbours(bot->open & rowNeighbours(bot->open));
+	if (bot->open & columnNeighbours(bot->open)) 	aligned |= columnNeighbours(bot->open & columnNeighbours(bot->open));
+
+	if (aligned & unshot) return aligned & unshot;
+
+	return (rowNeighbours(bot->open) | columnNeighbours(bot->open)) & unshot;
+
+}
+/**
+ * @brief      Cases couvertes par le plus de placements compatibles avec les tirs :
+ *             un placement passant par des touchés compte davantage
+ */
+static bitboard_t densestCells(bot_t *bot) {
+
+	bitboard_t 	unshot 	= allCells & ~bot->shots;
+	bitboard_t 	blocked = (bot->shots & ~bot->open) | bot->dead;
+	bitboard_t 	densest = 0;
+	int 		scores[BOARD_CELLS] = {0};
+	int 		top 	= 0;
+
+	for (int i = 0; i < densityAmount; i++) {
+
+		bitboard_t 	cells = densityMasks[i];
+		int 		weight;
+
+		if (cells & blocked) continue;
+
+		weight = densityCopies[i] * (1 + DENSITY_HIT_WEIGHT * countCells(cells & bot->open));
+
+		for (bitboard_t rest = cells & unshot; rest != 0; rest &= rest - 1)
+			scores[lowestCell(rest)] += weight;
+
+	}
+
+	for (bitboard_t rest = unshot; rest != 0; rest &= rest - 1) {
+
+		int cell = lowestCell(rest);
+
+		if (scores[cell] > top) {
+			top 	= scores[cell];
+			densest = 0;
+		}
+
+		if (scores[cell] == top && top > 0) densest |= BIT(cell);
+
+	}
+
+	return densest;
+
+}
+/**
+ * @brief      Prépare un bot pour une nouvelle partie
+ *
+ * @param      bot       le bot
+ * @param[in]  strategy  sa stratégie
+ * @param[in]  seed      graine de ses tirages (0 : remplacée par une graine fixe)
+ */
+void createBot(bot_t *bot, botStrategy_t strategy, uint64_t seed) {
+
+	pthread_once(&masksOnce, initMasks);
+
+	bot->strategy 	= strategy;
+	bot->shots 		= 0;
+	bot->open 		= 0;
+	bot->dead 		= 0;
+	bot->seed 		= seed != 0 ? seed : BOT_DEFAULT_SEED;
+
+}
+/**
+ * @brief      Choisit la prochaine case visée
+ *
+ * @param      bot   le bot
+ *
+ * @return     une case jamais visée, -1 si toutes l'ont été
+ */
+int botShot(bot_t *bot) {
+
+	bitboard_t unshot = allCells & ~bot->shots;
+	bitboard_t candidates;
+
+	if (unshot == 0) return -1;
+
+	switch (bot->strategy) {
+
+		case BOT_HUNT:
+
+			// le plus petit navire couvre toujours une case noire du damier
+			candidates = bot->open != 0 ? targetCells(bot) : 0;
+			if (candidates == 0) candidates = unshot & evenCells;
+			if (candidates == 0) candidates = unshot;
+			break;
+
+		case BOT_DENSITY:
+
+			candidates = densestCells(bot);
+			if (candidates == 0) candidates = unshot;
+			break;
+
+		default:
+
+			candidates = unshot;
+			break;
+
+	}
+
+	return pickCell(candidates, &bot->seed);
+
+}
+/**
+ * @brief      Prend en compte le résultat d'un tir du bot
+ *
+ * @param      bot     le bot
+ * @param[in]  cell    la case visée
+ * @param[in]  result  le résultat
+ *
+ * @note       un navire coulé referme la poursuite : les touchés restants d'un
+ *             navire voisin sont comptés avec lui
+ */
+void botRecord(bot_t *bot, int cell, shotResult_t result) {
+
+	if (cell < 0 || cell >= BOARD_CELLS || result == SHOT_INVALID) return;
+
+	bot->shots |= BIT(cell);
+
+	switch (result) {
+
+		case SHOT_HIT:
+
+			bot->open |= BIT(cell);
+			break;
+
+		case SHOT_SUNK:
+		case SHOT_WON:
+
+			bot->dead 	|= bot->open | BIT(cell);
+			bot->open 	= 0;
+			break;
+
+		default:
+
+			break;
+
+	}
+
+}
+/**
+ * @brief      Nom d'une stratégie
+ *
+ * @param[in]  strategy  la stratégie
+ *
+ * @return     le nom, NULL si la stratégie n'existe pas
+ */
+const char *botStrategyName(botStrategy_t strategy) {
+
+	return strategy >= 0 && strategy < BOT_STRATEGIES ? strategyNames[strategy] : NULL;
+
+}
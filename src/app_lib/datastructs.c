@@ -27,6 +27,20 @@ void createClientInfo(clientInfo_t *infos, char *name, userRole_t role, char *ad
 	strcpy(infos->address, address);
 	infos->role = role;
 	infos->port = port;
+	infos->peer[0] = '\0';
+
+}
+/**
+ * @brief      Convertis l'adresse applicative d'un client en structure SocketBSD
+ *
+ * @param      infos  les infos du client
+ * @param      addr   la structure d'adressage à remplir (IPv4 ou IPv6)
+ *
+ * @return     la taille utile de l'adresse, 0 si elle est invalide
+ */
+socklen_t clientInfo2struct(clientInfo_t *infos, struct sockaddr_storage *addr) {
+
+	return adr2struct(addr, infos->address, infos->port);
 
 }
 /**
@@ -45,10 +59,18 @@ void clientInfo2str(clientInfo_t *infos, char *str) {
  *
  * @param      str    le buffer sérialisé
  * @param      infos  les infos désérialisées
+ *
+ * @return     1 si les quatre champs ont été lus, 0 si le buffer est malformé
  */
-void str2clientInfo(char *str, clientInfo_t *infos) {
+int str2clientInfo(char *str, clientInfo_t *infos) {
+
+	// %d attend un int : le rôle est lu à part, un enum n'en a pas forcément la taille
+	int role;
+
+	if (sscanf(str, CLIENT_INFO_IN, infos->name, &role, infos->address, &infos->port) != 4) return 0;
 
-	sscanf(str, CLIENT_INFO_IN, infos->name, &infos->role, infos->address, &infos->port);
+	infos->role = role;
+	return 1;
 
 }
 /**
@@ -71,4 +93,29 @@ int getHostsAmount(clientInfo_t *clients, int size) {
 
 	return result;
 
+}
+/**
+ * @brief      Recherche un client dans une liste d'infos clients
+ *
+ * @param      clients  les clients
+ * @param[in]  size     la taille du tableau
+ * @param      infos    le client recherché (nom, rôle, adresse et port)
+ * @param[in]  status   l'état de connexion recherché
+ *
+ * @return     l'indice du client, -1 s'il est absent
+ */
+int findClient(clientInfo_t *clients, int size, clientInfo_t *infos, userStatus_t status) {
+
+	for (int i = 0; i < size; i++) {
+
+		if (clients[i].status == status
+			&& clients[i].role == infos->role
+			&& clients[i].port == infos->port
+			&& strcmp(clients[i].name, infos->name) == 0
+			&& strcmp(clients[i].address, infos->address) == 0) return i;
+
+	}
+
+	return -1;
+
 }
\ No newline at end of file
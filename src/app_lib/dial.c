@@ -23,15 +23,83 @@ volatile sig_atomic_t mustDisconnect = 0;
  * flag de récupération des hôtes. {CONNECT GET}
  */
 int requestHosts;
+/**
+ * flag de préchargement d'une page d'hôtes, sans attente. {CONNECT GET}
+ */
+int requestPrefetch;
+/**
+ * flag de recherche d'un adversaire. {MATCH POST}
+ */
+int requestOpponent;
+/**
+ * flag de suivi d'une partie en spectateur. {SPECTATE GET}
+ */
+int requestSpectate;
+/**
+ * traitements du serveur d'enregistrement, par action et par verbe (NULL : refusé)
+ */
+static srvEHandler_t srvEHandlers[ACTION_AMOUNT][VERB_AMOUNT];
 /*
 *****************************************************************************************
  *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
  */
+/**
+ * \brief       Charge une page d'hôtes dans le cache si elle n'y est pas déjà
+ *
+ * \param		sockAppel  	socket d'appel du client
+ * \param		cache      	le cache des hôtes
+ * \param		filter     	filtre de la liste
+ * \param		hello      	protocole convenu avec le serveur
+ * \param		page       	numéro de la page
+ *
+ * \note		une seule requête : le serveur répond par une rafale d'hôtes terminée
+ * 				par une réponse d'erreur. Un serveur de version 1 ne connaît ni filtre
+ * 				ni pagination : il n'a qu'une page.
+ */
+static void fetchHostPage(socket_t *sockAppel, hostCache_t *cache, hostFilter_t *filter, hello_t *hello, int page) {
+
+	int 			status;
+	rep_t 			response;
+	clientInfo_t 	hosts[HOST_PAGE_SIZE];
+	hostFilter_t 	paged 		= *filter;
+	int 			received 	= 0;
+	unsigned 		generation 	= getHostCacheGeneration(cache);
+
+
+	if (hasHostPage(cache, page)) return;
+
+	memset(hosts, 0, sizeof(hosts));
+
+	if (page > 0 && hello->version < 2) {
+		storeHostPage(cache, generation, page, hosts, 0);
+		return;
+	}
+
+	paged.skip 	= page * HOST_PAGE_SIZE;
+	status 		= enum2status(REQ, CONNECT);
+
+	// sans préfixe ni page, la requête d'origine : comprise de tous les serveurs
+	if (paged.prefix[0] != '\0' || paged.skip > 0) sendRequest(sockAppel, status, GET, &paged, (pFct) hostFilter2str);
+	else 											sendRequest(sockAppel, status, GET, "", NULL);
+
+	while (rcvResponse(sockAppel, &response)) {
+
+		if (response.id != enum2status(ACK, CONNECT)) break;
+
+		if (received < HOST_PAGE_SIZE)
+			str2clientInfo(response.data, &hosts[received++]);
+
+	}
+
+	storeHostPage(cache, generation, page, hosts, received);
+
+}
 /**
  * \brief       fonction s'occupant du dialogue entre le client et le serveur d'enregistrement
  * 
  * \param		params   		eCltThreadParams_t contenant les paramètres pour
- * 								le dialogue. Doit être alloué avec `malloc()`
+ * 								le dialogue. Recopiés au démarrage, ils peuvent être
+ * 								réutilisés par l'appelant une fois le dialogue lancé
  * 
  * \note 		s'occupe donc de l'envoi de requêtes et réception de réponses
  */
@@ -43,20 +111,36 @@ void dialClt2SrvE(eCltThreadParams_t *params) {
 
 	socket_t	 *sockAppel		= params->sockAppel;
 	clientInfo_t *infos 		= params->infos;
-	clientInfo_t *hosts 		= params->hostBuffer;
+	hostCache_t  *hostCache 	= params->hostCache;
+	clientInfo_t *opponent 		= params->opponent;
+	int 		 *rating 		= params->rating;
+	char 		 *spectated 	= params->spectated;
+	hostFilter_t *filter 		= params->hostFilter;
+	hello_t 	 *hello 		= params->hello;
+	hello_t 	 offer 			= {PROTOCOL_VERSION, CLT_CAPS};
 	sem_t 		 *semCanClose	= params->semCanClose;
-	sem_t 		 *semRequestFin = params->semRequestFin;
-
-	free(params);
 
 	// logMessage("Client: %s, %d, %s, %d\n", DEBUG, infos->name, infos->role, infos->address, infos->port);
 
+	// un serveur qui ne négocie pas répond par une erreur : version 1 sans capacité
+	status = enum2status(REQ, HELLO);
+	sendRequest(sockAppel, status, POST, &offer, (pFct) hello2str);
+
+	*hello = (hello_t) {1, 0};
+
+	if (!rcvResponse(sockAppel, &response)) {
+		logMessage("Serveur injoignable.\n", DEBUG);
+		sem_post(semCanClose);
+		return;
+	}
+
+	if (response.id == enum2status(ACK, HELLO)) str2hello(response.data, hello);
+
 	status = enum2status(REQ, CONNECT);
 	sendRequest(sockAppel, status, POST, infos, (pFct) clientInfo2str);
 	
 
-	rcvResponse(sockAppel, &response);
-	if (response.id != enum2status(ACK, CONNECT)) {
+	if (!rcvResponse(sockAppel, &response) || response.id != enum2status(ACK, CONNECT)) {
 		logMessage("[%d] Connexion échouée: %s.\n", DEBUG, response.id, response.data);
 		sem_post(semCanClose);
 		return;
@@ -94,35 +178,81 @@ void dialClt2SrvE(eCltThreadParams_t *params) {
 		}
 
 
+		// flags baissés avant le traitement : une requête levée pendant celui-ci est gardée
 		if (requestHosts) {
 
-			for (int i = 0; i < MAX_HOSTS_GET; i++) {
+			char 	page[12];
+			int 	wanted = getWantedHostPage(hostCache);
 
-				status = enum2status(REQ, CONNECT);
-				sendRequest(sockAppel, status, GET, "", NULL);
+			requestHosts = 0;
+			fetchHostPage(sockAppel, hostCache, filter, hello, wanted);
 
-				rcvResponse(sockAppel, &response);
+			sprintf(page, "%d", wanted);
+			params->onEvent(enum2status(ACK, CONNECT), page);
 
-				if (response.id == enum2status(ACK, CONNECT)) {
+		}
 
-					//logMessage("Client reçu.\n", DEBUG);
-					str2clientInfo(response.data, &hosts[i]);
 
-				}
+		// page suivante chargée pendant que l'utilisateur lit la page affichée
+		if (requestPrefetch) {
 
-				if (response.id == enum2status(ERR, CONNECT)) {
+			int prefetch = getPrefetchHostPage(hostCache);
 
-					//logMessage("Plus de clients à recevoir.\n", DEBUG);
-					break;
+			requestPrefetch = 0;
 
-				}
+			if (prefetch != NO_PAGE) fetchHostPage(sockAppel, hostCache, filter, hello, prefetch);
+
+		}
 
 
+		if (requestOpponent) {
+
+			char data[12] = "";
+
+			requestOpponent = 0;
+
+			if (*rating != MATCH_ANY) sprintf(data, "%d", *rating);
+
+			status = enum2status(REQ, MATCH);
+			sendRequest(sockAppel, status, POST, data, NULL);
+
+			// une seule réponse, dès que le serveur a trouvé un adversaire
+			opponent->status = DISCONNECTED;
+
+			if (rcvResponse(sockAppel, &response) && response.id == enum2status(ACK, MATCH)) {
+				str2clientInfo(response.data, opponent);
+				opponent->status = CONNECTED;
+				params->onEvent(enum2status(ACK, MATCH), "");
+			} else {
+				logMessage("[%d] Mise en relation échouée: %s.\n", DEBUG, response.id, response.data);
+				params->onEvent(enum2status(ERR, MATCH), "");
 			}
 
-			requestHosts = 0;
-			sem_post(semRequestFin);
-			
+		}
+
+
+		if (requestSpectate) {
+
+			requestSpectate = 0;
+
+			status = enum2status(REQ, SPECTATE);
+			sendRequest(sockAppel, status, GET, spectated, NULL);
+
+			if (rcvResponse(sockAppel, &response) && response.id == enum2status(ACK, SPECTATE)) {
+
+				// la partie arrive jusqu'à sa fin, signalée par une erreur
+				while (rcvResponse(sockAppel, &response)
+					&& getStatusRange(response.id) == ACK) {
+
+					params->onEvent(response.id, response.data);
+
+				}
+
+			}
+
+			logMessage("[%d] Fin du suivi: %s.\n", DEBUG, response.id, response.data);
+
+			params->onEvent(enum2status(ERR, SPECTATE), response.data);
 
 		}
 
@@ -134,145 +264,570 @@ void dialClt2SrvE(eCltThreadParams_t *params) {
  * \brief       fonction s'occupant du dialogue entre le serveur d'enregistrement et le client
  * 
  * \param		*params		structure eServThreadParams contenant les paramètres
- * 								pour le dialogue. Doit être alloué avec `malloc()`
+ * 								pour le dialogue. Ferme la socket de dialogue en fin de
+ * 								dialogue, la mémoire reste à la charge de l'appelant
  * 
  * \note		s'occupe donc de l'envoi de réponses et réception de réponses
  */
 void dialSrvE2Clt(eServThreadParams_t *params) {
 
 	int 			running		= 1;
-	int 			current	 	= 0;
+	socket_t 		*sockDial 	= params->sockDial;
+	
+
+	while(running)	// daemon !
+	{	
+		
+		req_t request;		
+
+		// connexion fermée sans DELETE : le client est parti
+		if (!rcvRequest(sockDial, &request)) {
+			dropSrvEClient(params);
+			break;
+		}
+		
+		running = processSrvERequest(params, &request);
+		flushResponses(sockDial);
+		
+	}
+
+	// Fermer la socket de dialogue
+	close(sockDial->fd);
+
+}
+/**
+ * \brief       Traite une requête reçue par le serveur d'enregistrement
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 si le dialogue continue, 0 s'il doit se terminer
+ *
+ * \note		une seule lecture de la table des traitements (setupSrvEHandlers) ;
+ * 				une requête sans traitement reçoit une erreur de son action
+ *
+ * \note		les réponses sont seulement empilées sur params->sockDial :
+ * 				c'est à l'appelant de les émettre
+ */
+int processSrvERequest(eServThreadParams_t *params, req_t *request) {
+
+	action_t 		action 	= getAction(request->id);
+	srvEHandler_t 	handler = NULL;
+
+
+	if (getStatusRange(request->id) == REQ && action != ACTION_UNKNOWN && request->verb < VERB_AMOUNT)
+		handler = srvEHandlers[action][request->verb];
+
+	if (handler == NULL) {
+		queueResponse(params->sockDial, enum2status(ERR, action), "Code de status non géré", NULL);
+		return 1;
+	}
+
+	return handler(params, request);
+
+}
+/**
+ * \brief       Enregistre le traitement d'une action et d'un verbe du protocole
+ *
+ * \param		action   	l'action des requêtes traitées
+ * \param		verb     	leur verbe
+ * \param		handler  	le traitement (NULL : requête refusée)
+ */
+void registerSrvEHandler(action_t action, verb_t verb, srvEHandler_t handler) {
+
+	srvEHandlers[action][verb] = handler;
+
+}
+/**
+ * \brief       Enregistre les traitements du serveur d'enregistrement
+ *
+ * \note		à appeler une fois au démarrage, avant le premier processSrvERequest
+ */
+void setupSrvEHandlers() {
+
+	registerSrvEHandler(HELLO, 		POST, 	processSrvEHello);
+
+	registerSrvEHandler(CONNECT, 	POST, 	processSrvEConnect);
+	registerSrvEHandler(CONNECT, 	DELETE, processSrvEDisconnect);
+	registerSrvEHandler(CONNECT, 	GET, 	processSrvEListHosts);
+
+	registerSrvEHandler(MATCH, 		POST, 	processSrvEMatch);
+	registerSrvEHandler(MATCH, 		DELETE, processSrvEMatch);
+
+	registerSrvEHandler(SPECTATE, 	GET, 	processSrvESpectate);
+	registerSrvEHandler(SPECTATE, 	POST, 	processSrvESpectate);
+	registerSrvEHandler(SPECTATE, 	DELETE, processSrvESpectate);
+
+	// CELL, GAME et CURRENT_PLAYER s'échangent entre joueur et hôte : refusés ici
+
+}
+/**
+ * \brief       Enregistre un client (CONNECT POST)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		0 si le serveur est plein, 1 sinon (client enregistré, infos ou rôle
+ * 				invalides)
+ *
+ * \note		un client restauré d'un instantané reprend son entrée, s'il se
+ * 				reconnecte depuis l'adresse d'où il s'était enregistré
+ */
+int processSrvEConnect(eServThreadParams_t *params, req_t *request) {
+
+	int 			status;
+	int 			pending;
+	clientInfo_t 	infos 		= {0};
+	char 			peer[ADDR_SIZE];
 
 	int 			id 			= params->id;
 	socket_t 		*sockDial 	= params->sockDial;
 	clientInfo_t 	*clients 	= params->clientArray;
-	clientInfo_t 	*client 	= &clients[id];			// dangereux lorsque serv enr. plein. mais soit.
+	// id négatif : connexion acceptée alors que le serveur était plein
+	clientInfo_t 	*client 	= id >= 0 ? &clients[id] : NULL;
 
 
-	int 		clientAmount	= params->clientAmount;
+	// infos incomplètes : rien n'est cherché ni écrit dans le registre
+	if (!str2clientInfo(request->data, &infos)) {
+		status = enum2status(ERR, CONNECT);
+		queueResponse(sockDial, status, "Infos client invalides.", NULL);
+		return 1;
+	}
 
+	// le rôle indexe les files de mise en relation : contrôlé une fois ici
+	if (infos.role != PLAYER && infos.role != HOST) {
+		status = enum2status(ERR, CONNECT);
+		queueResponse(sockDial, status, "Rôle invalide.", NULL);
+		return 1;
+	}
 
-	void (*onDisconnect)(int) 	= params->terminationCallback;
-	int  (*canAccept)()			= params->canAccept;
+	// un client restauré d'un instantané reprend son entrée : les infos annoncées
+	// se recopient, l'adresse vue par le serveur non
+	struct2adr(&sockDial->addrDst, peer, NULL);
+	pending = findClient(clients, params->clientAmount, &infos, PENDING);
+	if (pending >= 0 && strcmp(clients[pending].peer, peer) != 0) pending = -1;
 
+	if (pending >= 0) {
 
-	free(params);
+		if (client != NULL) {
+			client->status = DISCONNECTED;
+			params->terminationCallback(id);
+		}
+
+		params->id 	= pending;
+		client 		= &clients[pending];
+
+	}
+	else if (client == NULL || !params->canAccept()) {
+		status = enum2status(ERR, CONNECT);
+		queueResponse(sockDial, status, "Serveur d'enregistrement plein.", NULL);
+		if (client != NULL) client->status = DISCONNECTED;
+		return 0;
+	}
 	
+	// le nom change : l'entrée est réindexée
+	if (params->names != NULL) unindexClient(params->names, params->id);
 
-	while(running)	// daemon !
-	{	
-		
-		req_t request;		
-		rcvRequest(sockDial, &request);
-		
-		
-		switch (request.id) {
-			
-			case 101:
+	str2clientInfo(request->data, client);
+	strcpy(client->peer, peer);
+	client->status = CONNECTED;
 
-				int status;
-				
-				if (request.verb == POST) {
+	if (params->names != NULL) indexClient(params->names, params->id);
 
-					if (!canAccept()) {
-						status = enum2status(ERR, CONNECT);
-						sendResponse(sockDial, status, "Serveur d'enregistrement plein.", NULL);
-						client->status = DISCONNECTED;
-						running = 0;
-						break;
-					}
-					
-					str2clientInfo(request.data, client);
-					client->status = CONNECTED;
+	// logMessage("Client connecté: %s, %d, %s, %d\n", DEBUG, client->name, client->status, client->address, client->port);
 
-					// logMessage("Client connecté: %s, %d, %s, %d\n", DEBUG, client->name, client->status, client->address, client->port);
+	status = enum2status(ACK, CONNECT);
+	queueResponse(sockDial, status, "Connexion réussie", NULL);
+	return 1;
 
-					status = enum2status(ACK, CONNECT);
-					sendResponse(sockDial, status, "Connexion réussie", NULL);
-					break;
+}
+/**
+ * \brief       Désenregistre un client et termine le dialogue (CONNECT DELETE)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		0 : le dialogue se termine
+ */
+int processSrvEDisconnect(eServThreadParams_t *params, req_t *request) {
 
-				}
+	int status = enum2status(ACK, CONNECT);
 
-				if (request.verb == DELETE) {
+	// signature commune des traitements (srvEHandler_t) : la requête est sans données
+	(void) request;
 
-					running = 0;
+	queueResponse(params->sockDial, status, "Déconnexion réussie", NULL);
+	dropSrvEClient(params);
+	return 0;
 
-					client->status = DISCONNECTED;
+}
+/**
+ * \brief       Liste une page des clients satisfaisant un filtre, locaux puis distants,
+ *              terminée par une erreur (CONNECT GET [rôle,statut,préfixe[,sautés]],
+ *              sans filtre : premiers hôtes)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		toutes les réponses partent en un seul appel système ; les hôtes
+ * 				restaurés restent listés en attendant leur reconnexion. Une page
+ * 				pleine (MAX_HOSTS_GET) annonce qu'il peut en rester.
+ */
+int processSrvEListHosts(eServThreadParams_t *params, req_t *request) {
 
-					status = enum2status(ACK, CONNECT);
-					sendResponse(sockDial, status, "Déconnexion réussie", NULL);
-					onDisconnect(id);
-					break;
+	int 			status;
+	int 			ids[MAX_HOSTS_GET];
+	int 			sent 		= 0;
+	hostFilter_t 	filter;
+	socket_t 		*sockDial 	= params->sockDial;
+	clientInfo_t 	*clients 	= params->clientArray;
 
-				}
 
-				if (request.verb == GET) {
+	if (!str2hostFilter(request->data, &filter)) {
+		status = enum2status(ERR, CONNECT);
+		queueResponse(sockDial, status, "Filtre invalide.", NULL);
+		return 1;
+	}
 
-					int found = 0;
+	// par l'index : seuls les noms commençant par le préfixe sont parcourus
+	if (params->names != NULL) {
+		sent = filterClients(params->names, &filter, ids, MAX_HOSTS_GET);
+	}
+	else {
+		for (int i = 0; i < params->clientAmount && sent < MAX_HOSTS_GET; i++) {
 
-					for (int i = current; i < clientAmount; i++) {
+			if (!matchesFilter(&clients[i], &filter)) continue;
 
-						if (clients[i].role == HOST && clients[i].status == CONNECTED) {
+			if (filter.skip > 0) 	filter.skip--;
+			else 					ids[sent++] = i;
 
-							status = enum2status(ACK, CONNECT);
-							sendResponse(sockDial, status, &clients[i], (pFct) clientInfo2str);
+		}
+	}
 
-							found   = 1;
-							current = i+1;
+	for (int i = 0; i < sent; i++) {
+		status = enum2status(ACK, CONNECT);
+		queueResponse(sockDial, status, &clients[ids[i]], (pFct) clientInfo2str);
+	}
 
-						}
+	// puis les hôtes enregistrés sur les autres serveurs, filter.skip : restant à sauter
+	if (params->listRemoteHosts != NULL && sent < MAX_HOSTS_GET
+		&& (filter.role == FILTER_ANY || filter.role == HOST)) {
 
-					}
+		clientInfo_t 	remote[MAX_HOSTS_GET];
+		int 			amount = params->listRemoteHosts(remote, MAX_HOSTS_GET - sent, &filter);
 
-					if (!found) {
-					
-						status 	= enum2status(ERR, CONNECT);
-						sendResponse(sockDial, status, "", NULL);
-						current = 0;
-					
-					}
+		for (int i = 0; i < amount; i++) {
 
-					break;
+			status = enum2status(ACK, CONNECT);
+			queueResponse(sockDial, status, &remote[i], (pFct) clientInfo2str);
 
-				}
+		}
 
-				break;
+	}
 
+	// fin de liste
+	status 	= enum2status(ERR, CONNECT);
+	queueResponse(sockDial, status, "", NULL);
 
-			default:
-				action_t act = getAction(request.id);
-				status = enum2status(ERR, act);
-				sendResponse(sockDial, status, "Code de status non géré", NULL);
-				break;
-			
-		}
-		
+	return 1;
+
+}
+/**
+ * \brief       Convient de la version et des capacités du protocole (HELLO POST)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue : version,capacités proposées
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		répond par la version et les capacités convenues, en vigueur à
+ * 				partir de la requête suivante. Un client qui ne négocie pas garde
+ * 				la version 1 sans capacité.
+ */
+int processSrvEHello(eServThreadParams_t *params, req_t *request) {
+
+	int 		status;
+	hello_t 	offer;
+	hello_t 	supported 	= {PROTOCOL_VERSION, SRVE_CAPS};
+
+
+	if (!str2hello(request->data, &offer)) {
+		status = enum2status(ERR, HELLO);
+		queueResponse(params->sockDial, status, "Négociation invalide.", NULL);
+		return 1;
 	}
 
-	// Fermer la socket de dialogue
-	close(sockDial->fd);
+	negotiateHello(&offer, &supported, &params->hello);
+
+	status = enum2status(ACK, HELLO);
+	queueResponse(params->sockDial, status, &params->hello, (pFct) hello2str);
+	return 1;
+
+}
+/**
+ * \brief       Traite une requête de mise en relation (MATCH)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		POST [classement] : répond, à lui et à l'attente choisie, par les infos
+ * 				de l'autre client dès qu'un client de l'autre rôle compatible est en
+ * 				attente. DELETE : abandonne l'attente.
+ */
+int processSrvEMatch(eServThreadParams_t *params, req_t *request) {
+
+	int 					status;
+	int 					rating 		= MATCH_ANY;
+	socket_t 				*sockDial 	= params->sockDial;
+	eServThreadParams_t 	*peer;
+	clientInfo_t 			*self;
+
+
+	if (params->matchmaker == NULL || params->id < 0) {
+		status = enum2status(ERR, MATCH);
+		queueResponse(sockDial, status, "Mise en relation indisponible.", NULL);
+		return 1;
+	}
+
+	// une entrée pas encore enregistrée garde le nom et le rôle de son occupant précédent
+	if (params->clientArray[params->id].status != CONNECTED) {
+		status = enum2status(ERR, MATCH);
+		queueResponse(sockDial, status, "Client non enregistré.", NULL);
+		return 1;
+	}
+
+	if (request->verb == DELETE) {
+		cancelSrvEMatch(params, NULL);
+		status = enum2status(ACK, MATCH);
+		queueResponse(sockDial, status, "Attente annulée", NULL);
+		return 1;
+	}
+
+	if (request->verb != POST || params->matchTicket >= 0) {
+		status = enum2status(ERR, MATCH);
+		queueResponse(sockDial, status, "Déjà en attente.", NULL);
+		return 1;
+	}
+
+	self = &params->clientArray[params->id];
+	sscanf(request->data, "%d", &rating);
+
+	peer = requestMatch(params->matchmaker, self->role, rating, params, &params->matchTicket);
+
+	if (peer != NULL) {
+
+		// l'autre client attend sans rien avoir à émettre : le réveiller
+		int idle = peer->sockDial->nbSortie == 0;
+
+		peer->matchTicket = -1;
+
+		status = enum2status(ACK, MATCH);
+		queueResponse(sockDial, status, &peer->clientArray[peer->id], (pFct) clientInfo2str);
+		queueResponse(peer->sockDial, status, self, (pFct) clientInfo2str);
+
+		if (idle) params->wakeCallback(peer);
+
+	}
+	else if (params->matchTicket < 0) {
+
+		status = enum2status(ERR, MATCH);
+		queueResponse(sockDial, status, "File d'attente pleine.", NULL);
+
+	}
+
+	return 1;
+
+}
+/**
+ * \brief       Retire un client de la file de mise en relation
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		reason   	motif envoyé au client dans une réponse d'erreur
+ * 							(NULL : aucune réponse)
+ */
+void cancelSrvEMatch(eServThreadParams_t *params, char *reason) {
 
-	// supprimer la socket_t du heap
-	free(sockDial);
+	int status;
+
+	if (params->matchTicket < 0) return;
+
+	cancelMatch(params->matchmaker, params->matchTicket);
+	params->matchTicket = -1;
+
+	if (reason == NULL) return;
+
+	status = enum2status(ERR, MATCH);
+	queueResponse(params->sockDial, status, reason, NULL);
 
 }
+/**
+ * \brief       Traite une requête de spectateur ou d'hôte diffusant sa partie (SPECTATE)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		GET hôte : suit la partie de l'hôte. POST status:données (hôte) :
+ * 				publie un événement, sans réponse sauf erreur. DELETE : le spectateur
+ * 				se désabonne, l'hôte termine sa partie.
+ */
+int processSrvESpectate(eServThreadParams_t *params, req_t *request) {
+
+	int 			status;
+	short 			event;
+	int 			offset 		= 0;
+	socket_t 		*sockDial 	= params->sockDial;
+	clientInfo_t 	*self;
+
+
+	if (params->relay == NULL || params->id < 0) {
+		status = enum2status(ERR, SPECTATE);
+		queueResponse(sockDial, status, "Spectateurs indisponibles.", NULL);
+		return 1;
+	}
+
+	self = &params->clientArray[params->id];
+
+	// une entrée pas encore enregistrée garde le nom et le rôle de son occupant précédent
+	if (self->status != CONNECTED) {
+		status = enum2status(ERR, SPECTATE);
+		queueResponse(sockDial, status, "Client non enregistré.", NULL);
+		return 1;
+	}
 
+	switch (request->verb) {
 
+		case GET:
 
+			if (params->spectator != NULL) {
+				status = enum2status(ERR, SPECTATE);
+				queueResponse(sockDial, status, "Déjà spectateur.", NULL);
+				return 1;
+			}
+
+			params->spectator = subscribeGame(params->relay, request->data, sockDial, params);
+
+			status = enum2status(params->spectator != NULL ? ACK : ERR, SPECTATE);
+			queueResponse(sockDial, status, params->spectator != NULL
+				? "Abonnement réussi" : "Partie introuvable.", NULL);
+			return 1;
+
+		case POST:
+
+			// seuls les résultats de tir, changements de joueur et instantanés sont relayés
+			if (self->role == HOST
+				&& sscanf(request->data, "%hd:%n", &event, &offset) == 1 && offset > 0
+				&& getStatusRange(event) == ACK
+				&& (getAction(event) == CELL || getAction(event) == GAME
+					|| getAction(event) == CURRENT_PLAYER)) {
+
+				if (publishEvent(params->relay, self->name, event, request->data + offset) == 0)
+					return 1;
+
+			}
+
+			status = enum2status(ERR, SPECTATE);
+			queueResponse(sockDial, status, "Événement refusé.", NULL);
+			return 1;
+
+		case DELETE:
+
+			if (params->spectator != NULL) cancelSrvESpectate(params, NULL);
+			else if (self->role == HOST) 	endGame(params->relay, self->name, FLOW_END);
+
+			status = enum2status(ACK, SPECTATE);
+			queueResponse(sockDial, status, "Fin du suivi", NULL);
+			return 1;
+
+	}
+
+	return 1;
+
+}
 /**
- * \brief      Envoie une requête via un flag et attends une sémaphore.
+ * \brief       Désabonne un client de la partie qu'il regarde
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		reason   	motif envoyé au client dans une réponse d'erreur
+ * 							(NULL : aucune réponse)
+ */
+void cancelSrvESpectate(eServThreadParams_t *params, char *reason) {
+
+	int status;
+
+	if (params->spectator == NULL) return;
+
+	unsubscribeGame(params->spectator);
+	params->spectator = NULL;
+
+	if (reason == NULL) return;
+
+	status = enum2status(ERR, SPECTATE);
+	queueResponse(params->sockDial, status, reason, NULL);
+
+}
+/**
+ * \brief       Prévient un spectateur de la fin de la partie qu'il regardait
+ *
+ * \param		owner   	paramètres du dialogue avec le spectateur, déjà désabonné
+ *
+ * \note		à fournir au relais (createRelay)
+ */
+void endSrvESpectate(void *owner) {
+
+	eServThreadParams_t *params = owner;
+	int 				status 	= enum2status(ERR, SPECTATE);
+
+	params->spectator = NULL;
+
+	// un spectateur n'a jamais d'émission en cours par le moteur d'E/S
+	queueResponse(params->sockDial, status, "Partie terminée.", NULL);
+	params->wakeCallback(params);
+
+}
+/**
+ * \brief       Libère l'entrée du registre d'un client dont le dialogue se termine
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ */
+void dropSrvEClient(eServThreadParams_t *params) {
+
+	cancelSrvEMatch(params, NULL);
+	cancelSrvESpectate(params, NULL);
+
+	if (params->id < 0) return;
+
+	// la partie diffusée par un hôte s'arrête avec lui
+	if (params->relay != NULL && params->clientArray[params->id].role == HOST)
+		endGame(params->relay, params->clientArray[params->id].name, FLOW_LEAVE);
+
+	if (params->names != NULL) unindexClient(params->names, params->id);
+
+	params->clientArray[params->id].status = DISCONNECTED;
+	params->terminationCallback(params->id);
+
+	// n'appeler la terminaison qu'une fois
+	params->id = -1;
+
+}
+
+
+
+/**
+ * \brief      Envoie une requête via un flag, sans attendre sa fin
  *
  * \param      reqVar     Flag de la requête
- * \param      semReqAck  Sémaphore d'attente
+ *
+ * \note       la fin de la requête est signalée par eCltThreadParams_t.onEvent
  */
-void postRequest(int *reqVar, sem_t *semReqAck) {
+void postRequest(int *reqVar) {
 
 	*reqVar = 1;
 	//logMessage("Requête commencée...\n", DEBUG);
-	
-	sem_wait(semReqAck);
-	
-	//logMessage("Requête finie.\n", DEBUG);
-	*reqVar = 0;
 
 }
@@ -0,0 +1,323 @@
+/**
+ *	\file		discovery.c
+ *	\brief		Fichier implémentation de la découverte sur le LAN du serveur d'enregistrement
+ *				et des hôtes (mode sans serveur)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include "discovery.h"
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * @brief destinations des sondes : diffusion LAN et serveur sur la même machine
+ */
+static char *probeTargets[] = {DISCOVERY_BROADCAST, "127.0.0.1"};
+/**
+ * @brief destinations des sondes de recherche d'hôtes : diffusion LAN et groupe multicast
+ */
+static char *hostProbeTargets[] = {DISCOVERY_BROADCAST, HOST_DISCOVERY_GROUP};
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S   L O C A L E S
+ */
+/**
+ * @brief      Envoie une sonde à une liste de destinations
+ *
+ * @param      sockDisc  socket DGRAM (diffusion autorisée)
+ * @param      probe     contenu de la sonde
+ * @param      targets   adresses des destinations
+ * @param[in]  amount    nombre de destinations
+ * @param[in]  port      port des destinations
+ */
+static void sendProbes(socket_t *sockDisc, char *probe, char **targets, int amount, short port) {
+
+	for (int i = 0; i < amount; i++) {
+
+		struct sockaddr_storage target;
+		socklen_t 				targetLen = adr2struct(&target, targets[i], port);
+
+		if (targetLen == 0) continue;
+
+		// une cible injoignable (pas de route de diffusion...) n'est pas une erreur
+		sendto(sockDisc->fd, probe, strlen(probe) + 1, 0
+			, (struct sockaddr *) &target, targetLen);
+
+	}
+
+}
+/**
+ * @brief      Calcule le temps restant avant une échéance
+ *
+ * @param      deadline  l'échéance (CLOCK_MONOTONIC)
+ *
+ * @return     le temps restant en millisecondes (négatif si dépassée)
+ */
+static int remainingMs(struct timespec *deadline) {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (deadline->tv_sec - now.tv_sec) * 1000
+		 + (deadline->tv_nsec - now.tv_nsec) / 1000000L;
+
+}
+/**
+ * @brief      Attend un lot de sondes ; une erreur de réception est signalée puis
+ *             suivie d'une pause, pour ne pas boucler sur une erreur persistante
+ *
+ * @param      sockDisc  socket DGRAM des sondes
+ * @param      probes    le lot à remplir (MAX_LOT datagrammes)
+ *
+ * @return     le nombre de sondes reçues (au moins une)
+ */
+static int receiveProbes(socket_t *sockDisc, datagramme_t *probes) {
+
+	while (1) {
+
+		int received = recevoirLot(sockDisc, probes, MAX_LOT);
+
+		if (received > 0) return received;
+		if (received == -1 && errno == EINTR) continue;
+
+		perror("Can't receive probes");
+		poll(NULL, 0, DISCOVERY_BACKOFF);
+
+	}
+
+}
+/**
+ * @brief      Calcule une échéance à partir d'un délai
+ *
+ * @param      deadline  l'échéance à remplir (CLOCK_MONOTONIC)
+ * @param[in]  timeout   le délai en millisecondes
+ */
+static void setDeadline(struct timespec *deadline, int timeout) {
+
+	clock_gettime(CLOCK_MONOTONIC, deadline);
+	deadline->tv_sec  += timeout / 1000;
+	deadline->tv_nsec += (timeout % 1000) * 1000000L;
+
+	if (deadline->tv_nsec >= 1000000000L) {
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000L;
+	}
+
+}
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Répond aux sondes de découverte reçues sur une socket DGRAM
+ *
+ * @param      sockDisc  socket DGRAM liée au port DISCOVERY_PORT
+ * @param[in]  port      port TCP du serveur d'enregistrement à annoncer
+ */
+void serveSrvEDiscovery(socket_t *sockDisc, short port) {
+
+	static datagramme_t 	probes[MAX_LOT];
+	static datagramme_t 	replies[MAX_LOT];
+
+	char 	reply[MAX_BUFFER];
+	int 	replyLen = sprintf(reply, DISCOVERY_REPLY, port) + 1;
+
+
+	while (1) {
+
+		int received = receiveProbes(sockDisc, probes);
+		int answers  = 0;
+
+		for (int i = 0; i < received; i++) {
+
+			if (strcmp(probes[i].buff, DISCOVERY_PROBE) != 0) continue;
+
+			memcpy(replies[answers].buff, reply, replyLen);
+			replies[answers].len 		= replyLen;
+			replies[answers].addr 		= probes[i].addr;
+			replies[answers].addrLen 	= probes[i].addrLen;
+			answers++;
+
+		}
+
+		if (answers > 0) envoyerLot(sockDisc, replies, answers);
+
+	}
+
+}
+/**
+ * @brief      Cherche un serveur d'enregistrement sur le LAN
+ *
+ * @param[out] adrIP    adresse du serveur trouvé (ADR_SIZE octets)
+ * @param[out] port     port du serveur trouvé
+ * @param[in]  timeout  délai d'attente maximum en millisecondes
+ *
+ * @return     1 si un serveur a répondu, 0 sinon
+ */
+int discoverSrvE(char *adrIP, short *port, int timeout) {
+
+	socket_t 			sockDisc 	= creerSocket(PF_INET, SOCK_DGRAM);
+	struct pollfd 		pfd 		= {sockDisc.fd, POLLIN, 0};
+	struct timespec 	deadline;
+	int 				found 		= 0;
+	int 				remaining;
+	int 				opt 		= 1;
+
+
+	setsockopt(sockDisc.fd, SOL_SOCKET, SO_BROADCAST, &opt, sizeof(opt));
+
+	sendProbes(&sockDisc, DISCOVERY_PROBE, probeTargets
+		, sizeof(probeTargets) / sizeof(probeTargets[0]), DISCOVERY_PORT);
+
+	setDeadline(&deadline, timeout);
+
+	while (!found && (remaining = remainingMs(&deadline)) > 0 && poll(&pfd, 1, remaining) > 0) {
+
+		buffer_t reply;
+		recevoir(&sockDisc, reply, NULL);
+
+		if (sscanf(reply, DISCOVERY_REPLY, port) == 1) {
+
+			struct2adr(&sockDisc.addrDst, adrIP, NULL);
+			found = 1;
+
+		}
+
+	}
+
+	close(sockDisc.fd);
+
+	return found;
+
+}
+/**
+ * @brief      Crée la socket DGRAM de réponse aux sondes de recherche d'hôtes
+ *
+ * @return     socket liée au port HOST_DISCOVERY_PORT et abonnée à HOST_DISCOVERY_GROUP
+ */
+socket_t createHostDiscoverySocket() {
+
+	// creerSocketAdr active SO_REUSEADDR : plusieurs hôtes par machine
+	socket_t 		sockDisc = creerSocketAdr(SOCK_DGRAM, "0.0.0.0", HOST_DISCOVERY_PORT);
+	struct ip_mreq 	mreq;
+
+	inet_pton(AF_INET, HOST_DISCOVERY_GROUP, &mreq.imr_multiaddr);
+	mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+	// sans interface multicast, la diffusion suffit
+	setsockopt(sockDisc.fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+
+	return sockDisc;
+
+}
+/**
+ * @brief      Répond aux sondes de recherche d'hôtes avec les infos du client HOST
+ *
+ * @param      sockDisc  socket créée par createHostDiscoverySocket()
+ * @param      infos     infos du client HOST à annoncer
+ */
+void serveHostDiscovery(socket_t *sockDisc, clientInfo_t *infos) {
+
+	static datagramme_t 	probes[MAX_LOT];
+	static datagramme_t 	replies[MAX_LOT];
+
+	char 	reply[MAX_BUFFER];
+	int 	replyLen;
+
+
+	replyLen = sprintf(reply, HOST_DISCOVERY_REPLY);
+	clientInfo2str(infos, reply + replyLen);
+	replyLen = strlen(reply) + 1;
+
+	while (1) {
+
+		int received = receiveProbes(sockDisc, probes);
+		int answers  = 0;
+
+		for (int i = 0; i < received; i++) {
+
+			if (strcmp(probes[i].buff, HOST_DISCOVERY_PROBE) != 0) continue;
+
+			memcpy(replies[answers].buff, reply, replyLen);
+			replies[answers].len 		= replyLen;
+			replies[answers].addr 		= probes[i].addr;
+			replies[answers].addrLen 	= probes[i].addrLen;
+			answers++;
+
+		}
+
+		if (answers > 0) envoyerLot(sockDisc, replies, answers);
+
+	}
+
+}
+/**
+ * @brief      Cherche les hôtes du LAN sans serveur d'enregistrement
+ *
+ * @param[out] hosts    tableau des hôtes trouvés
+ * @param[in]  max      taille du tableau
+ * @param[in]  timeout  durée de la collecte des réponses en millisecondes
+ *
+ * @return     le nombre d'hôtes distincts trouvés
+ */
+int discoverHosts(clientInfo_t *hosts, int max, int timeout) {
+
+	static datagramme_t replies[MAX_LOT];
+
+	socket_t 			sockDisc 	= creerSocket(PF_INET, SOCK_DGRAM);
+	struct pollfd 		pfd 		= {sockDisc.fd, POLLIN, 0};
+	struct timespec 	deadline;
+	int 				found 		= 0;
+	int 				remaining;
+	int 				opt 		= 1;
+	int 				prefixLen 	= strlen(HOST_DISCOVERY_REPLY);
+
+
+	setsockopt(sockDisc.fd, SOL_SOCKET, SO_BROADCAST, &opt, sizeof(opt));
+
+	sendProbes(&sockDisc, HOST_DISCOVERY_PROBE, hostProbeTargets
+		, sizeof(hostProbeTargets) / sizeof(hostProbeTargets[0]), HOST_DISCOVERY_PORT);
+
+	setDeadline(&deadline, timeout);
+
+	// on collecte jusqu'à l'échéance : tous les hôtes doivent avoir le temps de répondre
+	while (found < max && (remaining = remainingMs(&deadline)) > 0 && poll(&pfd, 1, remaining) > 0) {
+
+		int received = recevoirLot(&sockDisc, replies, MAX_LOT);
+
+		for (int i = 0; i < received && found < max; i++) {
+
+			clientInfo_t 	host;
+			int 			duplicate = 0;
+
+			if (strncmp(replies[i].buff, HOST_DISCOVERY_REPLY, prefixLen) != 0) continue;
+
+			// une réponse malformée (ou d'un autre rôle) est ignorée
+			if (!str2clientInfo(replies[i].buff + prefixLen, &host) || host.role != HOST) continue;
+
+			// l'adresse vue sur le réseau fait foi, pas celle annoncée
+			struct2adr(&replies[i].addr, host.address, NULL);
+			host.status = CONNECTED;
+
+			for (int j = 0; j < found && !duplicate; j++) {
+				duplicate = hosts[j].port == host.port
+						 && strcmp(hosts[j].address, host.address) == 0;
+			}
+
+			if (!duplicate) hosts[found++] = host;
+
+		}
+
+	}
+
+	close(sockDisc.fd);
+
+	return found;
+
+}
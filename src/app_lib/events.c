@@ -0,0 +1,83 @@
+/**
+ *	\file		events.c
+ *	\brief		Fichier implémentation de la file d'événements du dialogue vers l'interface
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "events.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une file d'événements vide
+ *
+ * @param      queue  la file à initialiser
+ *
+ * @note       termine le programme si le tube ne peut être créé
+ */
+void createEventQueue(eventQueue_t *queue) {
+
+	if (pipe(queue->fds) == -1) {
+		perror("Can't create event queue");
+		exit(EXIT_FAILURE);
+	}
+
+	// ni le dialogue qui écrit, ni l'interface qui vide la file n'attendent
+	for (int i = 0; i < 2; i++) {
+		fcntl(queue->fds[i], F_SETFL, fcntl(queue->fds[i], F_GETFL) | O_NONBLOCK);
+		fcntl(queue->fds[i], F_SETFD, FD_CLOEXEC);
+	}
+
+}
+/**
+ * @brief      Descripteur à surveiller : lisible quand un événement est en attente
+ *
+ * @param      queue  la file
+ *
+ * @return     le descripteur de lecture
+ */
+int getEventFd(eventQueue_t *queue) {
+
+	return queue->fds[0];
+
+}
+/**
+ * @brief      Ajoute un événement, sans jamais bloquer l'appelant
+ *
+ * @param      queue   la file
+ * @param[in]  status  code d'état
+ * @param      data    données (tronquées à DATA_LENGTH)
+ *
+ * @return     1 si l'événement est ajouté, 0 si la file est pleine
+ */
+int postEvent(eventQueue_t *queue, short status, char *data) {
+
+	uiEvent_t event;
+
+	memset(&event, 0, sizeof(uiEvent_t));
+	event.status = status;
+	strncpy(event.data, data, DATA_LENGTH - 1);
+
+	return write(queue->fds[1], &event, sizeof(uiEvent_t)) == sizeof(uiEvent_t);
+
+}
+/**
+ * @brief      Retire le prochain événement, sans attendre
+ *
+ * @param      queue  la file
+ * @param      event  l'événement retiré
+ *
+ * @return     1 si un événement est retiré, 0 si la file est vide
+ */
+int nextEvent(eventQueue_t *queue, uiEvent_t *event) {
+
+	return read(queue->fds[0], event, sizeof(uiEvent_t)) == sizeof(uiEvent_t);
+
+}
@@ -0,0 +1,195 @@
+/**
+ *	\file		game.c
+ *	\brief		Fichier implémentation du moteur de partie (grilles en bitboards et règles du tir)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <string.h>
+#include "game.h"
+#include "replay.h"
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * @brief longueur de chaque navire de la flotte
+ */
+const int shipLengths[FLEET_SIZE] = {5, 4, 3, 3, 2};
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Cases occupées par un navire
+ *
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue (coin haut gauche)
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     les cases, 0 si le navire sort de la grille
+ */
+bitboard_t shipCells(int ship, int cell, int vertical) {
+
+	int 		length 	= shipLengths[ship];
+	int 		x 		= cell % BOARD_SIZE;
+	int 		y 		= cell / BOARD_SIZE;
+	bitboard_t 	cells 	= 0;
+
+	if (cell < 0 || cell >= BOARD_CELLS) return 0;
+	if (vertical ? y + length > BOARD_SIZE : x + length > BOARD_SIZE) return 0;
+
+	for (int i = 0; i < length; i++) cells |= BIT(cell + i * (vertical ? BOARD_SIZE : 1));
+
+	return cells;
+
+}
+/**
+ * @brief      Nombre de cases d'un bitboard
+ *
+ * @param[in]  cells  les cases
+ *
+ * @return     le nombre de bits à 1
+ */
+int countCells(bitboard_t cells) {
+
+	return __builtin_popcountll((uint64_t) cells) + __builtin_popcountll((uint64_t) (cells >> 64));
+
+}
+/**
+ * @brief      Case la plus basse d'un bitboard
+ *
+ * @param[in]  cells  les cases, non vide
+ *
+ * @return     l'indice de la case
+ */
+int lowestCell(bitboard_t cells) {
+
+	uint64_t low = (uint64_t) cells;
+
+	return low != 0 ? __builtin_ctzll(low) : 64 + __builtin_ctzll((uint64_t) (cells >> 64));
+
+}
+/**
+ * @brief      Prépare une partie sans navire
+ *
+ * @param      match  la partie
+ * @param      log    journal de la partie (NULL : aucun), déjà démarré par startReplay
+ */
+void createMatch(match_t *match, struct replayLog *log) {
+
+	memset(match->boards, 0, sizeof(match->boards));
+
+	match->current 	= 0;
+	match->turn 	= 0;
+	match->winner 	= NO_WINNER;
+	match->log 		= log;
+
+}
+/**
+ * @brief      Place un navire d'un joueur
+ *
+ * @param      match     la partie
+ * @param[in]  player    le joueur (0 ou 1)
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     0, -1 si le navire est déjà placé, sort de la grille, en chevauche
+ *             un autre ou si les tirs ont commencé
+ */
+int placeShip(match_t *match, int player, int ship, int cell, int vertical) {
+
+	board_t 	*board;
+	bitboard_t 	cells;
+
+	if (player < 0 || player > 1 || ship < 0 || ship >= FLEET_SIZE || match->turn > 0) return -1;
+
+	board 	= &match->boards[player];
+	cells 	= shipCells(ship, cell, vertical);
+
+	if (cells == 0 || board->ships[ship] != 0 || (board->fleet & cells) != 0) return -1;
+
+	board->ships[ship] 	= cells;
+	board->fleet 		|= cells;
+
+	if (match->log != NULL) logPlacement(match->log, player, ship, cell, vertical);
+
+	return 0;
+
+}
+/**
+ * @brief      La flotte d'un joueur est-elle entièrement placée
+ *
+ * @param      match   la partie
+ * @param[in]  player  le joueur
+ *
+ * @return     1 si tous les navires sont placés, 0 sinon
+ */
+int fleetReady(match_t *match, int player) {
+
+	for (int ship = 0; ship < FLEET_SIZE; ship++) {
+		if (match->boards[player].ships[ship] == 0) return 0;
+	}
+
+	return 1;
+
+}
+/**
+ * @brief      Tir d'un joueur sur la grille de l'adversaire
+ *
+ * @param      match   la partie
+ * @param[in]  player  le tireur, qui doit être au trait
+ * @param[in]  cell    la case visée
+ *
+ * @return     le résultat, SHOT_INVALID si ce n'est pas son tour, si la case a déjà
+ *             été visée, si une flotte est incomplète ou si la partie est finie
+ *
+ * @note       les joueurs tirent chacun leur tour ; chaque tir valide est journalisé
+ */
+shotResult_t fireAt(match_t *match, int player, int cell) {
+
+	board_t 		*target;
+	shotResult_t 	result 	= SHOT_MISS;
+
+	if (match->winner != NO_WINNER || player != match->current) return SHOT_INVALID;
+	if (cell < 0 || cell >= BOARD_CELLS) return SHOT_INVALID;
+	if (match->turn == 0 && (!fleetReady(match, 0) || !fleetReady(match, 1))) return SHOT_INVALID;
+
+	target = &match->boards[1 - player];
+
+	if (target->shots & BIT(cell)) return SHOT_INVALID;
+
+	if (target->fleet & BIT(cell)) {
+
+		result = SHOT_HIT;
+
+		for (int ship = 0; ship < FLEET_SIZE; ship++) {
+
+			bitboard_t cells = target->ships[ship];
+
+			// le tir complète les cases touchées du navire
+			if ((cells & BIT(cell)) && ((target->shots | BIT(cell)) & cells) == cells)
+				result = SHOT_SUNK;
+
+		}
+
+		if (((target->shots | BIT(cell)) & target->fleet) == target->fleet) result = SHOT_WON;
+
+	}
+
+	// journalisé avant d'être appliqué : le point de reprise décrit la partie avant le tir
+	if (match->log != NULL) logShot(match->log, match, player, cell, result);
+
+	target->shots 	|= BIT(cell);
+	match->current 	= 1 - player;
+	match->turn++;
+
+	if (result == SHOT_WON) {
+		match->winner = player;
+		if (match->log != NULL) endReplay(match->log, match);
+	}
+
+	return result;
+
+}
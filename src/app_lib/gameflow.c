@@ -0,0 +1,146 @@
+/**
+ *	\file		gameflow.c
+ *	\brief		Fichier implémentation du cycle de vie d'une partie : états, tour et échéances
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <string.h>
+#include "gameflow.h"
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * @brief      état atteint par chaque événement depuis chaque état
+ */
+static const signed char transitions[GAME_STATES][FLOW_EVENTS] = {
+	//					SNAPSHOT 		TURN 			SHOT 			END 			LEAVE 			TIMEOUT
+	[GAME_WAITING] 	= {GAME_PLACING, 	GAME_PLAYING, 	FLOW_REFUSED, 	GAME_FINISHED, 	GAME_ABANDONED, GAME_ABANDONED},
+	[GAME_PLACING] 	= {GAME_PLACING, 	GAME_PLAYING, 	FLOW_REFUSED, 	GAME_FINISHED, 	GAME_ABANDONED, GAME_ABANDONED},
+	[GAME_PLAYING] 	= {GAME_PLAYING, 	GAME_PLAYING, 	GAME_PLAYING, 	GAME_FINISHED, 	GAME_ABANDONED, GAME_ABANDONED},
+	[GAME_FINISHED] = {FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED},
+	[GAME_ABANDONED]= {FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED, 	FLOW_REFUSED},
+};
+/**
+ * @brief      délai accordé dans chaque état (0 : aucun)
+ */
+static const int timeouts[GAME_STATES] = {
+	[GAME_WAITING] 	= FLOW_WAIT_TIMEOUT,
+	[GAME_PLACING] 	= FLOW_PLACE_TIMEOUT,
+	[GAME_PLAYING] 	= FLOW_MOVE_TIMEOUT,
+};
+/**
+ * @brief      noms des états
+ */
+static const char *stateNames[GAME_STATES] = {"attente", "placement", "en jeu", "terminée", "abandonnée"};
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ouvre une partie en attente d'adversaire et arme son échéance
+ *
+ * @param      flow       le cycle de vie
+ * @param      wheel      la roue des échéances
+ * @param[in]  onExpired  action appelée à l'échéance
+ * @param      owner      propriétaire de l'échéance
+ */
+void createFlow(gameFlow_t *flow, timerWheel_t *wheel, void (*onExpired)(wheelTimer_t *timer), void *owner) {
+
+	flow->state 	= GAME_WAITING;
+	flow->owner[0] 	= '\0';
+	flow->moves 	= 0;
+
+	createTimer(&flow->deadline, onExpired, owner);
+	armTimer(wheel, &flow->deadline, timeouts[GAME_WAITING]);
+
+}
+/**
+ * @brief      Reprend le cycle de vie d'une partie d'une autre instance (passation)
+ *
+ * @param      flow    le cycle de vie, ouvert par createFlow
+ * @param      wheel   la roue des échéances
+ * @param[in]  state   l'état de la partie (non terminal)
+ * @param      player  joueur au trait (vide : aucun)
+ * @param[in]  moves   nombre de coups joués
+ *
+ * @note       l'échéance de l'état est réarmée en entier : le délai déjà écoulé dans
+ *             l'autre instance est offert
+ */
+void resumeFlow(gameFlow_t *flow, timerWheel_t *wheel, gameState_t state, char *player, unsigned moves) {
+
+	flow->state = state;
+	flow->moves = moves;
+
+	strncpy(flow->owner, player, PSEUDO_SIZE - 1);
+	flow->owner[PSEUDO_SIZE - 1] = '\0';
+
+	if (flowEnded(state)) 	cancelTimer(wheel, &flow->deadline);
+	else 					armTimer(wheel, &flow->deadline, timeouts[state]);
+
+}
+/**
+ * @brief      Applique un événement au cycle de vie
+ *
+ * @param      flow    le cycle de vie
+ * @param      wheel   la roue des échéances
+ * @param[in]  event   l'événement
+ * @param      player  joueur désormais au trait (FLOW_TURN), NULL sinon
+ *
+ * @return     le nouvel état, FLOW_REFUSED si l'événement n'est pas permis
+ *
+ * @note       l'échéance est réarmée à chaque changement d'état et à chaque coup ;
+ *             un état terminal la désarme
+ */
+int stepFlow(gameFlow_t *flow, timerWheel_t *wheel, flowEvent_t event, char *player) {
+
+	int next;
+
+	if (event < 0 || event >= FLOW_EVENTS) return FLOW_REFUSED;
+
+	next = transitions[flow->state][event];
+	if (next == FLOW_REFUSED) return FLOW_REFUSED;
+
+	if (event == FLOW_TURN && player != NULL) {
+		strncpy(flow->owner, player, PSEUDO_SIZE - 1);
+		flow->owner[PSEUDO_SIZE - 1] = '\0';
+	}
+
+	if (event == FLOW_SHOT) flow->moves++;
+
+	// un instantané ne prolonge pas l'état : seuls les coups et les changements comptent
+	if (flowEnded(next))
+		cancelTimer(wheel, &flow->deadline);
+	else if ((int) flow->state != next || event == FLOW_TURN || event == FLOW_SHOT)
+		armTimer(wheel, &flow->deadline, timeouts[next]);
+
+	flow->state = next;
+
+	return next;
+
+}
+/**
+ * @brief      Un état est-il terminal
+ *
+ * @param[in]  state  l'état
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int flowEnded(gameState_t state) {
+
+	return state == GAME_FINISHED || state == GAME_ABANDONED;
+
+}
+/**
+ * @brief      Nom d'un état
+ *
+ * @param[in]  state  l'état
+ *
+ * @return     le nom
+ */
+const char *flowStateName(gameState_t state) {
+
+	return state >= 0 && state < GAME_STATES ? stateNames[state] : "?";
+
+}
@@ -0,0 +1,648 @@
+/**
+ *	\file		gossip.c
+ *	\brief		Fichier implémentation de la réplication des hôtes entre serveurs
+ *				d'enregistrement
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ *	\note		Chaque instance numérote les changements de son registre avec sa propre
+ *				horloge. Pour chaque instance connue, on retient la version jusqu'à
+ *				laquelle tous les changements sont connus (vecteur de versions) : les
+ *				résumés échangés à chaque tour ne font circuler que les deltas manquants.
+ *				Un delta est découpé en datagrammes couvrant chacun un intervalle de
+ *				versions ]base, atteinte] : un datagramme perdu n'est jamais compté
+ *				comme reçu et sera redemandé au tour suivant.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/random.h>
+#include "gossip.h"
+#include "interface.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief marqueur d'un delta (début de GOSSIP_DELTA)
+ */
+#define GOSSIP_DELTA_TAG 	"GOSSIP!"
+/**
+ * @brief place réservée à l'en-tête d'un datagramme
+ */
+#define GOSSIP_HEADER_ROOM 	40
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      datagrammes à émettre, envoyés par lots
+ */
+typedef struct {
+
+	/** socket d'émission */
+	socket_t 		*sock;
+	/** datagrammes en attente */
+	datagramme_t 	lot[MAX_LOT];
+	/** nombre de datagrammes en attente */
+	int 			nb;
+
+} outbox_t;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S   L O C A L E S
+ */
+/**
+ * @brief      Émet les datagrammes en attente
+ *
+ * @param      out   les datagrammes à émettre
+ */
+static void flushOutbox(outbox_t *out) {
+
+	if (out->nb > 0) envoyerLot(out->sock, out->lot, out->nb);
+	out->nb = 0;
+
+}
+/**
+ * @brief      Réserve un datagramme à émettre
+ *
+ * @param      out      les datagrammes à émettre
+ * @param      addr     destination
+ * @param[in]  addrLen  taille de la destination
+ *
+ * @return     le datagramme, vide
+ */
+static datagramme_t *nextDatagram(outbox_t *out, struct sockaddr_storage *addr, socklen_t addrLen) {
+
+	datagramme_t *dg;
+
+	if (out->nb == MAX_LOT) flushOutbox(out);
+
+	dg 			= &out->lot[out->nb++];
+	dg->addr 	= *addr;
+	dg->addrLen = addrLen;
+	dg->len 	= 0;
+
+	return dg;
+
+}
+/**
+ * @brief      Compare deux hôtes (nom, adresse et port)
+ *
+ * @return     1 s'ils sont identiques, 0 sinon
+ */
+static int sameHost(clientInfo_t *a, clientInfo_t *b) {
+
+	return a->port == b->port
+		&& strcmp(a->name, b->name) == 0
+		&& strcmp(a->address, b->address) == 0;
+
+}
+/**
+ * @brief      Recherche une instance connue
+ *
+ * @param      gossip  l'état de la réplication
+ * @param[in]  origin  identifiant de l'instance
+ * @param[in]  now     date courante (instance créée)
+ *
+ * @return     l'instance (créée au besoin), NULL si la table est pleine
+ */
+static gossipNode_t *findNode(gossip_t *gossip, uint32_t origin, time_t now) {
+
+	gossipNode_t *free = NULL;
+
+	for (int i = 0; i < MAX_NODES; i++) {
+
+		if (gossip->nodes[i].origin == origin) return &gossip->nodes[i];
+		if (gossip->nodes[i].origin == 0 && free == NULL) free = &gossip->nodes[i];
+
+	}
+
+	if (free == NULL) return NULL;
+
+	free->origin 	= origin;
+	free->version 	= 0;
+	free->heartbeat = 0;
+	// pas listée tant qu'aucun battement de cœur récent n'a été vu
+	free->lastSeen 	= now - GOSSIP_TIMEOUT - 1;
+	memset(free->entries, 0, gossip->capacity * sizeof(gossipEntry_t));
+
+	return free;
+
+}
+/**
+ * @brief      Indique si un datagramme vient d'un pair configuré
+ *
+ * @param      gossip  l'état de la réplication
+ * @param      dg      le datagramme reçu
+ *
+ * @return     1 si l'émetteur est un pair, 0 sinon
+ */
+static int fromPeer(gossip_t *gossip, datagramme_t *dg) {
+
+	char 	sender[ADR_SIZE];
+	short 	senderPort;
+
+	// struct2adr rend une adresse IPv4 mappée (écoute double pile) au format IPv4
+	struct2adr(&dg->addr, sender, &senderPort);
+
+	for (int i = 0; i < gossip->peerAmount; i++) {
+
+		char 	peer[ADR_SIZE];
+		short 	peerPort;
+
+		struct2adr(&gossip->peers[i], peer, &peerPort);
+
+		if (peerPort == senderPort && strcmp(peer, sender) == 0) return 1;
+
+	}
+
+	return 0;
+
+}
+/**
+ * @brief      Publie les changements du registre local (nouvelles versions locales)
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       lit le registre local : à appeler depuis le thread qui le modifie
+ */
+static void publishLocal(gossip_t *gossip) {
+
+	gossipNode_t *self = &gossip->nodes[0];
+
+	for (int i = 0; i < gossip->capacity; i++) {
+
+		clientInfo_t 	client 	= gossip->local[i];
+		gossipEntry_t 	*entry 	= &self->entries[i];
+		int 			alive 	= client.role == HOST
+			&& (client.status == CONNECTED || client.status == PENDING);
+
+		if (alive == entry->alive && (!alive || sameHost(&entry->info, &client))) continue;
+
+		client.status 	= CONNECTED;
+		entry->version 	= ++self->version;
+		entry->alive 	= alive;
+		entry->info 	= client;
+
+	}
+
+}
+/**
+ * @brief      Ajoute les datagrammes d'un delta : entrées d'une instance plus récentes
+ *             qu'une version de base, par ordre de version croissante
+ *
+ * @param      out      les datagrammes à émettre
+ * @param      gossip   l'état de la réplication
+ * @param      node     l'instance décrite
+ * @param[in]  base     version déjà connue du destinataire
+ * @param      addr     destination
+ * @param[in]  addrLen  taille de la destination
+ */
+static void appendDelta(outbox_t *out, gossip_t *gossip, gossipNode_t *node, uint32_t base
+	, struct sockaddr_storage *addr, socklen_t addrLen) {
+
+	int 	order[gossip->capacity];
+	int 	amount = 0;
+	int 	k = 0;
+
+	for (int i = 0; i < gossip->capacity; i++) {
+
+		uint32_t 	version = node->entries[i].version;
+		int 		j 		= amount;
+
+		if (version <= base) continue;
+
+		// tri par insertion : quelques dizaines d'entrées au plus
+		while (j > 0 && node->entries[order[j - 1]].version > version) {
+			order[j] = order[j - 1];
+			j--;
+		}
+
+		order[j] = i;
+		amount++;
+
+	}
+
+	do {
+
+		datagramme_t 	*dg 		= nextDatagram(out, addr, addrLen);
+		char 			lines[MAX_BUFFER];
+		int 			used 		= 0;
+		uint32_t 		chunkBase 	= base;
+
+		while (k < amount) {
+
+			gossipEntry_t 	*entry = &node->entries[order[k]];
+			char 			line[MAX_BUFFER];
+			int 			len;
+
+			len = sprintf(line, GOSSIP_DELTA_OUT, order[k], entry->version, entry->alive);
+			clientInfo2str(&entry->info, line + len);
+			len += strlen(line + len);
+			line[len++] = '\n';
+
+			if (used + len > MAX_BUFFER - GOSSIP_HEADER_ROOM) break;
+
+			memcpy(lines + used, line, len);
+			used 	+= len;
+			base 	= entry->version;
+			k++;
+
+		}
+
+		// le dernier morceau amène le destinataire à la version complète de l'instance
+		dg->len = sprintf(dg->buff, GOSSIP_DELTA "\n", node->origin, chunkBase
+			, k == amount ? node->version : base);
+		memcpy(dg->buff + dg->len, lines, used);
+		dg->len += used;
+		dg->buff[dg->len++] = '\0';
+
+	} while (k < amount);
+
+}
+/**
+ * @brief      Ajoute un résumé : version complète et battement de cœur de chaque instance
+ *
+ * @param      out      les datagrammes à émettre
+ * @param      gossip   l'état de la réplication
+ * @param      addr     destination
+ * @param[in]  addrLen  taille de la destination
+ */
+static void appendDigest(outbox_t *out, gossip_t *gossip, struct sockaddr_storage *addr, socklen_t addrLen) {
+
+	datagramme_t *dg = nextDatagram(out, addr, addrLen);
+
+	dg->len = sprintf(dg->buff, GOSSIP_DIGEST "\n");
+
+	for (int i = 0; i < MAX_NODES && dg->len < MAX_BUFFER - GOSSIP_HEADER_ROOM; i++) {
+
+		gossipNode_t *node = &gossip->nodes[i];
+
+		if (node->origin == 0) continue;
+
+		dg->len += sprintf(dg->buff + dg->len, GOSSIP_DIGEST_LINE "\n"
+			, node->origin, node->version, node->heartbeat);
+
+	}
+
+	dg->buff[dg->len++] = '\0';
+
+}
+/**
+ * @brief      Traite un résumé reçu : répond par les deltas qui manquent à l'émetteur
+ *
+ * @param      gossip   l'état de la réplication
+ * @param      dg       le résumé reçu
+ * @param      out      les datagrammes à émettre
+ * @param[in]  now      date courante
+ */
+static void onDigest(gossip_t *gossip, datagramme_t *dg, outbox_t *out, time_t now) {
+
+	uint32_t 	theirs[MAX_NODES] = {0};
+	char 		*save;
+	char 		*line = strtok_r(dg->buff, "\n", &save);
+
+	while ((line = strtok_r(NULL, "\n", &save)) != NULL) {
+
+		unsigned int 	origin, version, heartbeat;
+		gossipNode_t 	*node;
+
+		if (sscanf(line, GOSSIP_DIGEST_LINE, &origin, &version, &heartbeat) != 3 || origin == 0)
+			continue;
+
+		if ((node = findNode(gossip, origin, now)) == NULL) continue;
+
+		theirs[node - gossip->nodes] = version;
+
+		// un battement de cœur plus récent prouve que l'instance est vivante
+		if (node != &gossip->nodes[0] && heartbeat > node->heartbeat) {
+			node->heartbeat = heartbeat;
+			node->lastSeen 	= now;
+		}
+
+	}
+
+	for (int i = 0; i < MAX_NODES; i++) {
+
+		gossipNode_t *node = &gossip->nodes[i];
+
+		if (node->origin != 0 && node->version > theirs[i])
+			appendDelta(out, gossip, node, theirs[i], &dg->addr, dg->addrLen);
+
+	}
+
+}
+/**
+ * @brief      Traite un delta reçu
+ *
+ * @param      gossip   l'état de la réplication
+ * @param      dg       le delta reçu
+ * @param[in]  now      date courante
+ */
+static void onDelta(gossip_t *gossip, datagramme_t *dg, time_t now) {
+
+	unsigned int 	origin, base, high;
+	gossipNode_t 	*node;
+	char 			*save;
+	char 			*line = strtok_r(dg->buff, "\n", &save);
+
+	if (line == NULL || sscanf(line, GOSSIP_DELTA, &origin, &base, &high) != 3 || origin == 0) return;
+
+	node = findNode(gossip, origin, now);
+
+	// nos propres changements nous reviennent : déjà connus
+	if (node == NULL || node == &gossip->nodes[0]) return;
+
+	while ((line = strtok_r(NULL, "\n", &save)) != NULL) {
+
+		int 			slot, alive, len = 0;
+		unsigned int 	version;
+		gossipEntry_t 	*entry;
+		clientInfo_t 	info = {0};
+
+		if (sscanf(line, GOSSIP_DELTA_IN, &slot, &version, &alive, &len) != 3
+			|| len == 0 || slot < 0 || slot >= gossip->capacity
+			|| !str2clientInfo(line + len, &info)) continue;
+
+		entry = &node->entries[slot];
+		if (version <= entry->version) continue;
+
+		entry->version 	= version;
+		entry->alive 	= alive;
+		entry->info 	= info;
+		entry->info.status = CONNECTED;
+
+	}
+
+	// morceau contigu à ce qui est déjà connu : le vecteur de versions avance
+	if (node->version >= base && high > node->version) node->version = high;
+
+}
+/**
+ * @brief      Tour de bavardage : battement de cœur, oubli des instances disparues,
+ *             résumé à chaque pair et poussée des changements locaux
+ *
+ * @param      gossip  l'état de la réplication
+ * @param      out     les datagrammes à émettre
+ * @param[in]  now     date courante
+ */
+static void gossipRound(gossip_t *gossip, outbox_t *out, time_t now) {
+
+	gossipNode_t 	*self = &gossip->nodes[0];
+
+	self->heartbeat++;
+	self->lastSeen = now;
+
+	for (int i = 1; i < MAX_NODES; i++) {
+
+		if (gossip->nodes[i].origin != 0 && now - gossip->nodes[i].lastSeen > GOSSIP_FORGET)
+			gossip->nodes[i].origin = 0;
+
+	}
+
+	for (int i = 0; i < gossip->peerAmount; i++) {
+
+		appendDigest(out, gossip, &gossip->peers[i], gossip->peerLens[i]);
+
+		if (self->version > gossip->pushed)
+			appendDelta(out, gossip, self, gossip->pushed, &gossip->peers[i], gossip->peerLens[i]);
+
+	}
+
+	gossip->pushed = self->version;
+
+}
+/**
+ * @brief      Date monotone en millisecondes
+ */
+static long long monotonicMs() {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+
+}
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Prépare la réplication du registre local
+ *
+ * @param      gossip    l'état à initialiser
+ * @param[in]  sock      socket DGRAM de bavardage (liée au port d'écoute des pairs)
+ * @param      peers     adresses des pairs, séparées par des virgules (ip:port ou [ipv6]:port)
+ * @param      local     registre local
+ * @param[in]  capacity  taille du registre (identique sur toutes les instances)
+ *
+ * @return     le nombre de pairs reconnus
+ */
+int createGossip(gossip_t *gossip, socket_t sock, char *peers, clientInfo_t *local, int capacity) {
+
+	char 		list[strlen(peers) + 1];
+	char 		*save;
+	char 		*peer;
+	uint32_t 	origin = 0;
+
+	gossip->sock 		= sock;
+	gossip->peerAmount 	= 0;
+	gossip->capacity 	= capacity;
+	gossip->pushed 		= 0;
+	gossip->local 		= local;
+	gossip->stopped 	= 0;
+	pthread_mutex_init(&gossip->lock, NULL);
+
+	for (int i = 0; i < MAX_NODES; i++) {
+		gossip->nodes[i].origin 	= 0;
+		gossip->nodes[i].entries 	= calloc(capacity, sizeof(gossipEntry_t));
+	}
+
+	// nouvelle identité à chaque lancement : les versions repartent de zéro
+	while (origin == 0) {
+		if (getrandom(&origin, sizeof(origin), 0) != sizeof(origin))
+			origin = getpid() ^ (uint32_t) monotonicMs();
+	}
+
+	findNode(gossip, origin, time(NULL));
+
+	strcpy(list, peers);
+
+	for (peer = strtok_r(list, ",", &save); peer != NULL && gossip->peerAmount < MAX_PEERS
+		; peer = strtok_r(NULL, ",", &save)) {
+
+		char 	adrIP[ADR_SIZE];
+		short 	port;
+
+		if (sscanf(peer, ADDR6_INPUT_FMT, adrIP, &port) != 2
+			&& sscanf(peer, ADDR_INPUT_FMT, adrIP, &port) != 2) {
+			fprintf(stderr, "Pair ignoré : %s\n", peer);
+			continue;
+		}
+
+		gossip->peerLens[gossip->peerAmount] = adr2struct(&gossip->peers[gossip->peerAmount], adrIP, port);
+
+		if (gossip->peerLens[gossip->peerAmount] == 0) {
+			fprintf(stderr, "Pair ignoré : %s\n", peer);
+			continue;
+		}
+
+		gossip->peerAmount++;
+
+	}
+
+	return gossip->peerAmount;
+
+}
+/**
+ * @brief      Boucle de bavardage : échange résumés et deltas avec les pairs. Ne se
+ *             termine qu'après stopGossip, à lancer dans un thread.
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       les datagrammes qui ne viennent pas d'un pair configuré sont ignorés
+ */
+void serveGossip(gossip_t *gossip) {
+
+	static datagramme_t 	received[MAX_LOT];
+	static outbox_t 		out;
+	struct pollfd 			pfd 		= {gossip->sock.fd, POLLIN, 0};
+	long long 				nextRound 	= 0;
+
+	out.sock = &gossip->sock;
+
+	while (1) {
+
+		long long 	now = monotonicMs();
+		int 		amount;
+		int 		stopped;
+
+		if (now >= nextRound) {
+
+			pthread_mutex_lock(&gossip->lock);
+			stopped = gossip->stopped;
+			if (!stopped) gossipRound(gossip, &out, time(NULL));
+			pthread_mutex_unlock(&gossip->lock);
+
+			if (stopped) return;
+
+			flushOutbox(&out);
+			nextRound = now + GOSSIP_PERIOD;
+
+		}
+
+		if (poll(&pfd, 1, nextRound - now) <= 0) continue;
+		if ((amount = recevoirLot(&gossip->sock, received, MAX_LOT)) <= 0) continue;
+
+		pthread_mutex_lock(&gossip->lock);
+
+		// la socket appartient déjà à une autre instance : ce lot lui revenait
+		if (gossip->stopped) {
+			pthread_mutex_unlock(&gossip->lock);
+			return;
+		}
+
+		for (int i = 0; i < amount; i++) {
+
+			// seuls les pairs configurés sont écoutés : ni injection d'hôtes, ni
+			// deltas renvoyés à une adresse usurpée
+			if (!fromPeer(gossip, &received[i])) continue;
+
+			if (strncmp(received[i].buff, GOSSIP_DIGEST, sizeof(GOSSIP_DIGEST) - 1) == 0)
+				onDigest(gossip, &received[i], &out, time(NULL));
+			else if (strncmp(received[i].buff, GOSSIP_DELTA_TAG, sizeof(GOSSIP_DELTA_TAG) - 1) == 0)
+				onDelta(gossip, &received[i], time(NULL));
+
+		}
+
+		pthread_mutex_unlock(&gossip->lock);
+
+		flushOutbox(&out);
+
+	}
+
+}
+/**
+ * @brief      Publie les changements du registre local
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       à appeler depuis le thread qui modifie le registre local
+ */
+void publishGossip(gossip_t *gossip) {
+
+	pthread_mutex_lock(&gossip->lock);
+	publishLocal(gossip);
+	pthread_mutex_unlock(&gossip->lock);
+
+}
+/**
+ * @brief      Arrête la boucle de bavardage (socket transmise à une autre instance)
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       la boucle se termine au plus tard GOSSIP_PERIOD ms après
+ */
+void stopGossip(gossip_t *gossip) {
+
+	pthread_mutex_lock(&gossip->lock);
+	gossip->stopped = 1;
+	pthread_mutex_unlock(&gossip->lock);
+
+}
+/**
+ * @brief      Liste les hôtes enregistrés sur les autres instances joignables
+ *
+ * @param      gossip  l'état de la réplication
+ * @param      hosts   tableau à remplir
+ * @param[in]  max     taille du tableau
+ * @param      filter  filtre des hôtes (NULL : tous), filter->skip hôtes sont sautés
+ *
+ * @return     le nombre d'hôtes (sans ceux déjà présents dans le registre local)
+ */
+int listGossipHosts(gossip_t *gossip, clientInfo_t *hosts, int max, hostFilter_t *filter) {
+
+	time_t 	now 	= time(NULL);
+	int 	amount 	= 0;
+
+	pthread_mutex_lock(&gossip->lock);
+
+	for (int i = 1; i < MAX_NODES && amount < max; i++) {
+
+		gossipNode_t *node = &gossip->nodes[i];
+
+		// instance muette depuis trop longtemps : ses hôtes sont sans doute perdus
+		if (node->origin == 0 || now - node->lastSeen > GOSSIP_TIMEOUT) continue;
+
+		for (int j = 0; j < gossip->capacity && amount < max; j++) {
+
+			clientInfo_t *info = &node->entries[j].info;
+
+			if (!node->entries[j].alive) continue;
+			if (filter != NULL && !matchesFilter(info, filter)) continue;
+
+			// un hôte repris par une autre instance peut être vu deux fois un moment
+			if (findClient(gossip->local, gossip->capacity, info, CONNECTED) >= 0
+				|| findClient(gossip->local, gossip->capacity, info, PENDING) >= 0
+				|| findClient(hosts, amount, info, CONNECTED) >= 0) continue;
+
+			if (filter != NULL && filter->skip > 0) {
+				filter->skip--;
+				continue;
+			}
+
+			hosts[amount++] = *info;
+
+		}
+
+	}
+
+	pthread_mutex_unlock(&gossip->lock);
+
+	return amount;
+
+}
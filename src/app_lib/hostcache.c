@@ -0,0 +1,259 @@
+/**
+ *	\file		hostcache.c
+ *	\brief		Fichier implémentation du cache paginé de la liste des hôtes du client
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "hostcache.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Emplacement d'une page, NO_PAGE si absente (verrou tenu)
+ */
+static int findPageSlot(hostCache_t *cache, int page) {
+
+	for (int i = 0; i < HOST_CACHE_PAGES; i++) {
+		if (cache->numbers[i] == page) return i;
+	}
+
+	return NO_PAGE;
+
+}
+/**
+ * @brief      Crée un cache vide
+ *
+ * @param      cache  le cache à initialiser
+ */
+void createHostCache(hostCache_t *cache) {
+
+	pthread_mutex_init(&cache->lock, NULL);
+	cache->generation = 0;
+	clearHostCache(cache);
+
+}
+/**
+ * @brief      Vide le cache, quand la liste demandée change (filtre, retour au menu)
+ *
+ * @param      cache  le cache
+ */
+void clearHostCache(hostCache_t *cache) {
+
+	pthread_mutex_lock(&cache->lock);
+
+	for (int i = 0; i < HOST_CACHE_PAGES; i++) {
+		cache->numbers[i] = NO_PAGE;
+		cache->amounts[i] = 0;
+	}
+
+	cache->lastPage 	= NO_PAGE;
+	cache->wanted 		= 0;
+	cache->prefetch 	= NO_PAGE;
+	cache->generation++;
+
+	pthread_mutex_unlock(&cache->lock);
+
+}
+/**
+ * @brief      Génération courante du cache, à relever avant de charger une page
+ *
+ * @param      cache  le cache
+ *
+ * @return     la génération
+ */
+unsigned getHostCacheGeneration(hostCache_t *cache) {
+
+	unsigned generation;
+
+	pthread_mutex_lock(&cache->lock);
+	generation = cache->generation;
+	pthread_mutex_unlock(&cache->lock);
+
+	return generation;
+
+}
+/**
+ * @brief      Note la page attendue par l'interface, à charger par le dialogue
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ */
+void setWantedHostPage(hostCache_t *cache, int page) {
+
+	pthread_mutex_lock(&cache->lock);
+	cache->wanted = page;
+	pthread_mutex_unlock(&cache->lock);
+
+}
+/**
+ * @brief      Page attendue par l'interface
+ *
+ * @param      cache  le cache
+ *
+ * @return     le numéro de la page
+ */
+int getWantedHostPage(hostCache_t *cache) {
+
+	int page;
+
+	pthread_mutex_lock(&cache->lock);
+	page = cache->wanted;
+	pthread_mutex_unlock(&cache->lock);
+
+	return page;
+
+}
+/**
+ * @brief      Note la page à précharger par le dialogue
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page, NO_PAGE si aucune
+ */
+void setPrefetchHostPage(hostCache_t *cache, int page) {
+
+	pthread_mutex_lock(&cache->lock);
+	cache->prefetch = page;
+	pthread_mutex_unlock(&cache->lock);
+
+}
+/**
+ * @brief      Page à précharger
+ *
+ * @param      cache  le cache
+ *
+ * @return     le numéro de la page, NO_PAGE si aucune
+ */
+int getPrefetchHostPage(hostCache_t *cache) {
+
+	int page;
+
+	pthread_mutex_lock(&cache->lock);
+	page = cache->prefetch;
+	pthread_mutex_unlock(&cache->lock);
+
+	return page;
+
+}
+/**
+ * @brief      Recopie une page du cache
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ * @param      hosts  HOST_PAGE_SIZE hôtes, la fin est vidée
+ *
+ * @return     le nombre d'hôtes de la page, NO_PAGE si elle n'est pas en cache
+ */
+int getHostPage(hostCache_t *cache, int page, clientInfo_t *hosts) {
+
+	int slot;
+	int amount = NO_PAGE;
+
+	pthread_mutex_lock(&cache->lock);
+
+	slot = findPageSlot(cache, page);
+
+	if (slot != NO_PAGE) {
+
+		amount = cache->amounts[slot];
+		memcpy(hosts, cache->pages[slot], amount * sizeof(clientInfo_t));
+		memset(&hosts[amount], 0, (HOST_PAGE_SIZE - amount) * sizeof(clientInfo_t));
+
+	}
+
+	pthread_mutex_unlock(&cache->lock);
+
+	return amount;
+
+}
+/**
+ * @brief      Une page est-elle en cache
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int hasHostPage(hostCache_t *cache, int page) {
+
+	int cached;
+
+	pthread_mutex_lock(&cache->lock);
+	cached = findPageSlot(cache, page) != NO_PAGE;
+	pthread_mutex_unlock(&cache->lock);
+
+	return cached;
+
+}
+/**
+ * @brief      Range une page chargée, à la place de la plus éloignée de la page attendue
+ *
+ * @param      cache       le cache
+ * @param[in]  generation  génération relevée avant le chargement
+ * @param[in]  page        numéro de la page
+ * @param      hosts       les hôtes de la page
+ * @param[in]  amount      nombre d'hôtes (moins de HOST_PAGE_SIZE : dernière page)
+ */
+void storeHostPage(hostCache_t *cache, unsigned generation, int page, clientInfo_t *hosts, int amount) {
+
+	int slot;
+
+	pthread_mutex_lock(&cache->lock);
+
+	// chargée pour une liste remplacée depuis
+	if (generation != cache->generation) {
+		pthread_mutex_unlock(&cache->lock);
+		return;
+	}
+
+	slot = findPageSlot(cache, page);
+
+	// emplacement libre, sinon la page la plus loin de celle attendue
+	for (int i = 0; slot == NO_PAGE && i < HOST_CACHE_PAGES; i++) {
+		if (cache->numbers[i] == NO_PAGE) slot = i;
+	}
+
+	if (slot == NO_PAGE) {
+
+		slot = 0;
+
+		for (int i = 1; i < HOST_CACHE_PAGES; i++) {
+			if (abs(cache->numbers[i] - cache->wanted) > abs(cache->numbers[slot] - cache->wanted)) slot = i;
+		}
+
+	}
+
+	if (amount > HOST_PAGE_SIZE) amount = HOST_PAGE_SIZE;
+
+	memcpy(cache->pages[slot], hosts, amount * sizeof(clientInfo_t));
+	cache->numbers[slot] = page;
+	cache->amounts[slot] = amount;
+
+	if (amount < HOST_PAGE_SIZE && (cache->lastPage == NO_PAGE || page < cache->lastPage))
+		cache->lastPage = page;
+
+	pthread_mutex_unlock(&cache->lock);
+
+}
+/**
+ * @brief      La liste peut-elle avoir une page après celle-ci
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ *
+ * @return     1 si oui, 0 si page est la dernière
+ */
+int hasNextHostPage(hostCache_t *cache, int page) {
+
+	int next;
+
+	pthread_mutex_lock(&cache->lock);
+	next = cache->lastPage == NO_PAGE || page < cache->lastPage;
+	pthread_mutex_unlock(&cache->lock);
+
+	return next;
+
+}
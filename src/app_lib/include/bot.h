@@ -0,0 +1,90 @@
+/**
+ *	\file		bot.h
+ *	\brief		Fichier en-tête des joueurs automatiques (choix des tirs)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef BOT_H
+#define BOT_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include "game.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      poids d'un placement passant par un touché (stratégie BOT_DENSITY)
+ */
+#define DENSITY_HIT_WEIGHT 	16
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      stratégies de tir : au hasard, chasse en damier puis poursuite autour
+ *             des touchés, ou case couverte par le plus de placements encore possibles
+ */
+typedef enum {BOT_RANDOM, BOT_HUNT, BOT_DENSITY, BOT_STRATEGIES} botStrategy_t;
+/**
+ * @brief      joueur automatique : ne connaît que les résultats de ses propres tirs
+ */
+typedef struct {
+
+	/** stratégie de tir */
+	botStrategy_t 	strategy;
+	/** cases déjà visées */
+	bitboard_t 		shots;
+	/** cases touchées de navires pas encore coulés */
+	bitboard_t 		open;
+	/** cases touchées de navires coulés (au mieux de ce que le bot en sait) */
+	bitboard_t 		dead;
+	/** état du générateur (xorshift64*) */
+	uint64_t 		seed;
+
+} bot_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Prépare un bot pour une nouvelle partie
+ *
+ * @param      bot       le bot
+ * @param[in]  strategy  sa stratégie
+ * @param[in]  seed      graine de ses tirages (0 : remplacée par une graine fixe)
+ */
+void createBot(bot_t *bot, botStrategy_t strategy, uint64_t seed);
+/**
+ * @brief      Choisit la prochaine case visée
+ *
+ * @param      bot   le bot
+ *
+ * @return     une case jamais visée, -1 si toutes l'ont été
+ */
+int botShot(bot_t *bot);
+/**
+ * @brief      Prend en compte le résultat d'un tir du bot
+ *
+ * @param      bot     le bot
+ * @param[in]  cell    la case visée
+ * @param[in]  result  le résultat
+ *
+ * @note       un navire coulé referme la poursuite : les touchés restants d'un
+ *             navire voisin sont comptés avec lui
+ */
+void botRecord(bot_t *bot, int cell, shotResult_t result);
+/**
+ * @brief      Nom d'une stratégie
+ *
+ * @param[in]  strategy  la stratégie
+ *
+ * @return     le nom, NULL si la stratégie n'existe pas
+ */
+const char *botStrategyName(botStrategy_t strategy);
+
+#endif /* BOT_H */
@@ -9,6 +9,11 @@
 #ifndef DATASTRUCTS_H
 #define DATASTRUCTS_H
 /*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <session.h>
+/*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
  */
@@ -17,14 +22,15 @@
  */
 #define CLIENT_INFO_OUT "%s,%d,%s,%d"
 /**
- * @brief format de désérialisation des infos clients
+ * @brief format de désérialisation des infos clients (largeurs : PSEUDO_SIZE et
+ *        ADDR_SIZE, \0 non compris)
  */
-#define CLIENT_INFO_IN "%[^,],%d,%[^,],%d"
+#define CLIENT_INFO_IN "%10[^,],%d,%45[^,],%hd"
 
 /**
- * @brief taille d'une adresse IPv4 en termes de string
+ * @brief taille d'une adresse IPv4 ou IPv6 en termes de string (\0 compris)
  */
-#define ADDR_SIZE 15
+#define ADDR_SIZE ADR_SIZE
 /**
  * @brief taille maximum du pseudo en termes de string
  */
@@ -35,8 +41,10 @@
  */
 /**
  * @brief enum donnant les états de connexion des clients
+ * 
+ * @note  PENDING : entrée restaurée d'un instantané, en attente de reconnexion
  */
-typedef enum {DISCONNECTED, CONNECTING, CONNECTED} userStatus_t;
+typedef enum {DISCONNECTED, CONNECTING, CONNECTED, PENDING} userStatus_t;
 /**
  * @brief enum donnant les rôles possibles des clients
  */
@@ -52,10 +60,12 @@ typedef struct {
 	userStatus_t status;
 	/// role du client
 	userRole_t role;
-	/// adresse LAN du client
+	/// adresse LAN du client (IPv4 pointée ou IPv6)
 	char address[ADDR_SIZE];
 	/// port du client (s'il est hôte)
 	short port;
+	/// adresse d'où le client s'est enregistré, vue par le serveur (non sérialisée)
+	char peer[ADDR_SIZE];
 
 } clientInfo_t;
 /*
@@ -72,6 +82,15 @@ typedef struct {
  * @param[in]  port     Le port du client
  */
 void createClientInfo(clientInfo_t *infos, char *name, userRole_t role, char *address, short port);
+/**
+ * @brief      Convertis l'adresse applicative d'un client en structure SocketBSD
+ *
+ * @param      infos  les infos du client
+ * @param      addr   la structure d'adressage à remplir (IPv4 ou IPv6)
+ *
+ * @return     la taille utile de l'adresse, 0 si elle est invalide
+ */
+socklen_t clientInfo2struct(clientInfo_t *infos, struct sockaddr_storage *addr);
 /**
  * @brief      fonction de sérialisation des infos clients
  *
@@ -84,8 +103,10 @@ void clientInfo2str(clientInfo_t *infos, char *str);
  *
  * @param      str    le buffer sérialisé
  * @param      infos  les infos désérialisées
+ *
+ * @return     1 si les quatre champs ont été lus, 0 si le buffer est malformé
  */
-void str2clientInfo(char *str, clientInfo_t *infos);
+int str2clientInfo(char *str, clientInfo_t *infos);
 /**
  * @brief      Récupère dans une list d'infos clients le nombre d'hôtes
  *
@@ -95,6 +116,17 @@ void str2clientInfo(char *str, clientInfo_t *infos);
  * @return     le nombre d'hôtes parmis les clients
  */
 int getHostsAmount(clientInfo_t *clients, int size);
+/**
+ * @brief      Recherche un client dans une liste d'infos clients
+ *
+ * @param      clients  les clients
+ * @param[in]  size     la taille du tableau
+ * @param      infos    le client recherché (nom, rôle, adresse et port)
+ * @param[in]  status   l'état de connexion recherché
+ *
+ * @return     l'indice du client, -1 s'il est absent
+ */
+int findClient(clientInfo_t *clients, int size, clientInfo_t *infos, userStatus_t status);
 
 
 #endif /* DATASTRUCTS_H */
\ No newline at end of file
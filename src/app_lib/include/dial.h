@@ -15,15 +15,34 @@
 #include <signal.h>
 #include "data.h"
 #include "repReq.h"
+#include "protocol.h"
 #include "datastructs.h"
+#include "matchmaking.h"
+#include "spectate.h"
+#include "nameindex.h"
+#include "hostcache.h"
 /*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
  */
 /**
- * @brief      maximum d'hôtes récupérables dans une commande CONNECT GET 
+ * @brief      maximum d'hôtes récupérables dans une commande CONNECT GET (une page)
  */
-#define MAX_HOSTS_GET 10
+#define MAX_HOSTS_GET HOST_PAGE_SIZE
+/**
+ * @brief      octets au plus empilés en réponse à une requête : une page d'hôtes et
+ *             sa fin de liste (statut et au plus DATA_LENGTH octets de données chacune)
+ */
+#define MAX_REPLY_BYTES ((MAX_HOSTS_GET + 1) * (DATA_LENGTH + 8))
+/**
+ * @brief      capacités du serveur d'enregistrement (pipeline des requêtes, réponses
+ *             poussées par la mise en relation et les spectateurs)
+ */
+#define SRVE_CAPS 		(CAP_PIPELINE | CAP_PUSH)
+/**
+ * @brief      capacités du client
+ */
+#define CLT_CAPS 		(CAP_PUSH)
 /*
 *****************************************************************************************
  *	\noop		S T R C T U R E S   DE   D O N N E E S
@@ -31,10 +50,11 @@
 /**
  * @brief     	structure contenant les paramètres requis au dialogue du serveur 
  * 				d'enregistrement vers un client.
+ * @note 		sert aussi de contexte de connexion au moteur d'E/S du serveur
  */
-typedef struct {
+typedef struct eServThreadParams {
 
-	/** id du thread, permet de stocker les infos client au bon endroit */
+	/** id du client, permet de stocker les infos client au bon endroit (-1 : aucun) */
 	int 			id; 			
 	/** pointeur vers une structure socket_t pour le dialogue */
 	socket_t 		*sockDial;
@@ -46,8 +66,49 @@ typedef struct {
 	void 			(*terminationCallback)(int);
 	/** fonction pour vérifier si le thread peut accepter l'utilisateur */
 	int 			(*canAccept)();
+	/** le dialogue se termine dès que les réponses en cours sont émises */
+	int 			closing;
+	/** fonction listant les hôtes filtrés enregistrés sur d'autres serveurs (NULL : aucun) */
+	int 			(*listRemoteHosts)(clientInfo_t *, int, hostFilter_t *);
+	/** file de mise en relation des joueurs et des hôtes (NULL : indisponible) */
+	matchmaker_t 	*matchmaker;
+	/** ticket du client dans la file de mise en relation (-1 : aucun) */
+	int 			matchTicket;
+	/** émet les réponses empilées sur une autre connexion, sans émission en cours */
+	void 			(*wakeCallback)(struct eServThreadParams *);
+	/** relais des parties en cours vers leurs spectateurs (NULL : indisponible) */
+	spectateRelay_t *relay;
+	/** abonnement du client à une partie (NULL : aucun) */
+	spectateSub_t 	*spectator;
+	/** protocole convenu avec le client (version 1 sans négociation) */
+	hello_t 		hello;
+	/** index du registre par nom (NULL : aucun, listes par parcours du registre) */
+	nameIndex_t 	*names;
 
 } eServThreadParams_t;
+/**
+ * @brief      traitement d'une requête par le serveur d'enregistrement
+ *
+ * @return     1 si le dialogue continue, 0 s'il doit se terminer
+ */
+typedef int (*srvEHandler_t)(eServThreadParams_t *params, req_t *request);
+/**
+ * @brief      contexte complet d'une connexion au serveur d'enregistrement, emprunté
+ * 			   d'un seul bloc à une réserve (pool.h) : socket et ses tampons, paramètres
+ * 			   de dialogue et entrée du registre (params.id).
+ */
+typedef struct eServConnection {
+
+	/** socket de dialogue (tampons d'entrée/sortie compris) */
+	socket_t 				sockDial;
+	/** paramètres du dialogue, params.sockDial pointe vers sockDial */
+	eServThreadParams_t 	params;
+	/** connexions actives du serveur (chaînage double) */
+	struct eServConnection 	*prev, *next;
+	/** numéro de la connexion dans la capture du trafic (trace.h) */
+	uint32_t 				traceId;
+
+} eServConnection_t;
 /**
  * @brief      structure de paramètres de dialogue client vers serveur enregistrement.
  */
@@ -57,12 +118,23 @@ typedef struct {
 	socket_t 		*sockAppel;
 	/** pointeur vers les infos du client */
 	clientInfo_t	*infos;
-	/** tableau d'hôtes joignables du client */
-	clientInfo_t	*hostBuffer;
+	/** pages d'hôtes joignables du client */
+	hostCache_t 	*hostCache;
+	/** adversaire trouvé par la mise en relation (status CONNECTED si trouvé) */
+	clientInfo_t 	*opponent;
+	/** classement envoyé à la mise en relation (MATCH_ANY : indifférent) */
+	int 			*rating;
+	/** nom de l'hôte de la partie à regarder */
+	char 			*spectated;
+	/** filtre de la liste des hôtes (préfixe vide : aucun) */
+	hostFilter_t 	*hostFilter;
+	/** événement pour l'interface : fin d'une requête (ACK/ERR CONNECT avec le numéro
+	 *  de page, MATCH, ERR SPECTATE) ou événement de la partie regardée */
+	void 			(*onEvent)(short status, char *data);
+	/** protocole convenu avec le serveur (version 1 : serveur sans négociation) */
+	hello_t 		*hello;
 	/** sémaphore permettant d'autoriser le client à se terminer */
 	sem_t 			*semCanClose;
-	/** sémaphore signalant la fin d'une requête */
-	sem_t 			*semRequestFin;
 
 } eCltThreadParams_t;
 /**
@@ -73,6 +145,18 @@ extern volatile sig_atomic_t mustDisconnect;
  * @brief 	flag de récupération des hôtes. {CONNECT GET}
  */
 extern int requestHosts;
+/**
+ * @brief 	flag de préchargement d'une page d'hôtes, sans attente. {CONNECT GET}
+ */
+extern int requestPrefetch;
+/**
+ * @brief 	flag de recherche d'un adversaire. {MATCH POST}
+ */
+extern int requestOpponent;
+/**
+ * @brief 	flag de suivi d'une partie en spectateur. {SPECTATE GET}
+ */
+extern int requestSpectate;
 /*
 *****************************************************************************************
  *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
@@ -81,7 +165,8 @@ extern int requestHosts;
  * \brief       fonction s'occupant du dialogue entre le client et le serveur d'enregistrement
  * 
  * \param		params   		eCltThreadParams_t contenant les paramètres pour
- * 								le dialogue. Doit être alloué avec `malloc()`
+ * 								le dialogue. Recopiés au démarrage, ils peuvent être
+ * 								réutilisés par l'appelant une fois le dialogue lancé
  * 
  * \note 		s'occupe donc de l'envoi de requêtes et réception de réponses
  */
@@ -90,19 +175,125 @@ void dialClt2SrvE(eCltThreadParams_t *params);
  * \brief       fonction s'occupant du dialogue entre le serveur d'enregistrement et le client
  * 
  * \param		*params		structure eServThreadParams contenant les paramètres
- * 								pour le dialogue. Doit être alloué avec `malloc()`
+ * 								pour le dialogue. Ferme la socket de dialogue en fin de
+ * 								dialogue, la mémoire reste à la charge de l'appelant
  * 
  * \note		s'occupe donc de l'envoi de réponses et réception de réponses
  */
 void dialSrvE2Clt(eServThreadParams_t *params);
+/**
+ * \brief       Traite une requête reçue par le serveur d'enregistrement
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 si le dialogue continue, 0 s'il doit se terminer
+ *
+ * \note		une seule lecture de la table des traitements (setupSrvEHandlers) ;
+ * 				une requête sans traitement reçoit une erreur de son action
+ *
+ * \note		les réponses sont seulement empilées sur params->sockDial :
+ * 				c'est à l'appelant de les émettre (flushResponses ou moteur d'E/S)
+ */
+int processSrvERequest(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Enregistre le traitement d'une action et d'un verbe du protocole
+ *
+ * \param		action   	l'action des requêtes traitées
+ * \param		verb     	leur verbe
+ * \param		handler  	le traitement (NULL : requête refusée)
+ */
+void registerSrvEHandler(action_t action, verb_t verb, srvEHandler_t handler);
+/**
+ * \brief       Enregistre les traitements du serveur d'enregistrement
+ *
+ * \note		à appeler une fois au démarrage, avant le premier processSrvERequest
+ */
+void setupSrvEHandlers();
+/**
+ * \brief       Enregistre un client (CONNECT POST)
+ */
+int processSrvEConnect(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Désenregistre un client et termine le dialogue (CONNECT DELETE)
+ */
+int processSrvEDisconnect(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Liste les clients satisfaisant un filtre, locaux puis distants, terminés
+ *              par une erreur (CONNECT GET [rôle,statut,préfixe], sans filtre : hôtes)
+ */
+int processSrvEListHosts(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Convient de la version et des capacités du protocole (HELLO POST)
+ */
+int processSrvEHello(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Traite une requête de mise en relation (MATCH)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		POST [classement] : répond, à lui et à l'attente choisie, par les infos
+ * 				de l'autre client dès qu'un client de l'autre rôle compatible est en
+ * 				attente. DELETE : abandonne l'attente.
+ */
+int processSrvEMatch(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Libère l'entrée du registre d'un client dont le dialogue se termine
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ *
+ * \note		appelle la callback de terminaison une seule fois
+ */
+void dropSrvEClient(eServThreadParams_t *params);
+/**
+ * \brief       Retire un client de la file de mise en relation
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		reason   	motif envoyé au client dans une réponse d'erreur
+ * 							(NULL : aucune réponse)
+ */
+void cancelSrvEMatch(eServThreadParams_t *params, char *reason);
+/**
+ * \brief       Traite une requête de spectateur ou d'hôte diffusant sa partie (SPECTATE)
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		request  	la requête reçue
+ *
+ * \return		1 : le dialogue continue
+ *
+ * \note		GET hôte : suit la partie de l'hôte. POST status:données (hôte) :
+ * 				publie un événement, sans réponse sauf erreur. DELETE : le spectateur
+ * 				se désabonne, l'hôte termine sa partie.
+ */
+int processSrvESpectate(eServThreadParams_t *params, req_t *request);
+/**
+ * \brief       Désabonne un client de la partie qu'il regarde
+ *
+ * \param		params   	paramètres du dialogue avec le client
+ * \param		reason   	motif envoyé au client dans une réponse d'erreur
+ * 							(NULL : aucune réponse)
+ */
+void cancelSrvESpectate(eServThreadParams_t *params, char *reason);
+/**
+ * \brief       Prévient un spectateur de la fin de la partie qu'il regardait
+ *
+ * \param		owner   	paramètres du dialogue avec le spectateur, déjà désabonné
+ *
+ * \note		à fournir au relais (createRelay)
+ */
+void endSrvESpectate(void *owner);
 
 /**
- * \brief      Envoie une requête via un flag et attends une sémaphore.
+ * \brief      Envoie une requête via un flag, sans attendre sa fin
  *
  * \param      reqVar     Flag de la requête
- * \param      semReqAck  Sémaphore d'attente
+ *
+ * \note       la fin de la requête est signalée par eCltThreadParams_t.onEvent
  */
-void postRequest(int *reqVar, sem_t *semReqAck);
+void postRequest(int *reqVar);
 
 
 #endif /* DIAL_H */
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ *	\file		discovery.h
+ *	\brief		Fichier en-tête de la découverte sur le LAN du serveur d'enregistrement
+ *				et des hôtes (mode sans serveur)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef DISCOVERY_H
+#define DISCOVERY_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "data.h"
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief port UDP sur lequel le serveur d'enregistrement répond aux sondes
+ */
+#define DISCOVERY_PORT 			50001
+/**
+ * @brief adresse de diffusion utilisée par les sondes
+ */
+#define DISCOVERY_BROADCAST 	"255.255.255.255"
+/**
+ * @brief contenu d'une sonde de découverte
+ */
+#define DISCOVERY_PROBE 		"BATTLESHIP?"
+/**
+ * @brief format de la réponse à une sonde (port TCP du serveur d'enregistrement)
+ */
+#define DISCOVERY_REPLY 		"BATTLESHIP!%hd"
+/**
+ * @brief délai d'attente d'une réponse en millisecondes
+ */
+#define DISCOVERY_TIMEOUT 		1000
+/**
+ * @brief pause en millisecondes d'un répondeur après une erreur de réception
+ */
+#define DISCOVERY_BACKOFF 		1000
+/**
+ * @brief mot clé saisi par l'utilisateur pour chercher le serveur sur le LAN
+ */
+#define DISCOVERY_KEYWORD 		"auto"
+/**
+ * @brief port UDP sur lequel les clients HOST répondent aux sondes (mode sans serveur)
+ */
+#define HOST_DISCOVERY_PORT 	50002
+/**
+ * @brief groupe multicast rejoint par les clients HOST en plus de la diffusion
+ */
+#define HOST_DISCOVERY_GROUP 	"239.255.66.83"
+/**
+ * @brief contenu d'une sonde de recherche d'hôtes
+ */
+#define HOST_DISCOVERY_PROBE 	"BATTLESHIP_HOSTS?"
+/**
+ * @brief préfixe de la réponse d'un hôte, suivi de ses infos sérialisées
+ */
+#define HOST_DISCOVERY_REPLY 	"BATTLESHIP_HOST!"
+/**
+ * @brief mot clé saisi par l'utilisateur pour jouer sur le LAN sans serveur d'enregistrement
+ */
+#define LAN_KEYWORD 			"lan"
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Répond aux sondes de découverte reçues sur une socket DGRAM
+ *
+ * @param      sockDisc  socket DGRAM liée au port DISCOVERY_PORT
+ * @param[in]  port      port TCP du serveur d'enregistrement à annoncer
+ *
+ * @note       Les sondes sont reçues et les réponses émises par lots
+ *             (recevoirLot/envoyerLot). Ne retourne jamais.
+ */
+void serveSrvEDiscovery(socket_t *sockDisc, short port);
+/**
+ * @brief      Cherche un serveur d'enregistrement sur le LAN
+ *
+ * @param[out] adrIP    adresse du serveur trouvé (ADR_SIZE octets)
+ * @param[out] port     port du serveur trouvé
+ * @param[in]  timeout  délai d'attente maximum en millisecondes
+ *
+ * @return     1 si un serveur a répondu, 0 sinon
+ */
+int discoverSrvE(char *adrIP, short *port, int timeout);
+/**
+ * @brief      Crée la socket DGRAM de réponse aux sondes de recherche d'hôtes
+ *
+ * @return     socket liée au port HOST_DISCOVERY_PORT et abonnée à HOST_DISCOVERY_GROUP
+ *
+ * @note       Plusieurs hôtes d'une même machine peuvent ouvrir cette socket :
+ *             les sondes diffusées et multicast sont remises à chacun.
+ */
+socket_t createHostDiscoverySocket();
+/**
+ * @brief      Répond aux sondes de recherche d'hôtes avec les infos du client HOST
+ *
+ * @param      sockDisc  socket créée par createHostDiscoverySocket()
+ * @param      infos     infos du client HOST à annoncer
+ *
+ * @note       Les sondes sont reçues et les réponses émises par lots. Ne retourne jamais.
+ */
+void serveHostDiscovery(socket_t *sockDisc, clientInfo_t *infos);
+/**
+ * @brief      Cherche les hôtes du LAN sans serveur d'enregistrement
+ *
+ * @param[out] hosts    tableau des hôtes trouvés
+ * @param[in]  max      taille du tableau
+ * @param[in]  timeout  durée de la collecte des réponses en millisecondes
+ *
+ * @return     le nombre d'hôtes distincts trouvés
+ *
+ * @note       L'adresse d'un hôte est celle d'où provient sa réponse ; les
+ *             réponses multiples (diffusion + multicast) sont dédoublonnées
+ *             sur l'adresse applicative.
+ */
+int discoverHosts(clientInfo_t *hosts, int max, int timeout);
+
+
+#endif /* DISCOVERY_H */
@@ -0,0 +1,90 @@
+/**
+ *	\file		events.h
+ *	\brief		Fichier en-tête de la file d'événements du dialogue vers l'interface
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef EVENTS_H
+#define EVENTS_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "repReq.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      événement local, hors protocole : latences des hôtes mesurées
+ *             (données : numéro de la page sondée)
+ */
+#define EVENT_LATENCY 		1
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      événement remis à l'interface : code d'état du protocole et données
+ */
+typedef struct {
+
+	/** code d'état (fin d'une requête ou événement de partie) */
+	short 	status;
+	/** données de l'événement */
+	char 	data[DATA_LENGTH];
+
+} uiEvent_t;
+/**
+ * @brief      file d'événements : un tube, lisible par poll() avec l'entrée standard
+ *
+ * @note       un événement tient dans une écriture atomique (PIPE_BUF)
+ */
+typedef struct {
+
+	/** extrémités de lecture et d'écriture du tube */
+	int 	fds[2];
+
+} eventQueue_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une file d'événements vide
+ *
+ * @param      queue  la file à initialiser
+ *
+ * @note       termine le programme si le tube ne peut être créé
+ */
+void createEventQueue(eventQueue_t *queue);
+/**
+ * @brief      Descripteur à surveiller : lisible quand un événement est en attente
+ *
+ * @param      queue  la file
+ *
+ * @return     le descripteur de lecture
+ */
+int getEventFd(eventQueue_t *queue);
+/**
+ * @brief      Ajoute un événement, sans jamais bloquer l'appelant
+ *
+ * @param      queue   la file
+ * @param[in]  status  code d'état
+ * @param      data    données (tronquées à DATA_LENGTH)
+ *
+ * @return     1 si l'événement est ajouté, 0 si la file est pleine
+ */
+int postEvent(eventQueue_t *queue, short status, char *data);
+/**
+ * @brief      Retire le prochain événement, sans attendre
+ *
+ * @param      queue  la file
+ * @param      event  l'événement retiré
+ *
+ * @return     1 si un événement est retiré, 0 si la file est vide
+ */
+int nextEvent(eventQueue_t *queue, uiEvent_t *event);
+
+#endif /* EVENTS_H */
@@ -0,0 +1,166 @@
+/**
+ *	\file		game.h
+ *	\brief		Fichier en-tête du moteur de partie (grilles en bitboards et règles du tir)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef GAME_H
+#define GAME_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief côté de la grille
+ */
+#define BOARD_SIZE 			10
+/**
+ * @brief nombre de cases de la grille
+ */
+#define BOARD_CELLS 		(BOARD_SIZE * BOARD_SIZE)
+/**
+ * @brief nombre de navires d'une flotte
+ */
+#define FLEET_SIZE 			5
+/**
+ * @brief pas de vainqueur (partie en cours)
+ */
+#define NO_WINNER 			-1
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   M A C R O S
+ */
+/**
+ * @brief numéro de la case (x, y), ligne par ligne
+ */
+#define CELL(x, y) 			((y) * BOARD_SIZE + (x))
+/**
+ * @brief bitboard ne contenant que la case cell
+ */
+#define BIT(cell) 			((bitboard_t) 1 << (cell))
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      ensemble de cases de la grille, un bit par case (bit CELL(x, y))
+ */
+typedef unsigned __int128 bitboard_t;
+/**
+ * @brief      résultat d'un tir
+ */
+typedef enum {SHOT_MISS, SHOT_HIT, SHOT_SUNK, SHOT_WON, SHOT_INVALID} shotResult_t;
+/**
+ * @brief      grille d'un joueur : sa flotte et les tirs de l'adversaire
+ */
+typedef struct {
+
+	/** cases de chaque navire (0 : pas encore placé) */
+	bitboard_t 		ships[FLEET_SIZE];
+	/** réunion des navires */
+	bitboard_t 		fleet;
+	/** cases visées par l'adversaire */
+	bitboard_t 		shots;
+
+} board_t;
+/**
+ * @brief      partie entre deux joueurs
+ */
+typedef struct match {
+
+	/** grille de chaque joueur, visée par l'autre */
+	board_t 			boards[2];
+	/** joueur au trait */
+	uint8_t 			current;
+	/** nombre de tirs joués */
+	uint32_t 			turn;
+	/** vainqueur, NO_WINNER tant que la partie continue */
+	int 				winner;
+	/** journal de la partie (NULL : aucun) */
+	struct replayLog 	*log;
+
+} match_t;
+/**
+ * @brief longueur de chaque navire de la flotte
+ */
+extern const int shipLengths[FLEET_SIZE];
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Cases occupées par un navire
+ *
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue (coin haut gauche)
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     les cases, 0 si le navire sort de la grille
+ */
+bitboard_t shipCells(int ship, int cell, int vertical);
+/**
+ * @brief      Nombre de cases d'un bitboard
+ *
+ * @param[in]  cells  les cases
+ *
+ * @return     le nombre de bits à 1
+ */
+int countCells(bitboard_t cells);
+/**
+ * @brief      Case la plus basse d'un bitboard
+ *
+ * @param[in]  cells  les cases, non vide
+ *
+ * @return     l'indice de la case
+ */
+int lowestCell(bitboard_t cells);
+/**
+ * @brief      Prépare une partie sans navire
+ *
+ * @param      match  la partie
+ * @param      log    journal de la partie (NULL : aucun), déjà démarré par startReplay
+ */
+void createMatch(match_t *match, struct replayLog *log);
+/**
+ * @brief      Place un navire d'un joueur
+ *
+ * @param      match     la partie
+ * @param[in]  player    le joueur (0 ou 1)
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     0, -1 si le navire est déjà placé, sort de la grille, en chevauche
+ *             un autre ou si les tirs ont commencé
+ */
+int placeShip(match_t *match, int player, int ship, int cell, int vertical);
+/**
+ * @brief      La flotte d'un joueur est-elle entièrement placée
+ *
+ * @param      match   la partie
+ * @param[in]  player  le joueur
+ *
+ * @return     1 si tous les navires sont placés, 0 sinon
+ */
+int fleetReady(match_t *match, int player);
+/**
+ * @brief      Tir d'un joueur sur la grille de l'adversaire
+ *
+ * @param      match   la partie
+ * @param[in]  player  le tireur, qui doit être au trait
+ * @param[in]  cell    la case visée
+ *
+ * @return     le résultat, SHOT_INVALID si ce n'est pas son tour, si la case a déjà
+ *             été visée, si une flotte est incomplète ou si la partie est finie
+ *
+ * @note       les joueurs tirent chacun leur tour ; chaque tir valide est journalisé
+ */
+shotResult_t fireAt(match_t *match, int player, int cell);
+
+#endif /* GAME_H */
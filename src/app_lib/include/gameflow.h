@@ -0,0 +1,121 @@
+/**
+ *	\file		gameflow.h
+ *	\brief		Fichier en-tête du cycle de vie d'une partie : états, tour et échéances
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef GAMEFLOW_H
+#define GAMEFLOW_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "datastructs.h"
+#include "timerwheel.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      délai pour qu'un adversaire rejoigne la partie (ms)
+ */
+#define FLOW_WAIT_TIMEOUT 	120000
+/**
+ * @brief      délai pour placer les flottes, non prolongé par les instantanés (ms)
+ */
+#define FLOW_PLACE_TIMEOUT 	120000
+/**
+ * @brief      délai pour jouer un coup, au-delà le joueur au trait déclare forfait (ms)
+ */
+#define FLOW_MOVE_TIMEOUT 	60000
+/**
+ * @brief      transition refusée
+ */
+#define FLOW_REFUSED 		-1
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      états d'une partie (FINISHED et ABANDONED sont terminaux)
+ */
+typedef enum {GAME_WAITING, GAME_PLACING, GAME_PLAYING, GAME_FINISHED, GAME_ABANDONED, GAME_STATES} gameState_t;
+/**
+ * @brief      événements du cycle de vie : instantané, changement de joueur, tir,
+ *             fin par l'hôte, départ de l'hôte, échéance dépassée
+ */
+typedef enum {FLOW_SNAPSHOT, FLOW_TURN, FLOW_SHOT, FLOW_END, FLOW_LEAVE, FLOW_TIMEOUT, FLOW_EVENTS} flowEvent_t;
+/**
+ * @brief      cycle de vie d'une partie
+ */
+typedef struct {
+
+	/** état courant */
+	gameState_t 	state;
+	/** joueur au trait (vide : aucun) */
+	char 			owner[PSEUDO_SIZE];
+	/** nombre de coups joués */
+	unsigned 		moves;
+	/** échéance de l'état courant */
+	wheelTimer_t 	deadline;
+
+} gameFlow_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ouvre une partie en attente d'adversaire et arme son échéance
+ *
+ * @param      flow       le cycle de vie
+ * @param      wheel      la roue des échéances
+ * @param[in]  onExpired  action appelée à l'échéance
+ * @param      owner      propriétaire de l'échéance
+ */
+void createFlow(gameFlow_t *flow, timerWheel_t *wheel, void (*onExpired)(wheelTimer_t *timer), void *owner);
+/**
+ * @brief      Reprend le cycle de vie d'une partie d'une autre instance (passation)
+ *
+ * @param      flow    le cycle de vie, ouvert par createFlow
+ * @param      wheel   la roue des échéances
+ * @param[in]  state   l'état de la partie (non terminal)
+ * @param      player  joueur au trait (vide : aucun)
+ * @param[in]  moves   nombre de coups joués
+ *
+ * @note       l'échéance de l'état est réarmée en entier : le délai déjà écoulé dans
+ *             l'autre instance est offert
+ */
+void resumeFlow(gameFlow_t *flow, timerWheel_t *wheel, gameState_t state, char *player, unsigned moves);
+/**
+ * @brief      Applique un événement au cycle de vie
+ *
+ * @param      flow    le cycle de vie
+ * @param      wheel   la roue des échéances
+ * @param[in]  event   l'événement
+ * @param      player  joueur désormais au trait (FLOW_TURN), NULL sinon
+ *
+ * @return     le nouvel état, FLOW_REFUSED si l'événement n'est pas permis
+ *
+ * @note       l'échéance est réarmée à chaque changement d'état et à chaque coup ;
+ *             un état terminal la désarme
+ */
+int stepFlow(gameFlow_t *flow, timerWheel_t *wheel, flowEvent_t event, char *player);
+/**
+ * @brief      Un état est-il terminal
+ *
+ * @param[in]  state  l'état
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int flowEnded(gameState_t state);
+/**
+ * @brief      Nom d'un état
+ *
+ * @param[in]  state  l'état
+ *
+ * @return     le nom
+ */
+const char *flowStateName(gameState_t state);
+
+#endif /* GAMEFLOW_H */
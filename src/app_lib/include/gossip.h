@@ -0,0 +1,180 @@
+/**
+ *	\file		gossip.h
+ *	\brief		Fichier en-tête de la réplication des hôtes entre serveurs d'enregistrement
+ *				(bavardage par deltas et anti-entropie sur UDP)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef GOSSIP_H
+#define GOSSIP_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "data.h"
+#include "datastructs.h"
+#include "nameindex.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief nombre maximum de pairs configurés
+ */
+#define MAX_PEERS 				8
+/**
+ * @brief nombre maximum d'instances suivies (soi compris, anciennes incarnations comprises)
+ */
+#define MAX_NODES 				(4 * MAX_PEERS)
+/**
+ * @brief période d'un tour de bavardage en millisecondes
+ */
+#define GOSSIP_PERIOD 			1000
+/**
+ * @brief délai sans nouvelles au-delà duquel les hôtes d'une instance ne sont plus listés (s)
+ */
+#define GOSSIP_TIMEOUT 			5
+/**
+ * @brief délai sans nouvelles au-delà duquel une instance est oubliée (s)
+ */
+#define GOSSIP_FORGET 			60
+/**
+ * @brief en-tête d'un résumé : suivi d'une ligne GOSSIP_DIGEST_LINE par instance connue
+ */
+#define GOSSIP_DIGEST 			"GOSSIP?"
+/**
+ * @brief ligne d'un résumé : instance, version complète connue, battement de cœur
+ */
+#define GOSSIP_DIGEST_LINE 		"%x=%u:%u"
+/**
+ * @brief en-tête d'un delta : instance, version de base, version atteinte
+ */
+#define GOSSIP_DELTA 			"GOSSIP!%x:%u:%u"
+/**
+ * @brief format de sérialisation d'une ligne de delta : entrée, version, vivante,
+ * 		  suivis des infos du client
+ */
+#define GOSSIP_DELTA_OUT 		"%d:%u:%d:"
+/**
+ * @brief format de désérialisation d'une ligne de delta (%n : début des infos du client)
+ */
+#define GOSSIP_DELTA_IN 		"%d:%u:%d:%n"
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      entrée répliquée : état d'une entrée du registre d'une instance
+ */
+typedef struct {
+
+	/** version de l'entrée (horloge de l'instance d'origine, 0 : jamais vue) */
+	uint32_t 		version;
+	/** l'entrée décrit un hôte joignable */
+	int 			alive;
+	/** infos de l'hôte */
+	clientInfo_t 	info;
+
+} gossipEntry_t;
+/**
+ * @brief      instance connue et ses entrées répliquées
+ */
+typedef struct {
+
+	/** identifiant de l'instance (0 : emplacement libre) */
+	uint32_t 		origin;
+	/** toutes les versions jusqu'à celle-ci sont connues (vecteur de versions) */
+	uint32_t 		version;
+	/** dernier battement de cœur connu */
+	uint32_t 		heartbeat;
+	/** date du dernier battement de cœur nouveau */
+	time_t 			lastSeen;
+	/** entrées, indexées comme le registre de l'instance */
+	gossipEntry_t 	*entries;
+
+} gossipNode_t;
+/**
+ * @brief      état de la réplication d'un serveur d'enregistrement
+ */
+typedef struct {
+
+	/** socket DGRAM de bavardage */
+	socket_t 				sock;
+	/** adresses des pairs */
+	struct sockaddr_storage peers[MAX_PEERS];
+	/** tailles des adresses des pairs */
+	socklen_t 				peerLens[MAX_PEERS];
+	/** nombre de pairs */
+	int 					peerAmount;
+	/** instances connues, nodes[0] est l'instance locale */
+	gossipNode_t 			nodes[MAX_NODES];
+	/** taille des registres */
+	int 					capacity;
+	/** version locale déjà poussée aux pairs */
+	uint32_t 				pushed;
+	/** registre local publié (lu depuis le thread qui le modifie seulement) */
+	clientInfo_t 			*local;
+	/** la boucle de bavardage doit se terminer */
+	int 					stopped;
+	/** verrou protégeant nodes et stopped */
+	pthread_mutex_t 		lock;
+
+} gossip_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Prépare la réplication du registre local
+ *
+ * @param      gossip    l'état à initialiser
+ * @param[in]  sock      socket DGRAM de bavardage (liée au port d'écoute des pairs)
+ * @param      peers     adresses des pairs, séparées par des virgules (ip:port ou [ipv6]:port)
+ * @param      local     registre local
+ * @param[in]  capacity  taille du registre (identique sur toutes les instances)
+ *
+ * @return     le nombre de pairs reconnus
+ */
+int createGossip(gossip_t *gossip, socket_t sock, char *peers, clientInfo_t *local, int capacity);
+/**
+ * @brief      Boucle de bavardage : échange résumés et deltas avec les pairs. Ne se
+ *             termine qu'après stopGossip, à lancer dans un thread.
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       les datagrammes qui ne viennent pas d'un pair configuré sont ignorés
+ */
+void serveGossip(gossip_t *gossip);
+/**
+ * @brief      Publie les changements du registre local
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       à appeler depuis le thread qui modifie le registre local
+ */
+void publishGossip(gossip_t *gossip);
+/**
+ * @brief      Arrête la boucle de bavardage (socket transmise à une autre instance)
+ *
+ * @param      gossip  l'état de la réplication
+ *
+ * @note       la boucle se termine au plus tard GOSSIP_PERIOD ms après
+ */
+void stopGossip(gossip_t *gossip);
+/**
+ * @brief      Liste les hôtes enregistrés sur les autres instances joignables
+ *
+ * @param      gossip  l'état de la réplication
+ * @param      hosts   tableau à remplir
+ * @param[in]  max     taille du tableau
+ * @param      filter  filtre des hôtes (NULL : tous), filter->skip hôtes sont sautés
+ *
+ * @return     le nombre d'hôtes (sans ceux déjà présents dans le registre local)
+ */
+int listGossipHosts(gossip_t *gossip, clientInfo_t *hosts, int max, hostFilter_t *filter);
+
+#endif /* GOSSIP_H */
@@ -0,0 +1,155 @@
+/**
+ *	\file		hostcache.h
+ *	\brief		Fichier en-tête du cache paginé de la liste des hôtes du client
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef HOSTCACHE_H
+#define HOSTCACHE_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <pthread.h>
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      nombre d'hôtes d'une page (une réponse à CONNECT GET)
+ */
+#define HOST_PAGE_SIZE 		10
+/**
+ * @brief      nombre de pages gardées en cache (fenêtre autour de la page affichée)
+ */
+#define HOST_CACHE_PAGES 	4
+/**
+ * @brief      page absente du cache / dernière page inconnue
+ */
+#define NO_PAGE 			-1
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      fenêtre de pages de la liste des hôtes, remplie par le dialogue et
+ *             lue par l'interface
+ *
+ * @note       une page chargée pour un filtre remplacé depuis (generation) est ignorée
+ */
+typedef struct {
+
+	/** hôtes de chaque emplacement */
+	clientInfo_t 	pages[HOST_CACHE_PAGES][HOST_PAGE_SIZE];
+	/** numéro de la page de chaque emplacement, NO_PAGE si libre */
+	int 			numbers[HOST_CACHE_PAGES];
+	/** nombre d'hôtes de chaque emplacement */
+	int 			amounts[HOST_CACHE_PAGES];
+	/** dernière page de la liste, NO_PAGE tant qu'aucune page incomplète n'est reçue */
+	int 			lastPage;
+	/** page attendue par l'interface (requestHosts) */
+	int 			wanted;
+	/** page à précharger (requestPrefetch), NO_PAGE si aucune */
+	int 			prefetch;
+	/** incrémenté à chaque vidage du cache */
+	unsigned 		generation;
+	/** accès concurrents de l'interface et du dialogue */
+	pthread_mutex_t lock;
+
+} hostCache_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée un cache vide
+ *
+ * @param      cache  le cache à initialiser
+ */
+void createHostCache(hostCache_t *cache);
+/**
+ * @brief      Vide le cache, quand la liste demandée change (filtre, retour au menu)
+ *
+ * @param      cache  le cache
+ */
+void clearHostCache(hostCache_t *cache);
+/**
+ * @brief      Génération courante du cache, à relever avant de charger une page
+ *
+ * @param      cache  le cache
+ *
+ * @return     la génération
+ */
+unsigned getHostCacheGeneration(hostCache_t *cache);
+/**
+ * @brief      Note la page attendue par l'interface, à charger par le dialogue
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ */
+void setWantedHostPage(hostCache_t *cache, int page);
+/**
+ * @brief      Page attendue par l'interface
+ *
+ * @param      cache  le cache
+ *
+ * @return     le numéro de la page
+ */
+int getWantedHostPage(hostCache_t *cache);
+/**
+ * @brief      Note la page à précharger par le dialogue
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page, NO_PAGE si aucune
+ */
+void setPrefetchHostPage(hostCache_t *cache, int page);
+/**
+ * @brief      Page à précharger
+ *
+ * @param      cache  le cache
+ *
+ * @return     le numéro de la page, NO_PAGE si aucune
+ */
+int getPrefetchHostPage(hostCache_t *cache);
+/**
+ * @brief      Recopie une page du cache
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ * @param      hosts  HOST_PAGE_SIZE hôtes, la fin est vidée
+ *
+ * @return     le nombre d'hôtes de la page, NO_PAGE si elle n'est pas en cache
+ */
+int getHostPage(hostCache_t *cache, int page, clientInfo_t *hosts);
+/**
+ * @brief      Une page est-elle en cache
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int hasHostPage(hostCache_t *cache, int page);
+/**
+ * @brief      Range une page chargée, à la place de la plus éloignée de la page attendue
+ *
+ * @param      cache       le cache
+ * @param[in]  generation  génération relevée avant le chargement
+ * @param[in]  page        numéro de la page
+ * @param      hosts       les hôtes de la page
+ * @param[in]  amount      nombre d'hôtes (moins de HOST_PAGE_SIZE : dernière page)
+ */
+void storeHostPage(hostCache_t *cache, unsigned generation, int page, clientInfo_t *hosts, int amount);
+/**
+ * @brief      La liste peut-elle avoir une page après celle-ci
+ *
+ * @param      cache  le cache
+ * @param[in]  page   numéro de la page
+ *
+ * @return     1 si oui, 0 si page est la dernière
+ */
+int hasNextHostPage(hostCache_t *cache, int page);
+
+#endif /* HOSTCACHE_H */
@@ -16,6 +16,7 @@
 #include <stdarg.h>
 #include <semaphore.h>
 #include "datastructs.h"
+#include "game.h"
 /*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
@@ -28,6 +29,14 @@
  * @brief 	port par défaut choisi par l'interface
  */
 #define DEFAULT_PORT		15500
+/**
+ * @brief 	format de saisie d'une adresse applicative IPv4 (ip:port)
+ */
+#define ADDR_INPUT_FMT		"%[^:]:%hd"
+/**
+ * @brief 	format de saisie d'une adresse applicative IPv6 ([ip]:port)
+ */
+#define ADDR6_INPUT_FMT		"[%[^]]]:%hd"
 /**
  * @brief 	code de succès des fonctions d'entrées
  */
@@ -50,6 +59,10 @@
  * 			de détermination du nombre de valeurs attendues par un format
  */
 #define EXPECT_ERROR		-4
+/**
+ * @brief 	délai de rafraîchissement de la liste des hôtes affichée (ms)
+ */
+#define HOSTS_REFRESH_DELAY	3000
 /*
 *****************************************************************************************
  *	\noop		S T R C T U R E S   DE   D O N N E E S
@@ -58,6 +71,11 @@
  * @brief      type de fonction utilisé pour les callbacks des menus
  */
 typedef void (*callback)();
+/**
+ * @brief      type de fonction appelée par la boucle d'attente des entrées
+ *             (événement, minuterie), renvoie 1 si elle a affiché quelque chose
+ */
+typedef int (*inputHandler)();
 /**
  * @brief      Paramètres à fournir au menu pour son bon fonctionnement.
  */
@@ -67,6 +85,14 @@ typedef struct {
 	callback 		showHosts;
 	/// callback de fermeture du programme
 	callback 		exitProgram;
+	/// callback de recherche d'un adversaire (mise en relation)
+	callback 		findOpponent;
+	/// callback de suivi d'une partie en spectateur
+	callback 		spectateGame;
+	/// callback de changement de page des hôtes (+1 / -1), NULL si liste non paginée
+	void 			(*turnHostsPage)(int delta);
+	/// rafraîchissement périodique des hôtes affichés, NULL si aucun
+	inputHandler 	refreshHosts;
 	/// pointeur vers la liste d'hôtes maintenue par le client
 	clientInfo_t	*hosts;
 	
@@ -88,6 +114,8 @@ void setupUserInfos(clientInfo_t *infos);
 /**
  * @brief      Demande à l'utilisateur l'adresse applicative du serveur 
  * 			   d'enregistrement ou utilise celle par défaut.
+ * 			   Formats acceptés : ip:port, [ipv6]:port, unix:/chemin ou les
+ * 			   mots clés DISCOVERY_KEYWORD et LAN_KEYWORD (recopiés dans userIP)
  *
  * @param[in]   adrIP     l'adresse ip par défaut
  * @param[in]  	port      le port par défaut
@@ -102,12 +130,85 @@ void getSrvEAddress(char* adrIP, unsigned short port, char *userIP, short *userP
  * @param[in]  amount  la taille de `hosts`
  */
 void displayHosts(clientInfo_t *hosts, int amount);
+/**
+ * @brief      Affiche une liste d'hôtes classés avec leur latence
+ *
+ * @param      hosts   les hôtes à afficher
+ * @param      rtts    leurs latences (µs, RTT_UNKNOWN si inconnue)
+ * @param[in]  amount  la taille de `hosts`
+ */
+void displayRankedHosts(clientInfo_t *hosts, int *rtts, int amount);
+/**
+ * @brief      Affiche le numéro de la page d'hôtes affichée
+ *
+ * @param[in]  page  numéro de la page (à partir de 0)
+ * @param[in]  more  1 s'il peut y avoir une page suivante
+ */
+void displayHostsPage(int page, int more);
+/**
+ * @brief      Demande à l'utilisateur le début du nom des hôtes à lister
+ *
+ * @param      prefix  le préfixe saisi (PSEUDO_SIZE), vide si aucun
+ */
+void askHostPrefix(char *prefix);
+/**
+ * @brief      Demande à l'utilisateur son classement pour la mise en relation
+ *
+ * @return     le classement, MATCH_ANY si l'utilisateur n'en donne pas
+ */
+int askRating();
+/**
+ * @brief      Affiche l'adversaire trouvé par la mise en relation
+ *
+ * @param      opponent  l'adversaire (status CONNECTED si trouvé)
+ */
+void displayOpponent(clientInfo_t *opponent);
+/**
+ * @brief      Demande à l'utilisateur le nom de l'hôte de la partie à regarder
+ *
+ * @param      name  le nom saisi (PSEUDO_SIZE), vide si aucun
+ */
+void askHostName(char *name);
+/**
+ * @brief      Affiche un événement de la partie regardée
+ *
+ * @param[in]  status  code de l'événement (CELL, CURRENT_PLAYER ou GAME)
+ * @param      data    données de l'événement
+ */
+void displayGameEvent(short status, char *data);
+/**
+ * @brief      Affiche les deux grilles d'une partie
+ *
+ * @param      match  la partie
+ */
+void displayMatch(match_t *match);
 /**
  * @brief      affiche les menus dans le terminal avec une machine à états
  *
  * @param[in]  params  paramètres utiles aux menus (callbacks etc...)
  */
 void displayPlayerMenu(playerMenuParams_t params);
+/**
+ * @brief      Surveille un descripteur en attendant les entrées de l'utilisateur
+ *
+ * @param[in]  fd       le descripteur (-1 : aucun)
+ * @param[in]  onReady  appelée quand fd est lisible
+ */
+void setInputSource(int fd, inputHandler onReady);
+/**
+ * @brief      Arme une minuterie périodique en attendant les entrées de l'utilisateur
+ *
+ * @param[in]  delay    période (ms), 0 pour désarmer
+ * @param[in]  onTimer  appelée à chaque période
+ */
+void setInputTimer(int delay, inputHandler onTimer);
+/**
+ * @brief      Affiche l'invite de la prochaine entrée, réaffichée après un événement
+ *
+ * @param      fmt   format de l'invite
+ * @param[in]  ...   valeurs du format
+ */
+void setInputPrompt(char *fmt, ...);
 /**
  * @brief      Récupère une entrée dans stdin avec des sécurités
  *
@@ -124,6 +225,9 @@ int retrieveInput(char *fmt, ...);
  * @param[in]  size    la taille du buffer
  *
  * @return     retourne STEP_SUCCESS, USE_DEFAULT ou FGETS_ERROR 
+ *
+ * @note       en attendant la ligne, traite les événements de la source et de la
+ *             minuterie (setInputSource, setInputTimer)
  */
 int saferFgets(char *buffer, int size);
 /**
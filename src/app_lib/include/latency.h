@@ -0,0 +1,125 @@
+/**
+ *	\file		latency.h
+ *	\brief		Fichier en-tête de la mesure de latence des hôtes et de leur classement
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef LATENCY_H
+#define LATENCY_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <pthread.h>
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      nombre maximum de sondes en cours simultanément
+ */
+#define PROBE_CONCURRENCY 	32
+/**
+ * @brief      délai au-delà duquel un hôte est jugé injoignable (ms)
+ */
+#define PROBE_TIMEOUT 		1000
+/**
+ * @brief      latence inconnue (hôte jamais joint)
+ */
+#define RTT_UNKNOWN 		-1
+/**
+ * @brief      poids d'une nouvelle mesure dans la latence lissée (1/RTT_SMOOTHING)
+ */
+#define RTT_SMOOTHING 		8
+/**
+ * @brief      nombre d'hôtes dont la latence est retenue
+ */
+#define RTT_TABLE_SIZE 		128
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      latence lissée d'un hôte, identifié par son adresse applicative
+ */
+typedef struct {
+
+	/** adresse de l'hôte */
+	char 		address[ADDR_SIZE];
+	/** port de l'hôte */
+	short 		port;
+	/** latence lissée (µs), RTT_UNKNOWN si entrée libre */
+	int 		srtt;
+	/** numéro de la dernière mise à jour, pour remplacer la plus ancienne */
+	unsigned 	stamp;
+
+} hostRtt_t;
+/**
+ * @brief      latences des hôtes sondés, partagées entre l'interface et les sondes
+ */
+typedef struct {
+
+	/** entrées */
+	hostRtt_t 		entries[RTT_TABLE_SIZE];
+	/** compteur de mises à jour */
+	unsigned 		clock;
+	/** accès concurrents */
+	pthread_mutex_t lock;
+
+} rttTable_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une table de latences vide
+ *
+ * @param      table  la table à initialiser
+ */
+void createRttTable(rttTable_t *table);
+/**
+ * @brief      Mesure en parallèle le temps d'établissement d'une connexion TCP vers
+ *             chaque hôte (un refus compte : il revient en un aller-retour)
+ *
+ * @param      hosts    les hôtes (les entrées qui ne sont pas hôtes sont ignorées)
+ * @param[in]  amount   la taille de hosts
+ * @param      rtts     les mesures (µs), RTT_UNKNOWN si l'hôte n'a pas répondu
+ * @param[in]  timeout  délai de chaque sonde (ms)
+ *
+ * @note       au plus PROBE_CONCURRENCY connexions en cours : une liste de cette
+ *             taille est mesurée en un aller-retour vers l'hôte le plus lent
+ */
+void probeHosts(clientInfo_t *hosts, int amount, int *rtts, int timeout);
+/**
+ * @brief      Intègre des mesures à la latence lissée des hôtes
+ *
+ * @param      table   la table
+ * @param      hosts   les hôtes
+ * @param      rtts    leurs mesures (RTT_UNKNOWN : ignorée)
+ * @param[in]  amount  la taille de hosts
+ */
+void updateRtts(rttTable_t *table, clientInfo_t *hosts, int *rtts, int amount);
+/**
+ * @brief      Latence lissée d'un hôte
+ *
+ * @param      table  la table
+ * @param      host   l'hôte
+ *
+ * @return     la latence (µs), RTT_UNKNOWN si l'hôte n'a jamais répondu
+ */
+int getRtt(rttTable_t *table, clientInfo_t *host);
+/**
+ * @brief      Trie les hôtes par latence lissée croissante, les inconnues à la fin
+ *
+ * @param      table   la table
+ * @param      hosts   les hôtes, triés sur place (ordre conservé à égalité)
+ * @param      rtts    leurs latences, remplies dans l'ordre du tri
+ * @param[in]  amount  la taille de hosts
+ *
+ * @return     1 si l'ordre a changé, 0 sinon
+ */
+int rankHosts(rttTable_t *table, clientInfo_t *hosts, int *rtts, int amount);
+
+#endif /* LATENCY_H */
@@ -0,0 +1,151 @@
+/**
+ *	\file		matchmaking.h
+ *	\brief		Fichier en-tête de la file d'attente de mise en relation joueurs/hôtes
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef MATCHMAKING_H
+#define MATCHMAKING_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief nombre de tranches de classement
+ */
+#define MATCH_BUCKETS 			8
+/**
+ * @brief largeur d'une tranche de classement (la dernière tranche est ouverte)
+ */
+#define MATCH_BUCKET_WIDTH 		250
+/**
+ * @brief classement indifférent : mis en relation avec n'importe quelle tranche
+ */
+#define MATCH_ANY 				-1
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      ticket d'un client en attente
+ */
+typedef struct {
+
+	/** ordre d'arrivée (clé du tas) */
+	uint32_t 		seq;
+	/** rôle du client */
+	userRole_t 		role;
+	/** tranche de classement (MATCH_BUCKETS : indifférent) */
+	int 			bucket;
+	/** position dans son tas, ou ticket libre suivant si le ticket est libre */
+	int 			pos;
+	/** propriétaire du ticket, rendu à la mise en relation (NULL : ticket libre) */
+	void 			*owner;
+
+} matchTicket_t;
+/**
+ * @brief      tas binaire minimal de tickets, ordonné par ordre d'arrivée
+ */
+typedef struct {
+
+	/** indices des tickets */
+	int 			*items;
+	/** nombre de tickets dans le tas */
+	int 			amount;
+	/** taille allouée de items */
+	int 			size;
+
+} matchHeap_t;
+/**
+ * @brief      file d'attente de mise en relation : un tas par rôle et par tranche
+ *
+ * @note       à n'utiliser que depuis un seul thread
+ */
+typedef struct {
+
+	/** tickets */
+	matchTicket_t 	*tickets;
+	/** nombre de tickets */
+	int 			capacity;
+	/** premier ticket libre (-1 : aucun) */
+	int 			freeList;
+	/** tas des clients en attente, indexés par rôle puis tranche */
+	matchHeap_t 	heaps[2][MATCH_BUCKETS + 1];
+	/** prochain ordre d'arrivée */
+	uint32_t 		seq;
+
+} matchmaker_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une file d'attente de mise en relation
+ *
+ * @param      matchmaker  la file à initialiser
+ * @param[in]  capacity    nombre maximum de clients en attente
+ *
+ * @note       termine le programme si les tickets ne peuvent être alloués
+ */
+void createMatchmaker(matchmaker_t *matchmaker, int capacity);
+/**
+ * @brief      Libère une file d'attente de mise en relation
+ *
+ * @param      matchmaker  la file
+ */
+void destroyMatchmaker(matchmaker_t *matchmaker);
+/**
+ * @brief      Met un client en relation avec le plus ancien client de l'autre rôle
+ *             compatible (même tranche ou indifférent), sinon le met en attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  role        rôle du client (un joueur attend un hôte et inversement)
+ * @param[in]  rating      classement du client, MATCH_ANY si indifférent
+ * @param      owner       propriétaire du ticket (non NULL)
+ * @param      ticket      ticket du client mis en attente, -1 sinon
+ *
+ * @return     le propriétaire du ticket mis en relation, NULL si le client attend
+ *             (*ticket >= 0) ou si la file est pleine (*ticket == -1)
+ *
+ * @note       O(log n) : seuls les sommets des MATCH_BUCKETS + 1 tas sont comparés
+ */
+void *requestMatch(matchmaker_t *matchmaker, userRole_t role, int rating, void *owner, int *ticket);
+/**
+ * @brief      Remet en attente un client venu d'une autre file (passation), à son
+ *             ordre d'arrivée dans celle-ci
+ *
+ * @param      matchmaker  la file
+ * @param      from        le ticket du client dans l'autre file
+ * @param      owner       propriétaire du ticket (non NULL)
+ *
+ * @return     le ticket du client, -1 si la file est pleine
+ *
+ * @note       les clients remis en attente ne sont pas mis en relation entre eux : ils
+ *             ne l'étaient pas dans l'autre file. Les demandes suivantes arrivent après.
+ */
+int adoptTicket(matchmaker_t *matchmaker, matchTicket_t *from, void *owner);
+/**
+ * @brief      Retire un client de la file d'attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  ticket      le ticket du client (-1 accepté)
+ */
+void cancelMatch(matchmaker_t *matchmaker, int ticket);
+/**
+ * @brief      Nombre de clients en attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  role        le rôle des clients à compter
+ *
+ * @return     le nombre de clients de ce rôle en attente
+ */
+int waitingAmount(matchmaker_t *matchmaker, userRole_t role);
+
+#endif /* MATCHMAKING_H */
@@ -0,0 +1,151 @@
+/**
+ *	\file		nameindex.h
+ *	\brief		Fichier en-tête de l'index des clients par nom et de la recherche par préfixe
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief critère de filtre indifférent (rôle ou statut)
+ */
+#define FILTER_ANY 			-1
+/**
+ * @brief format d'un filtre : rôle,statut,préfixe,clients sautés (préfixe vide : tous)
+ */
+#define FILTER_OUT 			"%d,%d,%s,%d"
+/**
+ * @brief format de lecture du début d'un filtre (rôle,statut,), le reste est découpé
+ */
+#define FILTER_IN 			"%d,%d,%n"
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      filtre d'une liste de clients
+ */
+typedef struct {
+
+	/** début du nom (vide : tous) */
+	char 	prefix[PSEUDO_SIZE];
+	/** rôle, FILTER_ANY si indifférent */
+	int 	role;
+	/** statut, FILTER_ANY : connectés ou en attente de reconnexion */
+	int 	status;
+	/** nombre de clients satisfaisant le filtre à sauter (pagination) */
+	int 	skip;
+
+} hostFilter_t;
+/**
+ * @brief      entrées d'un registre triées par nom (puis par position)
+ *
+ * @note       seules les entrées connectées ou en attente de reconnexion sont
+ *             indexées : insertion et retrait par recherche dichotomique et décalage
+ */
+typedef struct {
+
+	/** registre indexé */
+	clientInfo_t 	*clients;
+	/** entrées indexées, triées */
+	int 			*ids;
+	/** nombre d'entrées indexées */
+	int 			amount;
+	/** l'entrée i est-elle indexée (sous le nom qu'elle avait alors) */
+	char 			*indexed;
+	/** taille du registre */
+	int 			capacity;
+
+} nameIndex_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée un index vide sur un registre
+ *
+ * @param      index     l'index à initialiser
+ * @param      clients   le registre
+ * @param[in]  capacity  taille du registre
+ *
+ * @note       termine le programme si l'index ne peut être alloué
+ */
+void createNameIndex(nameIndex_t *index, clientInfo_t *clients, int capacity);
+/**
+ * @brief      Libère un index
+ *
+ * @param      index  l'index
+ */
+void destroyNameIndex(nameIndex_t *index);
+/**
+ * @brief      Indexe une entrée du registre sous son nom actuel
+ *
+ * @param      index  l'index
+ * @param[in]  id     l'entrée (déjà indexée : réindexée)
+ */
+void indexClient(nameIndex_t *index, int id);
+/**
+ * @brief      Retire une entrée de l'index, avant que son nom ne change
+ *
+ * @param      index  l'index
+ * @param[in]  id     l'entrée (non indexée : sans effet)
+ */
+void unindexClient(nameIndex_t *index, int id);
+/**
+ * @brief      Reconstruit l'index à partir des entrées connectées ou en attente
+ *
+ * @param      index  l'index
+ */
+void rebuildNameIndex(nameIndex_t *index);
+/**
+ * @brief      Un client satisfait-il un filtre
+ *
+ * @param      client  le client
+ * @param      filter  le filtre
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int matchesFilter(clientInfo_t *client, hostFilter_t *filter);
+/**
+ * @brief      Liste par ordre de nom les entrées indexées satisfaisant un filtre
+ *
+ * @param      index   l'index
+ * @param      filter  le filtre
+ * @param      ids     les entrées trouvées
+ * @param[in]  max     taille de ids
+ *
+ * @return     le nombre d'entrées trouvées
+ *
+ * @note       O(log n) jusqu'au premier nom du préfixe, puis seulement les noms
+ *             qui le partagent sont parcourus. filter->skip est diminué des entrées
+ *             sautées : il reste à sauter parmi les clients listés ensuite.
+ */
+int filterClients(nameIndex_t *index, hostFilter_t *filter, int *ids, int max);
+/**
+ * @brief      sérialise un filtre
+ *
+ * @param      filter  le filtre
+ * @param      str     le buffer sérialisé
+ */
+void hostFilter2str(hostFilter_t *filter, char *str);
+/**
+ * @brief      désérialise un filtre
+ *
+ * @param      str     le buffer sérialisé (vide : hôtes connectés ou en attente)
+ * @param      filter  le filtre
+ *
+ * @return     1 si le filtre est bien formé, 0 sinon
+ */
+int str2hostFilter(char *str, hostFilter_t *filter);
+
+#endif /* NAMEINDEX_H */
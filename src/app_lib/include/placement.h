@@ -0,0 +1,128 @@
+/**
+ *	\file		placement.h
+ *	\brief		Fichier en-tête de la génération et de la validation des flottes
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include "game.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      règle de placement : les navires peuvent se toucher
+ */
+#define PLACE_ALLOW_TOUCH 	0
+/**
+ * @brief      règle de placement : aucun navire n'en touche un autre, diagonales comprises
+ */
+#define PLACE_NO_TOUCH 		1
+/**
+ * @brief      nombre maximum de placements d'un navire (deux orientations par case)
+ */
+#define MAX_PLACEMENTS 		(2 * BOARD_CELLS)
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      flotte complète, prête à être placée dans une partie
+ */
+typedef struct {
+
+	/** cases de chaque navire */
+	bitboard_t 		ships[FLEET_SIZE];
+	/** réunion des navires */
+	bitboard_t 		cells;
+	/** case de la proue de chaque navire */
+	unsigned char 	bows[FLEET_SIZE];
+	/** orientation de chaque navire (1 : vers le bas) */
+	unsigned char 	vertical[FLEET_SIZE];
+
+} fleet_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Générateur xorshift64* : rapide, suffisant pour tirer des flottes et
+ *             les tirs des bots
+ *
+ * @param      seed  état du générateur (non nul), avancé
+ *
+ * @return     le nombre tiré
+ */
+uint64_t nextRandom(uint64_t *seed);
+/**
+ * @brief      Nombre de placements d'un navire dans une grille vide
+ *
+ * @param[in]  ship  indice du navire dans la flotte
+ *
+ * @return     le nombre de placements
+ */
+int placementCount(int ship);
+/**
+ * @brief      Cases d'un placement, lues dans les masques précalculés
+ *
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     les cases, 0 si le navire sort de la grille
+ */
+bitboard_t placementCells(int ship, int cell, int vertical);
+/**
+ * @brief      Un navire peut-il être ajouté à une flotte (temps constant)
+ *
+ * @param[in]  fleet     les cases des navires déjà placés
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ * @param[in]  rules     PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int canPlaceShip(bitboard_t fleet, int ship, int cell, int vertical, int rules);
+/**
+ * @brief      Une grille porte-t-elle une flotte complète et légale
+ *
+ * @param      board  la grille (ships et fleet)
+ * @param[in]  rules  PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ *
+ * @return     1 si oui, 0 sinon
+ *
+ * @note       une vérification en temps constant par navire, quelle que soit la
+ *             provenance des masques (saisie de l'utilisateur, réseau)
+ */
+int validateBoard(board_t *board, int rules);
+/**
+ * @brief      Tire une flotte légale uniformément parmi toutes les flottes légales
+ *
+ * @param      fleet  la flotte tirée
+ * @param[in]  rules  PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ * @param      seed   état du générateur (xorshift64*, non nul), avancé
+ *
+ * @note       chaque navire est tiré parmi ses placements précalculés ; un
+ *             chevauchement relance toute la flotte, ce qui garde l'uniformité
+ */
+void randomFleet(fleet_t *fleet, int rules, uint64_t *seed);
+/**
+ * @brief      Place une flotte dans une partie (journalisée comme des placements)
+ *
+ * @param      match   la partie
+ * @param[in]  player  le joueur
+ * @param      fleet   la flotte
+ *
+ * @return     0, -1 si un navire ne peut être placé
+ */
+int applyFleet(match_t *match, int player, fleet_t *fleet);
+
+#endif /* PLACEMENT_H */
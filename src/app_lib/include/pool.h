@@ -0,0 +1,80 @@
+/**
+ *	\file		pool.h
+ *	\brief		Fichier en-tête représentant les réserves d'objets de taille fixe
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef POOL_H
+#define POOL_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stddef.h>
+#include <pthread.h>
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      réserve de `capacity` objets de même taille, allouée en un seul bloc.
+ * 
+ * @note       les objets libres sont chaînés entre eux (pile), l'allocation et la
+ * 			   libération sont donc en temps constant et ne passent jamais par malloc.
+ */
+typedef struct {
+
+	/** bloc contenant tous les objets */
+	char 			*objects;
+	/** taille d'un objet (arrondie à l'alignement maximal) */
+	size_t 			objSize;
+	/** nombre d'objets de la réserve */
+	int 			capacity;
+	/** sommet de la pile des objets libres */
+	void 			*freeList;
+	/** nombre d'objets libres */
+	int 			freeAmount;
+	/** verrou protégeant la pile des objets libres */
+	pthread_mutex_t lock;
+
+} pool_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une réserve d'objets
+ *
+ * @param      pool      la réserve à initialiser
+ * @param[in]  objSize   taille d'un objet
+ * @param[in]  capacity  nombre d'objets
+ * 
+ * @note       termine le programme si le bloc ne peut être alloué
+ */
+void createPool(pool_t *pool, size_t objSize, int capacity);
+/**
+ * @brief      Libère le bloc d'une réserve
+ *
+ * @param      pool  la réserve
+ * 
+ * @note       les objets encore empruntés deviennent invalides
+ */
+void destroyPool(pool_t *pool);
+/**
+ * @brief      Emprunte un objet à la réserve
+ *
+ * @param      pool  la réserve
+ *
+ * @return     un objet (contenu indéterminé), NULL si la réserve est épuisée
+ */
+void *poolAlloc(pool_t *pool);
+/**
+ * @brief      Rend un objet à la réserve
+ *
+ * @param      pool  la réserve dont provient l'objet
+ * @param      obj   l'objet (NULL accepté)
+ */
+void poolFree(pool_t *pool, void *obj);
+
+#endif /* POOL_H */
@@ -8,6 +8,46 @@
 #ifndef PROTOCOL_H
 #define PROTOCOL_H
 /*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief nombre de verbes du protocole
+ */
+#define VERB_AMOUNT 		(DELETE + 1)
+/**
+ * @brief nombre d'actions du protocole
+ */
+#define ACTION_AMOUNT 		(HELLO + 1)
+/**
+ * @brief version du protocole (1 : client ou serveur ne négociant pas)
+ */
+#define PROTOCOL_VERSION 	2
+/**
+ * @brief plusieurs requêtes peuvent partir sans attendre les réponses
+ */
+#define CAP_PIPELINE 		0x01
+/**
+ * @brief réponses non sollicitées (mise en relation, événements de partie)
+ */
+#define CAP_PUSH 			0x02
+/**
+ * @brief codec binaire à la place du texte "%i:%hhu:%s"
+ */
+#define CAP_BINARY 			0x04
+/**
+ * @brief données compressées
+ */
+#define CAP_COMPRESS 		0x08
+/**
+ * @brief trames préfixées par leur taille à la place du \0 final
+ */
+#define CAP_LENGTH_FRAMING 	0x10
+/**
+ * @brief format d'une négociation : version,capacités (hexadécimal)
+ */
+#define HELLO_FMT 			"%hhu,%x"
+/*
 *****************************************************************************************
  *	\noop		S T R C T U R E S   DE   D O N N E E S
  */
@@ -18,11 +58,22 @@ typedef enum {GET, POST, DELETE} verb_t;
 /**
  * @brief enum contenant les intervalles de status du protocole
  */
-typedef enum {REQ, ACK, ERR} statusRange_t;
+typedef enum {RANGE_UNKNOWN = -1, REQ, ACK, ERR} statusRange_t;
 /**
  * @brief enum contenant les actions du protocole
  */
-typedef enum {CONNECT, CELL, GAME, CURRENT_PLAYER} action_t;
+typedef enum {ACTION_UNKNOWN = -1, CONNECT, CELL, GAME, CURRENT_PLAYER, MATCH, SPECTATE, HELLO} action_t;
+/**
+ * @brief version et capacités (CAP_*) proposées ou convenues lors d'une négociation
+ */
+typedef struct {
+
+	/** version du protocole */
+	unsigned char 	version;
+	/** capacités */
+	unsigned int 	caps;
+
+} hello_t;
 /*
 *****************************************************************************************
  *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
@@ -41,7 +92,8 @@ short enum2status(statusRange_t type, action_t action);
  *
  * @param[in]  code  le status
  *
- * @return     le statusRange_t correspondant à l'intervalle de status du code
+ * @return     le statusRange_t correspondant à l'intervalle de status du code,
+ *             RANGE_UNKNOWN si le code n'appartient à aucun intervalle
  */
 statusRange_t getStatusRange(short code);
 /**
@@ -49,8 +101,32 @@ statusRange_t getStatusRange(short code);
  *
  * @param[in]  code     code de status
  *
- * @return     l'action_t représentée par le code
+ * @return     l'action_t représentée par le code, ACTION_UNKNOWN si aucune
  */
 action_t getAction(short code);
+/**
+ * @brief      sérialise une négociation
+ *
+ * @param      hello  la version et les capacités
+ * @param      str    le buffer sérialisé
+ */
+void hello2str(hello_t *hello, char *str);
+/**
+ * @brief      désérialise une négociation
+ *
+ * @param      str    le buffer sérialisé
+ * @param      hello  la version et les capacités
+ *
+ * @return     1 si la négociation est bien formée, 0 sinon
+ */
+int str2hello(char *str, hello_t *hello);
+/**
+ * @brief      convient d'une version et de capacités communes
+ *
+ * @param      offer      ce que propose l'autre partie
+ * @param      supported  ce que l'on sait faire
+ * @param      agreed     la plus petite version et les capacités communes
+ */
+void negotiateHello(hello_t *offer, hello_t *supported, hello_t *agreed);
 
 #endif /* PROTOCOL_H */
\ No newline at end of file
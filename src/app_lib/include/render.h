@@ -0,0 +1,114 @@
+/**
+ *	\file		render.h
+ *	\brief		Fichier en-tête de l'affichage des grilles par différences (double tampon)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef RENDER_H
+#define RENDER_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "game.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      taille du tampon d'une image (un seul write par image)
+ */
+#define RENDER_FRAME_SIZE 	4096
+/**
+ * @brief      taille de la ligne d'état sous les grilles
+ */
+#define RENDER_STATUS_SIZE 	80
+/**
+ * @brief      ligne (à partir de 1) de la première rangée des grilles
+ */
+#define RENDER_TOP 			3
+/**
+ * @brief      colonne (à partir de 1) de la première case de chaque grille
+ */
+#define RENDER_LEFT_0 		5
+#define RENDER_LEFT_1 		26
+/**
+ * @brief      ligne de la ligne d'état
+ */
+#define RENDER_STATUS_ROW 	(RENDER_TOP + BOARD_SIZE + 1)
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      écran d'une partie : ce qui est affiché (front) et ce qui doit l'être (back)
+ *
+ * @note       seules les cases qui diffèrent sont envoyées, avec un déplacement du
+ *             curseur quand elles ne se suivent pas
+ */
+typedef struct {
+
+	/** cases affichées, par grille */
+	char 	front[2][BOARD_CELLS];
+	/** cases à afficher, par grille */
+	char 	back[2][BOARD_CELLS];
+	/** ligne d'état affichée */
+	char 	frontStatus[RENDER_STATUS_SIZE];
+	/** ligne d'état à afficher */
+	char 	backStatus[RENDER_STATUS_SIZE];
+	/** l'écran correspond-il à front (sinon : image complète) */
+	int 	valid;
+	/** position du curseur après la dernière image (0 : inconnue) */
+	int 	row, col;
+	/** descripteur du terminal */
+	int 	fd;
+	/** image en construction */
+	char 	frame[RENDER_FRAME_SIZE];
+	/** taille de l'image en construction */
+	int 	length;
+
+} renderer_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Caractère d'une case : '#' navire intact, 'X' touché, 'o' tir dans l'eau
+ *
+ * @param      board  la grille
+ * @param[in]  cell   la case
+ *
+ * @return     le caractère
+ */
+char boardCellChar(board_t *board, int cell);
+/**
+ * @brief      Crée un écran, la première image sera complète
+ *
+ * @param      renderer  l'écran à initialiser
+ * @param[in]  fd        descripteur du terminal
+ */
+void createRenderer(renderer_t *renderer, int fd);
+/**
+ * @brief      Force une image complète, quand le terminal a été écrit par ailleurs
+ *
+ * @param      renderer  l'écran
+ */
+void invalidateRenderer(renderer_t *renderer);
+/**
+ * @brief      Dessine une partie dans le tampon arrière
+ *
+ * @param      renderer  l'écran
+ * @param      match     la partie
+ */
+void drawMatch(renderer_t *renderer, match_t *match);
+/**
+ * @brief      Envoie les différences entre les tampons en un seul write, puis les échange
+ *
+ * @param      renderer  l'écran
+ *
+ * @return     le nombre d'octets écrits, -1 en cas d'erreur
+ */
+int presentFrame(renderer_t *renderer);
+
+#endif /* RENDER_H */
@@ -95,20 +95,51 @@ void sendRequest(socket_t *sockAppel, int status, uint8_t verb, generic data, pF
  * @param[in]  serial    la fonction de sérialisation des données (NULL si char *)
  */
 void sendResponse(socket_t *sockDial, int status, generic data, pFct serial);
+/**
+ * @brief      Empiler une réponse dans le buffer d'émission de la socket
+ *
+ * @param      sockDial  la socket de dialogue
+ * @param[in]  status    le status de la réponse
+ * @param[in]  data      les données de la réponse
+ * @param[in]  serial    la fonction de sérialisation des données (NULL si char *)
+ *
+ * @note       La réponse part au prochain flushResponses/sendResponse : plusieurs
+ *             réponses empilées partent en un seul appel système
+ */
+void queueResponse(socket_t *sockDial, int status, generic data, pFct serial);
+/**
+ * @brief      Émettre en un seul appel système les réponses empilées
+ *
+ * @param      sockDial  la socket de dialogue
+ */
+void flushResponses(socket_t *sockDial);
 /**
  * @brief      Recevoir une requête
  *
  * @param      sockDial  socket de dialogue
  * @param      request   pointeur vers la struct request à remplir
+ *
+ * @return     0 si la connexion a été fermée, 1 sinon
+ */
+int rcvRequest(socket_t *sockDial, req_t *request);
+/**
+ * @brief      Extraire une requête déjà reçue par le moteur d'E/S, sans lecture
+ *
+ * @param      sockDial  socket de dialogue
+ * @param      request   pointeur vers la struct request à remplir
+ *
+ * @return     1 si une requête complète a été extraite, 0 sinon
  */
-void rcvRequest(socket_t *sockDial, req_t *request);
+int extractRequest(socket_t *sockDial, req_t *request);
 /**
  * @brief      Recevoir une réponse
  *
  * @param      sockAppel  la socket d'appel
  * @param      response   pointeur vers la struct rep_t à remplir
+ *
+ * @return     0 si la connexion a été fermée, 1 sinon
  */
-void rcvResponse(socket_t *sockAppel, rep_t *response);
+int rcvResponse(socket_t *sockAppel, rep_t *response);
 /**
  * \brief      fonction de sérialisation des requêtes
  *
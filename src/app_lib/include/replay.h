@@ -0,0 +1,207 @@
+/**
+ *	\file		replay.h
+ *	\brief		Fichier en-tête du journal binaire des parties et de sa relecture
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "game.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief version du format des enregistrements
+ */
+#define REPLAY_VERSION 			1
+/**
+ * @brief nombre de tirs entre deux points de reprise
+ */
+#define REPLAY_PERIOD 			16
+/**
+ * @brief nombre d'enregistrements d'un point de reprise (en-tête + 2 bitboards de 16 octets)
+ */
+#define REPLAY_CHECKPOINT_SIZE 	5
+/**
+ * @brief nombre d'enregistrements précédant le premier tir (début + placements)
+ */
+#define REPLAY_HEADER 			(1 + 2 * FLEET_SIZE)
+/**
+ * @brief nombre d'enregistrements gardés avant écriture
+ */
+#define REPLAY_BUFFER 			(REPLAY_PERIOD + REPLAY_CHECKPOINT_SIZE + REPLAY_HEADER + 1)
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      nature d'un enregistrement
+ */
+typedef enum {
+
+	REPLAY_START = 1, 		/**< début de partie : arg version, value identifiant 			*/
+	REPLAY_PLACE, 			/**< navire : cell proue, arg navire | vertical << 7 			*/
+	REPLAY_SHOT, 			/**< tir : cell visée, arg résultat, value numéro du tir 		*/
+	REPLAY_CHECKPOINT, 		/**< point de reprise : player au trait, value tirs joués, 		*/
+							/**< suivi des tirs subis par chaque joueur en données brutes 	*/
+	REPLAY_END 				/**< fin : player vainqueur (0xFF : abandon), value tirs joués 	*/
+
+} replayType_t;
+/**
+ * @brief      enregistrement de taille fixe (ordre des octets de la machine)
+ *
+ * @note       une partie s'écrit START, FLEET_SIZE placements par joueur, puis les tirs
+ *             avec un point de reprise avant chaque tir multiple de REPLAY_PERIOD
+ *             (sauf le premier) et enfin END : la position d'un tir se calcule
+ */
+typedef struct {
+
+	/** nature (replayType_t) */
+	uint8_t 		type;
+	/** joueur concerné */
+	uint8_t 		player;
+	/** case concernée */
+	uint8_t 		cell;
+	/** argument selon la nature */
+	uint8_t 		arg;
+	/** valeur selon la nature */
+	uint32_t 		value;
+
+} replayRecord_t;
+/**
+ * @brief      journal d'écriture, en ajout seul
+ *
+ * @note       une seule partie à la fois par fichier : les parties se suivent
+ */
+typedef struct replayLog {
+
+	/** descripteur du fichier (O_APPEND) */
+	int 			fd;
+	/** enregistrements pas encore écrits */
+	replayRecord_t 	pending[REPLAY_BUFFER];
+	/** nombre d'enregistrements en attente */
+	int 			amount;
+
+} replayLog_t;
+/**
+ * @brief      fichier de parties ouvert en lecture (projeté en mémoire)
+ */
+typedef struct {
+
+	/** enregistrements */
+	const replayRecord_t 	*records;
+	/** nombre d'enregistrements */
+	size_t 					amount;
+
+} replayFile_t;
+/**
+ * @brief      partie trouvée dans un fichier
+ */
+typedef struct {
+
+	/** premier enregistrement (START) */
+	const replayRecord_t 	*start;
+	/** nombre d'enregistrements de la partie */
+	size_t 					length;
+	/** identifiant de la partie */
+	uint32_t 				id;
+	/** nombre de tirs enregistrés */
+	uint32_t 				turns;
+	/** vainqueur, NO_WINNER si la partie n'est pas terminée ou abandonnée */
+	int 					winner;
+
+} replayGame_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ouvre un journal en ajout
+ *
+ * @param      log   le journal
+ * @param      path  chemin du fichier (créé au besoin)
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openReplayLog(replayLog_t *log, const char *path);
+/**
+ * @brief      Écrit les enregistrements en attente et ferme le journal
+ *
+ * @param      log   le journal
+ */
+void closeReplayLog(replayLog_t *log);
+/**
+ * @brief      Commence une partie dans le journal
+ *
+ * @param      log   le journal
+ * @param[in]  id    identifiant de la partie
+ */
+void startReplay(replayLog_t *log, uint32_t id);
+/**
+ * @brief      Journalise le placement d'un navire
+ */
+void logPlacement(replayLog_t *log, int player, int ship, int cell, int vertical);
+/**
+ * @brief      Journalise un tir valide, précédé d'un point de reprise si besoin
+ *
+ * @param      log     le journal
+ * @param      match   la partie, avant le tir
+ * @param[in]  player  le tireur
+ * @param[in]  cell    la case visée
+ * @param[in]  result  le résultat du tir
+ */
+void logShot(replayLog_t *log, match_t *match, int player, int cell, shotResult_t result);
+/**
+ * @brief      Termine la partie dans le journal et l'écrit
+ *
+ * @param      log     le journal
+ * @param      match   la partie (winner NO_WINNER : abandon)
+ */
+void endReplay(replayLog_t *log, match_t *match);
+/**
+ * @brief      Ouvre un fichier de parties en lecture
+ *
+ * @param      file  le fichier
+ * @param      path  son chemin
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openReplay(replayFile_t *file, const char *path);
+/**
+ * @brief      Ferme un fichier de parties
+ *
+ * @param      file  le fichier
+ */
+void closeReplay(replayFile_t *file);
+/**
+ * @brief      Trouve la partie suivante d'un fichier
+ *
+ * @param      file  le fichier
+ * @param      pos   position de la recherche, avancée après la partie trouvée
+ * @param      game  la partie trouvée
+ *
+ * @return     1 si une partie a été trouvée, 0 à la fin du fichier
+ *
+ * @note       saute d'un point de reprise à l'autre sans lire les tirs
+ */
+int nextReplayGame(replayFile_t *file, size_t *pos, replayGame_t *game);
+/**
+ * @brief      Reconstruit une partie après un nombre de tirs donné
+ *
+ * @param      game   la partie
+ * @param[in]  turn   nombre de tirs à rejouer (borné à game->turns)
+ * @param      match  la partie reconstruite (sans journal)
+ *
+ * @note       part du point de reprise précédent : au plus REPLAY_PERIOD - 1 tirs rejoués
+ */
+void replayMatchAt(replayGame_t *game, uint32_t turn, match_t *match);
+
+#endif /* REPLAY_H */
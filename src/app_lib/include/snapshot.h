@@ -0,0 +1,138 @@
+/**
+ *	\file		snapshot.h
+ *	\brief		Fichier en-tête représentant les instantanés du registre des clients
+ *				(fichier projeté en mémoire : en-tête puis enregistrements de taille fixe)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include "datastructs.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief signature d'un fichier d'instantané ("BSRG")
+ */
+#define SNAPSHOT_MAGIC 		0x42535247
+/**
+ * @brief version du format d'instantané
+ */
+#define SNAPSHOT_VERSION 	2
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      en-tête d'un fichier d'instantané
+ */
+typedef struct {
+
+	/** signature SNAPSHOT_MAGIC */
+	uint32_t 	magic;
+	/** version du format */
+	uint16_t 	version;
+	/** taille d'un enregistrement */
+	uint16_t 	recordSize;
+	/** nombre d'enregistrements */
+	uint32_t 	capacity;
+	/** génération, impaire pendant une écriture (instantané incohérent) */
+	uint32_t 	generation;
+	/** date de la dernière écriture */
+	int64_t 	savedAt;
+
+} snapshotHeader_t;
+/**
+ * @brief      enregistrement d'un client (même indice que dans le registre)
+ */
+typedef struct {
+
+	/** nom d'utilisateur */
+	char 		name[PSEUDO_SIZE];
+	/** userStatus_t */
+	uint8_t 	status;
+	/** userRole_t */
+	uint8_t 	role;
+	/** port (s'il est hôte) */
+	int16_t 	port;
+	/** adresse LAN */
+	char 		address[ADDR_SIZE];
+	/** adresse d'où le client s'est enregistré */
+	char 		peer[ADDR_SIZE];
+
+} snapshotRecord_t;
+/**
+ * @brief      instantané ouvert et projeté en mémoire
+ */
+typedef struct {
+
+	/** descripteur du fichier */
+	int 				fd;
+	/** en-tête projeté, NULL si aucun instantané n'est ouvert */
+	snapshotHeader_t 	*header;
+	/** enregistrements projetés, à la suite de l'en-tête */
+	snapshotRecord_t 	*records;
+	/** taille de la projection */
+	size_t 				size;
+	/** nombre d'enregistrements projetés */
+	int 				capacity;
+
+} registrySnapshot_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ouvre (ou crée) un fichier d'instantané et le projette en mémoire
+ *
+ * @param      snap      l'instantané à initialiser
+ * @param      path      chemin du fichier
+ * @param[in]  capacity  taille du registre
+ * @param[in]  wait      attendre qu'une autre instance le libère plutôt qu'échouer
+ *
+ * @return     0 en cas de succès, -1 sinon (errno positionné, EWOULDBLOCK si une
+ *             autre instance le tient)
+ *
+ * @note       le fichier est verrouillé jusqu'à closeSnapshot : deux serveurs ne
+ *             peuvent écrire le même instantané
+ */
+int openSnapshot(registrySnapshot_t *snap, char *path, int capacity, int wait);
+/**
+ * @brief      Restaure un registre depuis un instantané
+ *
+ * @param      snap     l'instantané ouvert
+ * @param      clients  le registre à remplir
+ * @param[in]  size     taille du registre
+ *
+ * @return     le nombre de clients restaurés
+ * 
+ * @note       les clients restaurés sont PENDING : ils attendent la reconnexion de
+ * 			   leur propriétaire. Un instantané absent, d'un autre format ou
+ * 			   interrompu en cours d'écriture ne restaure rien.
+ */
+int loadSnapshot(registrySnapshot_t *snap, clientInfo_t *clients, int size);
+/**
+ * @brief      Écrit le registre dans l'instantané
+ *
+ * @param      snap     l'instantané ouvert
+ * @param      clients  le registre
+ * @param[in]  size     taille du registre
+ * 
+ * @note       sans effet si aucun instantané n'est ouvert
+ */
+void saveSnapshot(registrySnapshot_t *snap, clientInfo_t *clients, int size);
+/**
+ * @brief      Ferme un instantané (la projection est écrite sur le disque)
+ *
+ * @param      snap  l'instantané
+ */
+void closeSnapshot(registrySnapshot_t *snap);
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,243 @@
+/**
+ *	\file		spectate.h
+ *	\brief		Fichier en-tête du relais des parties en cours vers leurs spectateurs
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef SPECTATE_H
+#define SPECTATE_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+#include "data.h"
+#include "datastructs.h"
+#include "gameflow.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief nombre d'événements gardés par partie
+ */
+#define SPECTATE_RING 			256
+/**
+ * @brief retard (en événements) au-delà duquel un spectateur saute au dernier instantané
+ */
+#define SPECTATE_LAG 			64
+/**
+ * @brief nombre maximum d'événements émis vers un spectateur en un appel système
+ */
+#define SPECTATE_IOV 			16
+/**
+ * @brief instantané publié quand le joueur au trait laisse passer son échéance
+ */
+#define FORFEIT_FMT 			"Forfait de %s : délai dépassé."
+/**
+ * @brief instantané publié quand une partie reste bloquée avant le premier coup
+ */
+#define STALLED_FMT 			"Partie abandonnée en %s : délai dépassé."
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      événement d'une partie, encodé une seule fois en réponse ("%i:%s\0")
+ *             et partagé par tous les spectateurs
+ */
+typedef struct {
+
+	/** nombre de références (anneau, dernier instantané, émissions entamées) */
+	int 			refs;
+	/** numéro de l'événement dans la partie */
+	uint32_t 		seq;
+	/** taille de la réponse encodée, \0 compris */
+	int 			len;
+	/** réponse encodée */
+	char 			data[];
+
+} spectateEvent_t;
+/**
+ * @brief      abonnement d'un spectateur à une partie
+ */
+typedef struct spectateSub {
+
+	/** partie suivie */
+	struct spectateGame 	*game;
+	/** socket du spectateur (ses propres réponses partent entre deux événements) */
+	socket_t 				*sock;
+	/** propriétaire de l'abonnement */
+	void 					*owner;
+	/** prochain événement à émettre */
+	uint32_t 				cursor;
+	/** événement dont l'émission est entamée (référencé), NULL sinon */
+	spectateEvent_t 		*partial;
+	/** octets de partial déjà émis */
+	int 					offset;
+	/** abonnements de la partie (chaînage double) */
+	struct spectateSub 		*prev, *next;
+
+} spectateSub_t;
+/**
+ * @brief      partie en cours, identifiée par le nom de son hôte
+ */
+typedef struct spectateGame {
+
+	/** nom de l'hôte */
+	char 					host[PSEUDO_SIZE];
+	/** derniers événements, ring[seq % SPECTATE_RING] */
+	spectateEvent_t 		*ring[SPECTATE_RING];
+	/** nombre d'événements publiés (numéro du prochain) */
+	uint32_t 				published;
+	/** dernier instantané publié (NULL : aucun) */
+	spectateEvent_t 		*snapshot;
+	/** abonnements */
+	spectateSub_t 			*subs;
+	/** nombre d'abonnements */
+	int 					subAmount;
+	/** cycle de vie, suivi d'après les événements publiés */
+	gameFlow_t 				flow;
+	/** relais de la partie */
+	struct spectateRelay 	*relay;
+	/** parties du relais (chaînage double) */
+	struct spectateGame 	*prev, *next;
+
+} spectateGame_t;
+/**
+ * @brief      relais des parties en cours
+ *
+ * @note       à n'utiliser que depuis un seul thread
+ */
+typedef struct spectateRelay {
+
+	/** parties en cours */
+	spectateGame_t 	*games;
+	/** action appelée quand un abonnement est terminé par le relais (fin de partie) */
+	void 			(*onEnded)(void *owner);
+	/** échéances des parties */
+	timerWheel_t 	wheel;
+
+} spectateRelay_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Prépare un relais sans partie
+ *
+ * @param      relay    le relais
+ * @param[in]  onEnded  action appelée pour chaque abonnement terminé par une fin de
+ *                      partie, une fois l'abonnement libéré
+ */
+void createRelay(spectateRelay_t *relay, void (*onEnded)(void *owner));
+/**
+ * @brief      Publie un événement d'une partie (créée au premier événement) et
+ *             l'émet vers ses spectateurs
+ *
+ * @param      relay   le relais
+ * @param      host    nom de l'hôte de la partie
+ * @param[in]  status  code de la réponse émise aux spectateurs (GAME : instantané)
+ * @param      data    données de la réponse
+ *
+ * @return     0, -1 si l'événement est refusé par le cycle de vie de la partie ou
+ *             n'a pu être alloué
+ *
+ * @note       les spectateurs ne ralentissent jamais la partie : celui qui ne suit
+ *             pas saute au dernier instantané. Un tir (CELL) n'est permis qu'après
+ *             le premier changement de joueur (CURRENT_PLAYER).
+ */
+int publishEvent(spectateRelay_t *relay, char *host, short status, char *data);
+/**
+ * @brief      Termine une partie et tous ses abonnements
+ *
+ * @param      relay  le relais
+ * @param      host   nom de l'hôte de la partie
+ * @param[in]  why    FLOW_END (fin par l'hôte) ou FLOW_LEAVE (départ de l'hôte)
+ *
+ * @note       le reste d'un événement entamé est recopié dans le buffer d'émission
+ *             de chaque spectateur avant l'appel de onEnded
+ */
+void endGame(spectateRelay_t *relay, char *host, flowEvent_t why);
+/**
+ * @brief      Reprend une partie d'une autre instance (passation), sans événement
+ *
+ * @param      relay      le relais
+ * @param      host       nom de l'hôte de la partie
+ * @param[in]  state      état de la partie
+ * @param      owner      joueur au trait (vide : aucun)
+ * @param[in]  moves      nombre de coups joués
+ * @param[in]  published  nombre d'événements publiés
+ *
+ * @return     la partie, NULL si elle n'a pu être allouée
+ *
+ * @note       ses derniers événements sont ensuite repris par adoptEvent
+ */
+spectateGame_t *adoptGame(spectateRelay_t *relay, char *host, gameState_t state, char *owner, unsigned moves, uint32_t published);
+/**
+ * @brief      Reprend un des derniers événements d'une partie reprise
+ *
+ * @param      game      la partie (adoptGame)
+ * @param[in]  seq       numéro de l'événement
+ * @param      encoded   réponse encodée
+ * @param[in]  len       taille de la réponse encodée, \0 compris
+ * @param[in]  snapshot  1 si c'est le dernier instantané de la partie
+ *
+ * @return     0, -1 si l'événement n'a pu être alloué
+ *
+ * @note       un événement sorti de l'anneau n'est gardé que s'il est l'instantané
+ */
+int adoptEvent(spectateGame_t *game, uint32_t seq, char *encoded, int len, int snapshot);
+/**
+ * @brief      Abonne un spectateur à une partie en cours
+ *
+ * @param      relay  le relais
+ * @param      host   nom de l'hôte de la partie
+ * @param      sock   socket du spectateur
+ * @param      owner  propriétaire de l'abonnement
+ *
+ * @return     l'abonnement, NULL si la partie n'existe pas
+ *
+ * @note       le spectateur reçoit le dernier instantané puis les événements suivants
+ */
+spectateSub_t *subscribeGame(spectateRelay_t *relay, char *host, socket_t *sock, void *owner);
+/**
+ * @brief      Résilie un abonnement
+ *
+ * @param      sub   l'abonnement (libéré)
+ *
+ * @note       le reste d'un événement entamé est recopié devant le buffer d'émission
+ */
+void unsubscribeGame(spectateSub_t *sub);
+/**
+ * @brief      Émet sans bloquer vers un spectateur ses réponses puis les événements
+ *             qu'il n'a pas encore reçus
+ *
+ * @param      sub   l'abonnement
+ *
+ * @return     1 s'il reste des données à émettre, 0 sinon
+ */
+int flushSubscriber(spectateSub_t *sub);
+/**
+ * @brief      Reprend l'émission vers les spectateurs en retard
+ *
+ * @param      relay  le relais
+ *
+ * @return     1 si des spectateurs restent en retard, 0 sinon
+ */
+int flushRelay(spectateRelay_t *relay);
+/**
+ * @brief      Termine les parties dont l'échéance est dépassée
+ *
+ * @param      relay  le relais
+ * @param[in]  now    l'instant présent (wheelClock)
+ *
+ * @return     le délai avant la prochaine échéance (ms), WHEEL_IDLE si aucune
+ *
+ * @note       le joueur au trait déclare forfait, une partie bloquée avant le premier
+ *             coup est abandonnée : un dernier instantané l'annonce aux spectateurs
+ */
+int expireGames(spectateRelay_t *relay, uint64_t now);
+
+#endif /* SPECTATE_H */
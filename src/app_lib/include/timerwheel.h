@@ -0,0 +1,136 @@
+/**
+ *	\file		timerwheel.h
+ *	\brief		Fichier en-tête de la roue de minuteries partagée par les parties en cours
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stdint.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      durée d'une case de la roue (ms), précision des échéances
+ */
+#define WHEEL_TICK 			100
+/**
+ * @brief      nombre de cases de la roue (une échéance plus lointaine fait plusieurs tours)
+ */
+#define WHEEL_SLOTS 		1024
+/**
+ * @brief      aucune minuterie armée
+ */
+#define WHEEL_IDLE 			-1
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      minuterie, chaînée dans la case de son échéance
+ *
+ * @note       intégrée à son propriétaire : la roue n'alloue rien
+ */
+typedef struct wheelTimer {
+
+	/** case de l'échéance (numéro absolu, pas modulo WHEEL_SLOTS) */
+	uint64_t 			expires;
+	/** armée ou non */
+	int 				armed;
+	/** action appelée à l'échéance, la minuterie déjà désarmée */
+	void 				(*onExpired)(struct wheelTimer *timer);
+	/** propriétaire de la minuterie */
+	void 				*owner;
+	/** minuteries de la même case (chaînage double) */
+	struct wheelTimer 	*prev, *next;
+
+} wheelTimer_t;
+/**
+ * @brief      roue de minuteries : armement et annulation en O(1)
+ *
+ * @note       à n'utiliser que depuis un seul thread
+ */
+typedef struct {
+
+	/** minuteries par case, slots[expires % WHEEL_SLOTS] */
+	wheelTimer_t 	*slots[WHEEL_SLOTS];
+	/** dernière case traitée */
+	uint64_t 		tick;
+	/** nombre de minuteries armées */
+	int 			armed;
+	/** prochaine minuterie à examiner dans la case en cours de traitement */
+	wheelTimer_t 	*cursor;
+
+} timerWheel_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone de la roue
+ *
+ * @return     l'instant présent (ms)
+ */
+uint64_t wheelClock();
+/**
+ * @brief      Prépare une roue sans minuterie
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ */
+void createWheel(timerWheel_t *wheel, uint64_t now);
+/**
+ * @brief      Prépare une minuterie désarmée
+ *
+ * @param      timer      la minuterie
+ * @param[in]  onExpired  action appelée à l'échéance
+ * @param      owner      propriétaire de la minuterie
+ */
+void createTimer(wheelTimer_t *timer, void (*onExpired)(wheelTimer_t *timer), void *owner);
+/**
+ * @brief      Arme (ou réarme) une minuterie
+ *
+ * @param      wheel  la roue
+ * @param      timer  la minuterie
+ * @param[in]  delay  délai avant l'échéance (ms), compté depuis le dernier advanceWheel
+ */
+void armTimer(timerWheel_t *wheel, wheelTimer_t *timer, int delay);
+/**
+ * @brief      Désarme une minuterie
+ *
+ * @param      wheel  la roue
+ * @param      timer  la minuterie (désarmée : sans effet)
+ */
+void cancelTimer(timerWheel_t *wheel, wheelTimer_t *timer);
+/**
+ * @brief      Fait tourner la roue jusqu'à un instant et appelle les minuteries échues
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ *
+ * @return     le nombre de minuteries échues
+ *
+ * @note       une action peut armer ou annuler n'importe quelle minuterie. Après une
+ *             longue attente, chaque case n'est parcourue qu'une fois.
+ */
+int advanceWheel(timerWheel_t *wheel, uint64_t now);
+/**
+ * @brief      Délai avant la prochaine case occupée, pour borner une attente
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ *
+ * @return     le délai (ms), WHEEL_IDLE si aucune minuterie n'est armée
+ *
+ * @note       la case peut ne contenir que des échéances d'un tour suivant : le
+ *             délai n'est alors qu'un minorant
+ */
+int nextTimerDelay(timerWheel_t *wheel, uint64_t now);
+
+#endif /* TIMERWHEEL_H */
@@ -0,0 +1,199 @@
+/**
+ *	\file		trace.h
+ *	\brief		Fichier en-tête de la capture binaire du trafic reçu par le serveur et de
+ *				sa relecture
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef TRACE_H
+#define TRACE_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "repReq.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief signature d'une capture ("BSTR")
+ */
+#define TRACE_MAGIC 		0x52545342
+/**
+ * @brief version du format des enregistrements
+ */
+#define TRACE_VERSION 		1
+/**
+ * @brief octets gardés avant écriture
+ */
+#define TRACE_BUFFER 		65536
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      nature d'un enregistrement
+ */
+typedef enum {
+
+	TRACE_OPEN = 1, 		/**< connexion acceptée 								*/
+	TRACE_REQUEST, 			/**< requête reçue, suivie de sa forme encodée 			*/
+	TRACE_CLOSE 			/**< connexion fermée 									*/
+
+} traceType_t;
+/**
+ * @brief      en-tête d'une capture (ordre des octets de la machine)
+ */
+typedef struct {
+
+	/** TRACE_MAGIC */
+	uint32_t 	magic;
+	/** TRACE_VERSION */
+	uint32_t 	version;
+	/** début de la capture (µs depuis l'époque) */
+	uint64_t 	start;
+
+} traceHeader_t;
+/**
+ * @brief      enregistrement, suivi de length octets (requête encodée, sans \0)
+ *
+ * @note       les enregistrements se suivent sans alignement
+ */
+typedef struct {
+
+	/** temps écoulé depuis l'enregistrement précédent (µs, saturé) */
+	uint32_t 	delay;
+	/** numéro de la connexion, unique dans la capture */
+	uint32_t 	conn;
+	/** durée du traitement de la requête (µs, saturée) */
+	uint32_t 	service;
+	/** nature (traceType_t) */
+	uint8_t 	type;
+	/** taille de la requête encodée */
+	uint8_t 	length;
+	/** réponses empilées pendant le traitement (une liste en compte plusieurs) */
+	uint16_t 	responses;
+
+} traceRecord_t;
+/**
+ * @brief      capture en écriture
+ *
+ * @note       à n'utiliser que depuis un seul thread
+ */
+typedef struct {
+
+	/** descripteur du fichier, -1 si aucune capture */
+	int 		fd;
+	/** octets pas encore écrits */
+	char 		pending[TRACE_BUFFER];
+	/** nombre d'octets en attente */
+	int 		amount;
+	/** instant du dernier enregistrement (µs, horloge monotone) */
+	uint64_t 	last;
+	/** numéro de la prochaine connexion */
+	uint32_t 	nextConn;
+
+} traceLog_t;
+/**
+ * @brief      capture ouverte en lecture (projetée en mémoire)
+ */
+typedef struct {
+
+	/** contenu du fichier */
+	const char 	*data;
+	/** taille du fichier */
+	size_t 		size;
+
+} traceFile_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone des captures
+ *
+ * @return     l'instant présent (µs)
+ */
+uint64_t traceClock();
+/**
+ * @brief      Commence une capture (un fichier existant est remplacé)
+ *
+ * @param      log   la capture
+ * @param      path  chemin du fichier
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openTrace(traceLog_t *log, const char *path);
+/**
+ * @brief      Écrit les enregistrements en attente et ferme la capture
+ *
+ * @param      log   la capture (fd -1 : sans effet)
+ */
+void closeTrace(traceLog_t *log);
+/**
+ * @brief      Écrit les enregistrements en attente
+ *
+ * @param      log   la capture (fd -1 : sans effet)
+ */
+void flushTrace(traceLog_t *log);
+/**
+ * @brief      Enregistre l'ouverture d'une connexion
+ *
+ * @param      log   la capture
+ *
+ * @return     le numéro de la connexion
+ */
+uint32_t traceOpen(traceLog_t *log);
+/**
+ * @brief      Enregistre une requête traitée
+ *
+ * @param      log        la capture
+ * @param[in]  conn       numéro de la connexion
+ * @param      request    la requête
+ * @param[in]  start      début de son traitement (traceClock)
+ * @param[in]  responses  réponses empilées pendant le traitement
+ *
+ * @note       l'enregistrement est daté de la réception : début du traitement
+ */
+void traceRequest(traceLog_t *log, uint32_t conn, req_t *request, uint64_t start, int responses);
+/**
+ * @brief      Enregistre la fermeture d'une connexion
+ *
+ * @param      log   la capture
+ * @param[in]  conn  numéro de la connexion
+ */
+void traceClose(traceLog_t *log, uint32_t conn);
+/**
+ * @brief      Ouvre une capture en lecture
+ *
+ * @param      file  la capture
+ * @param      path  chemin du fichier
+ *
+ * @return     0, -1 en cas d'erreur (errno) ou si le fichier n'est pas une capture
+ */
+int openTraceFile(traceFile_t *file, const char *path);
+/**
+ * @brief      Ferme une capture ouverte en lecture
+ *
+ * @param      file  la capture
+ */
+void closeTraceFile(traceFile_t *file);
+/**
+ * @brief      Lit l'enregistrement suivant
+ *
+ * @param      file     la capture
+ * @param      pos      position de la lecture (0 : premier), avancée
+ * @param      record   l'enregistrement lu
+ * @param      request  la requête (TRACE_REQUEST), NULL si inutile
+ *
+ * @return     1 si un enregistrement a été lu, 0 à la fin de la capture
+ *
+ * @note       un enregistrement tronqué en fin de fichier (arrêt brutal) est ignoré
+ */
+int nextTraceRecord(traceFile_t *file, size_t *pos, traceRecord_t *record, req_t *request);
+
+#endif /* TRACE_H */
@@ -10,16 +10,154 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
 #include <semaphore.h>
 
 #include <session.h>
 
 #include "dial.h"
+#include "discovery.h"
 #include "interface.h"
+#include "protocol.h"
+#include "latency.h"
+#include "render.h"
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * descripteur surveillé avec stdin (-1 : aucun) et son traitement
+ */
+static int 				inputSource 	= -1;
+static inputHandler 	onInputSource 	= NULL;
+/**
+ * minuterie : période (ms, 0 : désarmée), prochaine échéance et traitement
+ */
+static int 				timerDelay 		= 0;
+static long long 		timerDeadline 	= 0;
+static inputHandler 	onInputTimer 	= NULL;
+/**
+ * invite de l'entrée attendue, réaffichée après un événement
+ */
+static char 			inputPrompt[INPUT_BUFFER_SIZE] = "";
 /*
 *****************************************************************************************
  *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
  */
+/**
+ * @brief      Horloge monotone en millisecondes
+ */
+static long long nowMs() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
+}
+/**
+ * @brief      Attend que stdin soit lisible en traitant les événements de la source
+ *             et de la minuterie
+ *
+ * @return     STEP_SUCCESS, FGETS_ERROR si l'attente est interrompue
+ */
+static int waitInput() {
+
+	static int 		unbuffered 	= 0;
+	struct pollfd 	fds[2];
+	int 			timeout;
+	int 			shown;
+
+
+	// aucune ligne ne doit rester cachée dans le tampon de stdio : poll() l'ignorerait
+	if (!unbuffered) {
+		setvbuf(stdin, NULL, _IONBF, 0);
+		unbuffered = 1;
+	}
+
+	fds[0].fd 		= STDIN_FILENO;
+	fds[0].events 	= POLLIN;
+	fds[1].fd 		= inputSource;
+	fds[1].events 	= POLLIN;
+
+	fflush(stdout);
+
+	while (1) {
+
+		timeout = -1;
+		if (timerDelay > 0) {
+			timeout = (int) (timerDeadline - nowMs());
+			if (timeout < 0) timeout = 0;
+		}
+
+		fds[0].revents = fds[1].revents = 0;
+
+		// signal (SIGINT) : comme une lecture interrompue
+		if (poll(fds, 2, timeout) == -1) return errno == EINTR ? FGETS_ERROR : STEP_SUCCESS;
+
+		shown = 0;
+
+		if (fds[1].revents & POLLIN && onInputSource != NULL) shown |= onInputSource();
+
+		if (timerDelay > 0 && nowMs() >= timerDeadline) {
+			timerDeadline = nowMs() + timerDelay;
+			shown |= onInputTimer();
+		}
+
+		if (shown) fputs(inputPrompt, stdout);
+		fflush(stdout);
+
+		if (fds[0].revents) return STEP_SUCCESS;
+
+	}
+
+}
+/**
+ * @brief      Surveille un descripteur en attendant les entrées de l'utilisateur
+ *
+ * @param[in]  fd       le descripteur (-1 : aucun)
+ * @param[in]  onReady  appelée quand fd est lisible
+ */
+void setInputSource(int fd, inputHandler onReady) {
+
+	inputSource 	= fd;
+	onInputSource 	= onReady;
+
+}
+/**
+ * @brief      Arme une minuterie périodique en attendant les entrées de l'utilisateur
+ *
+ * @param[in]  delay    période (ms), 0 pour désarmer
+ * @param[in]  onTimer  appelée à chaque période
+ */
+void setInputTimer(int delay, inputHandler onTimer) {
+
+	timerDelay 		= onTimer != NULL ? delay : 0;
+	timerDeadline 	= nowMs() + delay;
+	onInputTimer 	= onTimer;
+
+}
+/**
+ * @brief      Affiche l'invite de la prochaine entrée, réaffichée après un événement
+ *
+ * @param      fmt   format de l'invite
+ * @param[in]  ...   valeurs du format
+ */
+void setInputPrompt(char *fmt, ...) {
+
+	va_list args;
+
+	va_start(args, fmt);
+	vsnprintf(inputPrompt, INPUT_BUFFER_SIZE, fmt, args);
+	va_end(args);
+
+	fputs(inputPrompt, stdout);
+
+}
 /**
  * @brief      demande à l'utilisateur les informations pour compléter son profil
  *
@@ -130,6 +268,8 @@ void setupUserInfos(clientInfo_t *infos) {
 /**
  * @brief      Demande à l'utilisateur l'adresse applicative du serveur 
  * 			   d'enregistrement ou utilise celle par défaut.
+ * 			   Formats acceptés : ip:port, [ipv6]:port, unix:/chemin ou les
+ * 			   mots clés DISCOVERY_KEYWORD et LAN_KEYWORD (recopiés dans userIP)
  *
  * @param[in]	adrIP     l'adresse ip par défaut
  * @param[in]  	port      le port par défaut
@@ -137,13 +277,42 @@ void setupUserInfos(clientInfo_t *infos) {
  * @param[out]  userPort  pointeur vers la variable qui sera utilisée comme port
  */
 void getSrvEAddress(char* adrIP, unsigned short port, char *userIP, short *userPort) {
-    int result;
+    int     result;
+    char    buffer[INPUT_BUFFER_SIZE];
     
     printf("\nConnexion au serveur d'enregistrement:\n");
+    printf("('%s' pour chercher le serveur sur le LAN, '%s' pour jouer sans serveur)\n"
+        , DISCOVERY_KEYWORD, LAN_KEYWORD);
 
-    printf("Adresse Applicative (%s:%d): ", adrIP, port);
+    if (estAdrUnix(adrIP))  printf("Adresse Applicative (%s): ", adrIP);
+    else                    printf("Adresse Applicative (%s:%d): ", adrIP, port);
     
-    result = retrieveInput("%[^:]:%hd", userIP, userPort);
+    result = saferFgets(buffer, INPUT_BUFFER_SIZE);
+
+    if (result == STEP_SUCCESS) buffer[strcspn(buffer, "\n")] = '\0';
+
+    if (result == STEP_SUCCESS
+        && (strcmp(buffer, DISCOVERY_KEYWORD) == 0 || strcmp(buffer, LAN_KEYWORD) == 0)) {
+
+        // mot clé : l'adresse sera cherchée sur le LAN par l'appelant
+        strcpy(userIP, buffer);
+        *userPort = 0;
+        return;
+
+    } else if (result == STEP_SUCCESS && estAdrUnix(buffer)) {
+
+        // socket locale : toute la ligne est l'adresse, pas de port
+        strcpy(userIP, buffer);
+        *userPort = 0;
+
+    } else if (result == STEP_SUCCESS) {
+
+        // une adresse IPv6 contient des ':' et s'écrit donc entre crochets
+        char *fmt = buffer[0] == '[' ? ADDR6_INPUT_FMT : ADDR_INPUT_FMT;
+
+        if (sscanf(buffer, fmt, userIP, userPort) != 2) result = VSSCANF_ERROR;
+
+    }
     
     if (result != STEP_SUCCESS) {
         printf("Utilisation des valeurs par défaut...\n");
@@ -252,8 +421,13 @@ int saferFgets(char *buffer, int size) {
 	char 	*readResult;
 
 
+	if (waitInput() != STEP_SUCCESS) return FGETS_ERROR;
+
 	readResult = fgets(buffer, size, stdin);
 
+	// l'invite ne vaut que pour cette entrée
+	inputPrompt[0] = '\0';
+
 
 	if (readResult == NULL) {
 		return FGETS_ERROR;
@@ -292,6 +466,166 @@ void displayHosts(clientInfo_t *hosts, int amount) {
 	printf("╚=========================╝ \n");
 
 
+}
+/**
+ * @brief      Affiche une liste d'hôtes classés avec leur latence
+ *
+ * @param      hosts   les hôtes à afficher
+ * @param      rtts    leurs latences (µs, RTT_UNKNOWN si inconnue)
+ * @param[in]  amount  la taille de `hosts`
+ */
+void displayRankedHosts(clientInfo_t *hosts, int *rtts, int amount) {
+
+	char 	latency[16];
+
+	if (getHostsAmount(hosts, amount) == 0) return;
+
+	printf("\n╔====[Hôtes disponibles]====╗\n");
+	printf("║                           ║\n");
+
+	for (int i = 0; i < amount; i++) {
+
+		if (hosts[i].role != HOST) continue;
+
+		if (rtts[i] == RTT_UNKNOWN) strcpy(latency, "-");
+		else if (rtts[i] < 1000) 	strcpy(latency, "<1 ms");
+		else 						sprintf(latency, "%d ms", rtts[i] / 1000);
+
+		printf("║  %2d.  %-10s  %7s ║\n", i+1, hosts[i].name, latency);
+		printf("║                           ║\n");
+
+	}
+
+	printf("╚===========================╝ \n");
+
+}
+/**
+ * @brief      Affiche le numéro de la page d'hôtes affichée
+ *
+ * @param[in]  page  numéro de la page (à partir de 0)
+ * @param[in]  more  1 s'il peut y avoir une page suivante
+ */
+void displayHostsPage(int page, int more) {
+
+	printf("  Page %d%s%s\n", page + 1, page > 0 ? "   - : précédente" : "", more ? "   + : suivante" : "");
+
+}
+/**
+ * @brief      Demande à l'utilisateur le début du nom des hôtes à lister
+ *
+ * @param      prefix  le préfixe saisi (PSEUDO_SIZE), vide si aucun
+ */
+void askHostPrefix(char *prefix) {
+
+	char 	fmt[16];
+
+	sprintf(fmt, "%%%ds", PSEUDO_SIZE - 1);
+
+	printf("\nDébut du nom de l'hôte (vide : tous): ");
+
+	if (retrieveInput(fmt, prefix) != STEP_SUCCESS) prefix[0] = '\0';
+
+}
+/**
+ * @brief      Demande à l'utilisateur son classement pour la mise en relation
+ *
+ * @return     le classement, MATCH_ANY si l'utilisateur n'en donne pas
+ */
+int askRating() {
+
+	int 	rating = MATCH_ANY;
+
+	printf("\nClassement (vide : indifférent): ");
+
+	if (retrieveInput("%d", &rating) != STEP_SUCCESS || rating < 0) rating = MATCH_ANY;
+
+	return rating;
+
+}
+/**
+ * @brief      Affiche l'adversaire trouvé par la mise en relation
+ *
+ * @param      opponent  l'adversaire (status CONNECTED si trouvé)
+ */
+void displayOpponent(clientInfo_t *opponent) {
+
+	if (opponent->status != CONNECTED) {
+		printf("\nAucun adversaire trouvé.\n");
+		return;
+	}
+
+	if (opponent->role == HOST)
+		printf("\nHôte trouvé: %s (%s:%hd)\n", opponent->name, opponent->address, opponent->port);
+	else
+		printf("\nJoueur trouvé: %s (%s)\n", opponent->name, opponent->address);
+
+}
+/**
+ * @brief      Demande à l'utilisateur le nom de l'hôte de la partie à regarder
+ *
+ * @param      name  le nom saisi (PSEUDO_SIZE), vide si aucun
+ */
+void askHostName(char *name) {
+
+	char 	fmt[16];
+
+	sprintf(fmt, "%%%ds", PSEUDO_SIZE - 1);
+
+	printf("\nHôte de la partie: ");
+
+	if (retrieveInput(fmt, name) != STEP_SUCCESS) name[0] = '\0';
+
+}
+/**
+ * @brief      Affiche un événement de la partie regardée
+ *
+ * @param[in]  status  code de l'événement (CELL, CURRENT_PLAYER ou GAME)
+ * @param      data    données de l'événement
+ */
+void displayGameEvent(short status, char *data) {
+
+	switch (getAction(status)) {
+
+		case CELL: 				printf("  Tir: %s\n", data); 			break;
+		case CURRENT_PLAYER: 	printf("  Au tour de: %s\n", data); 	break;
+		case GAME: 				printf("  Partie: %s\n", data); 		break;
+		default: 				break;
+
+	}
+
+}
+/**
+ * @brief      Affiche les deux grilles d'une partie
+ *
+ * @param      match  la partie
+ *
+ * @note       '#' navire intact, 'X' touché, 'o' tir dans l'eau
+ */
+void displayMatch(match_t *match) {
+
+	printf("\n    Joueur 0             Joueur 1\n");
+	printf("    0123456789           0123456789\n");
+
+	for (int y = 0; y < BOARD_SIZE; y++) {
+
+		for (int p = 0; p < 2; p++) {
+
+			board_t *board = &match->boards[p];
+
+			printf("%s%2d  ", p ? "       " : "", y);
+
+			for (int x = 0; x < BOARD_SIZE; x++) putchar(boardCellChar(board, CELL(x, y)));
+
+		}
+
+		putchar('\n');
+
+	}
+
+	printf("\nTirs: %u, au trait: joueur %d", match->turn, match->current);
+	if (match->winner != NO_WINNER) printf(", vainqueur: joueur %d", match->winner);
+	putchar('\n');
+
 }
 /**
  * @brief      affiche les menus dans le terminal avec une machine à états
@@ -330,20 +664,26 @@ void displayMainMenu(playerMenuParams_t params, menuState_t *state) {
 	int 	action  = 0;
 
 	callback	exitProgram = params.exitProgram;
+	callback	findOpponent= params.findOpponent;
+	callback	spectateGame= params.spectateGame;
 
 	printf("\n");
 	printf("╔=======[BATTLESHIP]=======╗\n");
 	printf("║                          ║\n");
 	printf("║     [1]    Rejoindre     ║\n");
 	printf("║                          ║\n");
-	printf("║     [2]    Quitter       ║\n");
+	printf("║     [2]    Partie rapide ║\n");
+	printf("║                          ║\n");
+	printf("║     [3]    Regarder      ║\n");
+	printf("║                          ║\n");
+	printf("║     [4]    Quitter       ║\n");
 	printf("║                          ║\n");
 	printf("╚==========================╝\n");
 
 	
 	do {
 
-		printf("\nAction: ");
+		setInputPrompt("\nAction: ");
 		result = retrieveInput("%d", &action);
 
 		if (result == USE_DEFAULT) {
@@ -366,11 +706,19 @@ void displayMainMenu(playerMenuParams_t params, menuState_t *state) {
 				break;
 
 			case 2:
+				findOpponent();
+				break;
+
+			case 3:
+				spectateGame();
+				break;
+
+			case 4:
 				exitProgram();
 				return;
 		}
 
-	} while (action != 1 && action != 2);
+	} while (action < 1 || action > 4);
 
 }
 /**
@@ -382,29 +730,22 @@ void displayMainMenu(playerMenuParams_t params, menuState_t *state) {
 void displayJoinMenu(playerMenuParams_t params, menuState_t *state) {
 
 	int 	result;
-	int 	maxAct;
+	int 	maxAct 	= 0;
 	int 	action  = 0;
+	char 	input[INPUT_BUFFER_SIZE];
 
 	callback	exitProgram = params.exitProgram;
 	callback	showHosts 	= params.showHosts;
 
+	// les hôtes peuvent arriver après l'invite : le choix est vérifié à la saisie
 	showHosts();
 
-	maxAct = getHostsAmount(params.hosts, MAX_HOSTS_GET);
-
-	if (maxAct == 0) {
-
-		printf("\nPas d'hôte à rejoindre.\n");
-
-		*state = MAIN_MENU;
-		return;
-
-	}
+	if (params.refreshHosts != NULL) setInputTimer(HOSTS_REFRESH_DELAY, params.refreshHosts);
 
 	do {
 
-		printf("\nAction (1-%d): ", maxAct);
-		result = retrieveInput("%d", &action);
+		setInputPrompt("\nAction (numéro, + : page suivante, - : précédente): ");
+		result = retrieveInput("%255s", input);
 
 		if (result == USE_DEFAULT) {
 
@@ -414,18 +755,37 @@ void displayJoinMenu(playerMenuParams_t params, menuState_t *state) {
 
 		if (result != STEP_SUCCESS) {
 
+			setInputTimer(0, NULL);
 			exitProgram();
 			return;
 
 		}
 
-		switch (action) {
+		if (strcmp(input, "+") == 0 || strcmp(input, "-") == 0) {
+
+			if (params.turnHostsPage != NULL) 	params.turnHostsPage(input[0] == '+' ? 1 : -1);
+			else 								printf("Pas d'autre page.\n");
+
+			action = 0;
+			continue;
+
+		}
+
+		if (sscanf(input, "%d", &action) != 1) action = 0;
+
+		// la page affichée change avec +, - et les rafraîchissements
+		maxAct = getHostsAmount(params.hosts, MAX_HOSTS_GET);
+
+		if (maxAct == 0) {
+
+			printf("\nPas d'hôte à rejoindre.\n");
+			break;
 
-			default:
-				*state = MAIN_MENU;
-				break;
 		}
 
 	} while (action <= 0 || action > maxAct);
 
+	setInputTimer(0, NULL);
+	*state = MAIN_MENU;
+
 }
\ No newline at end of file
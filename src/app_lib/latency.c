@@ -0,0 +1,320 @@
+/**
+ *	\file		latency.c
+ *	\brief		Fichier implémentation de la mesure de latence des hôtes et de leur classement
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "latency.h"
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      sonde en cours
+ */
+typedef struct {
+
+	/** l'hôte sondé */
+	int 		host;
+	/** date de début de la connexion (µs) */
+	long long 	start;
+
+} probe_t;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone en microsecondes
+ */
+static long long nowUs() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+}
+/**
+ * @brief      Lance la connexion non bloquante d'une sonde
+ *
+ * @return     le descripteur, -1 si l'hôte ne peut être sondé ou a déjà répondu
+ *             (connexion locale immédiate : mesure dans *rtt)
+ */
+static int startProbe(clientInfo_t *host, long long *start, int *rtt) {
+
+	struct sockaddr_storage addr;
+	socklen_t 				length;
+	int 					fd;
+
+
+	length = clientInfo2struct(host, &addr);
+
+	// seules les adresses IP se sondent
+	if (length == 0 || addr.ss_family == PF_UNIX) return -1;
+
+	fd = socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+	if (fd == -1) return -1;
+
+	*start = nowUs();
+
+	if (connect(fd, (struct sockaddr *) &addr, length) == 0 || errno == ECONNREFUSED) {
+		*rtt = (int) (nowUs() - *start);
+		close(fd);
+		return -1;
+	}
+
+	if (errno != EINPROGRESS) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+
+}
+/**
+ * @brief      Crée une table de latences vide
+ *
+ * @param      table  la table à initialiser
+ */
+void createRttTable(rttTable_t *table) {
+
+	pthread_mutex_init(&table->lock, NULL);
+	table->clock = 0;
+
+	for (int i = 0; i < RTT_TABLE_SIZE; i++) {
+		table->entries[i].srtt 	= RTT_UNKNOWN;
+		table->entries[i].stamp = 0;
+	}
+
+}
+/**
+ * @brief      Mesure en parallèle le temps d'établissement d'une connexion TCP vers
+ *             chaque hôte (un refus compte : il revient en un aller-retour)
+ *
+ * @param      hosts    les hôtes (les entrées qui ne sont pas hôtes sont ignorées)
+ * @param[in]  amount   la taille de hosts
+ * @param      rtts     les mesures (µs), RTT_UNKNOWN si l'hôte n'a pas répondu
+ * @param[in]  timeout  délai de chaque sonde (ms)
+ *
+ * @note       au plus PROBE_CONCURRENCY connexions en cours : une liste de cette
+ *             taille est mesurée en un aller-retour vers l'hôte le plus lent
+ */
+void probeHosts(clientInfo_t *hosts, int amount, int *rtts, int timeout) {
+
+	struct pollfd 	fds[PROBE_CONCURRENCY];
+	probe_t 		probes[PROBE_CONCURRENCY];
+	int 			active 	= 0;
+	int 			next 	= 0;
+	long long 		limit 	= (long long) timeout * 1000;
+	long long 		now;
+	long long 		wait;
+
+
+	for (int i = 0; i < amount; i++) rtts[i] = RTT_UNKNOWN;
+
+	while (next < amount || active > 0) {
+
+		// une sonde terminée laisse sa place à la suivante
+		while (active < PROBE_CONCURRENCY && next < amount) {
+
+			int host = next++;
+			int fd;
+
+			if (hosts[host].role != HOST) continue;
+
+			fd = startProbe(&hosts[host], &probes[active].start, &rtts[host]);
+
+			if (fd == -1) continue;
+
+			probes[active].host = host;
+			fds[active].fd 		= fd;
+			fds[active].events 	= POLLOUT;
+			active++;
+
+		}
+
+		if (active == 0) continue;
+
+		// jusqu'à la première échéance
+		now 	= nowUs();
+		wait 	= limit;
+
+		for (int i = 0; i < active; i++) {
+			if (probes[i].start + limit - now < wait) wait = probes[i].start + limit - now;
+		}
+
+		if (poll(fds, active, wait > 0 ? (int) ((wait + 999) / 1000) : 0) == -1 && errno != EINTR) break;
+
+		now = nowUs();
+
+		for (int i = active - 1; i >= 0; i--) {
+
+			int 		error 	= 0;
+			socklen_t 	length 	= sizeof(int);
+
+			if (fds[i].revents) {
+
+				getsockopt(fds[i].fd, SOL_SOCKET, SO_ERROR, &error, &length);
+
+				if (error == 0 || error == ECONNREFUSED)
+					rtts[probes[i].host] = (int) (now - probes[i].start);
+
+			}
+			else if (now - probes[i].start < limit) continue;
+
+			close(fds[i].fd);
+
+			active--;
+			fds[i] 		= fds[active];
+			probes[i] 	= probes[active];
+
+		}
+
+	}
+
+	// interrompue : les sondes restantes sont abandonnées
+	for (int i = 0; i < active; i++) close(fds[i].fd);
+
+}
+/**
+ * @brief      Intègre des mesures à la latence lissée des hôtes
+ *
+ * @param      table   la table
+ * @param      hosts   les hôtes
+ * @param      rtts    leurs mesures (RTT_UNKNOWN : ignorée)
+ * @param[in]  amount  la taille de hosts
+ */
+void updateRtts(rttTable_t *table, clientInfo_t *hosts, int *rtts, int amount) {
+
+	pthread_mutex_lock(&table->lock);
+
+	for (int i = 0; i < amount; i++) {
+
+		int 		slot 	= 0;
+		hostRtt_t 	*entry;
+
+		if (rtts[i] == RTT_UNKNOWN) continue;
+
+		// l'hôte, sinon l'entrée la plus anciennement mise à jour
+		for (int j = 0; j < RTT_TABLE_SIZE; j++) {
+
+			entry = &table->entries[j];
+
+			if (entry->srtt != RTT_UNKNOWN && entry->port == hosts[i].port
+				&& strcmp(entry->address, hosts[i].address) == 0) {
+				slot = j;
+				break;
+			}
+
+			if (entry->stamp < table->entries[slot].stamp) slot = j;
+
+		}
+
+		entry = &table->entries[slot];
+
+		if (entry->srtt == RTT_UNKNOWN || entry->port != hosts[i].port
+			|| strcmp(entry->address, hosts[i].address) != 0) {
+
+			strcpy(entry->address, hosts[i].address);
+			entry->port = hosts[i].port;
+			entry->srtt = rtts[i];
+
+		}
+		// moyenne glissante : un aller-retour isolé plus lent ne déclasse pas l'hôte
+		else entry->srtt += (rtts[i] - entry->srtt) / RTT_SMOOTHING;
+
+		entry->stamp = ++table->clock;
+
+	}
+
+	pthread_mutex_unlock(&table->lock);
+
+}
+/**
+ * @brief      Latence lissée d'un hôte
+ *
+ * @param      table  la table
+ * @param      host   l'hôte
+ *
+ * @return     la latence (µs), RTT_UNKNOWN si l'hôte n'a jamais répondu
+ */
+int getRtt(rttTable_t *table, clientInfo_t *host) {
+
+	int srtt = RTT_UNKNOWN;
+
+	pthread_mutex_lock(&table->lock);
+
+	for (int i = 0; i < RTT_TABLE_SIZE; i++) {
+
+		hostRtt_t *entry = &table->entries[i];
+
+		if (entry->srtt != RTT_UNKNOWN && entry->port == host->port
+			&& strcmp(entry->address, host->address) == 0) {
+			srtt = entry->srtt;
+			break;
+		}
+
+	}
+
+	pthread_mutex_unlock(&table->lock);
+
+	return srtt;
+
+}
+/**
+ * @brief      Trie les hôtes par latence lissée croissante, les inconnues à la fin
+ *
+ * @param      table   la table
+ * @param      hosts   les hôtes, triés sur place (ordre conservé à égalité)
+ * @param      rtts    leurs latences, remplies dans l'ordre du tri
+ * @param[in]  amount  la taille de hosts
+ *
+ * @return     1 si l'ordre a changé, 0 sinon
+ */
+int rankHosts(rttTable_t *table, clientInfo_t *hosts, int *rtts, int amount) {
+
+	int moved = 0;
+
+	for (int i = 0; i < amount; i++) {
+
+		// les entrées vides restent à la fin
+		rtts[i] = hosts[i].role == HOST ? getRtt(table, &hosts[i]) : RTT_UNKNOWN;
+
+	}
+
+	// tri par insertion : une page d'hôtes, stable
+	for (int i = 1; i < amount; i++) {
+
+		clientInfo_t 	host 	= hosts[i];
+		int 			rtt 	= rtts[i];
+		int 			j 		= i;
+
+		if (rtt == RTT_UNKNOWN) continue;
+
+		while (j > 0 && (rtts[j - 1] == RTT_UNKNOWN || rtts[j - 1] > rtt)) {
+			hosts[j] 	= hosts[j - 1];
+			rtts[j] 	= rtts[j - 1];
+			j--;
+		}
+
+		hosts[j] 	= host;
+		rtts[j] 	= rtt;
+		moved 		|= j != i;
+
+	}
+
+	return moved;
+
+}
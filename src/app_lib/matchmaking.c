@@ -0,0 +1,295 @@
+/**
+ *	\file		matchmaking.c
+ *	\brief		Fichier implémentation de la file d'attente de mise en relation joueurs/hôtes
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "matchmaking.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Tranche de classement d'un client
+ *
+ * @param[in]  rating  le classement, MATCH_ANY si indifférent
+ *
+ * @return     la tranche, MATCH_BUCKETS si indifférent
+ */
+static int bucketOf(int rating) {
+
+	if (rating < 0) return MATCH_BUCKETS;
+
+	return rating / MATCH_BUCKET_WIDTH < MATCH_BUCKETS
+		? rating / MATCH_BUCKET_WIDTH : MATCH_BUCKETS - 1;
+
+}
+/**
+ * @brief      Le ticket a est-il arrivé avant le ticket b
+ */
+static int older(matchmaker_t *matchmaker, int a, int b) {
+
+	// différence signée : reste juste quand le compteur reboucle
+	return (int32_t) (matchmaker->tickets[a].seq - matchmaker->tickets[b].seq) < 0;
+
+}
+/**
+ * @brief      Place un ticket à une position du tas
+ */
+static void place(matchmaker_t *matchmaker, matchHeap_t *heap, int pos, int ticket) {
+
+	heap->items[pos] 					= ticket;
+	matchmaker->tickets[ticket].pos 	= pos;
+
+}
+/**
+ * @brief      Remonte un ticket vers la racine tant qu'il est plus ancien que son parent
+ */
+static void siftUp(matchmaker_t *matchmaker, matchHeap_t *heap, int pos) {
+
+	int ticket = heap->items[pos];
+
+	while (pos > 0 && older(matchmaker, ticket, heap->items[(pos - 1) / 2])) {
+
+		place(matchmaker, heap, pos, heap->items[(pos - 1) / 2]);
+		pos = (pos - 1) / 2;
+
+	}
+
+	place(matchmaker, heap, pos, ticket);
+
+}
+/**
+ * @brief      Descend un ticket tant qu'un de ses enfants est plus ancien
+ */
+static void siftDown(matchmaker_t *matchmaker, matchHeap_t *heap, int pos) {
+
+	int ticket = heap->items[pos];
+
+	while (2 * pos + 1 < heap->amount) {
+
+		int child = 2 * pos + 1;
+
+		if (child + 1 < heap->amount && older(matchmaker, heap->items[child + 1], heap->items[child]))
+			child++;
+
+		if (!older(matchmaker, heap->items[child], ticket)) break;
+
+		place(matchmaker, heap, pos, heap->items[child]);
+		pos = child;
+
+	}
+
+	place(matchmaker, heap, pos, ticket);
+
+}
+/**
+ * @brief      Met un ticket en attente dans le tas de son rôle et de sa tranche
+ *
+ * @return     le ticket, -1 si la file est pleine
+ */
+static int enqueue(matchmaker_t *matchmaker, userRole_t role, int bucket, uint32_t seq, void *owner) {
+
+	matchHeap_t *heap = &matchmaker->heaps[role][bucket];
+	int 		ticket;
+
+	if (matchmaker->freeList == -1) return -1;
+
+	if (heap->amount == heap->size) {
+
+		int size 	= heap->size ? 2 * heap->size : 16;
+		int *items 	= realloc(heap->items, size * sizeof(int));
+
+		if (items == NULL) return -1;
+
+		heap->items = items;
+		heap->size 	= size;
+
+	}
+
+	ticket 							= matchmaker->freeList;
+	matchmaker->freeList 			= matchmaker->tickets[ticket].pos;
+	matchmaker->tickets[ticket] 	= (matchTicket_t) {seq, role, bucket, 0, owner};
+
+	heap->items[heap->amount++] 	= ticket;
+	siftUp(matchmaker, heap, heap->amount - 1);
+
+	return ticket;
+
+}
+/**
+ * @brief      Crée une file d'attente de mise en relation
+ *
+ * @param      matchmaker  la file à initialiser
+ * @param[in]  capacity    nombre maximum de clients en attente
+ *
+ * @note       termine le programme si les tickets ne peuvent être alloués
+ */
+void createMatchmaker(matchmaker_t *matchmaker, int capacity) {
+
+	matchmaker->tickets 	= malloc(capacity * sizeof(matchTicket_t));
+	if (matchmaker->tickets == NULL) {
+		perror("Can't allocate matchmaker");
+		exit(EXIT_FAILURE);
+	}
+
+	matchmaker->capacity 	= capacity;
+	matchmaker->seq 		= 0;
+
+	// les tas grandissent à la demande : la plupart restent vides
+	for (int r = 0; r < 2; r++) {
+		for (int b = 0; b <= MATCH_BUCKETS; b++) {
+			matchmaker->heaps[r][b] = (matchHeap_t) {NULL, 0, 0};
+		}
+	}
+
+	matchmaker->freeList 	= capacity > 0 ? 0 : -1;
+
+	for (int i = 0; i < capacity; i++) {
+		matchmaker->tickets[i].owner 	= NULL;
+		matchmaker->tickets[i].pos 		= i + 1 < capacity ? i + 1 : -1;
+	}
+
+}
+/**
+ * @brief      Libère une file d'attente de mise en relation
+ *
+ * @param      matchmaker  la file
+ */
+void destroyMatchmaker(matchmaker_t *matchmaker) {
+
+	for (int r = 0; r < 2; r++) {
+		for (int b = 0; b <= MATCH_BUCKETS; b++) {
+			free(matchmaker->heaps[r][b].items);
+			matchmaker->heaps[r][b] = (matchHeap_t) {NULL, 0, 0};
+		}
+	}
+
+	free(matchmaker->tickets);
+
+	matchmaker->tickets 	= NULL;
+	matchmaker->capacity 	= 0;
+	matchmaker->freeList 	= -1;
+
+}
+/**
+ * @brief      Met un client en relation avec le plus ancien client de l'autre rôle
+ *             compatible (même tranche ou indifférent), sinon le met en attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  role        rôle du client (un joueur attend un hôte et inversement)
+ * @param[in]  rating      classement du client, MATCH_ANY si indifférent
+ * @param      owner       propriétaire du ticket (non NULL)
+ * @param      ticket      ticket du client mis en attente, -1 sinon
+ *
+ * @return     le propriétaire du ticket mis en relation, NULL si le client attend
+ *             (*ticket >= 0) ou si la file est pleine (*ticket == -1)
+ *
+ * @note       O(log n) : seuls les sommets des MATCH_BUCKETS + 1 tas sont comparés
+ */
+void *requestMatch(matchmaker_t *matchmaker, userRole_t role, int rating, void *owner, int *ticket) {
+
+	matchHeap_t *others 	= matchmaker->heaps[role == HOST ? PLAYER : HOST];
+	int 		bucket 		= bucketOf(rating);
+	int 		best 		= -1;
+	void 		*peer;
+
+	*ticket = -1;
+
+	// indifférent : toutes les tranches, sinon la sienne et les indifférents
+	for (int b = 0; b <= MATCH_BUCKETS; b++) {
+
+		if (bucket != MATCH_BUCKETS && b != bucket && b != MATCH_BUCKETS) continue;
+		if (others[b].amount == 0) continue;
+
+		if (best == -1 || older(matchmaker, others[b].items[0], best))
+			best = others[b].items[0];
+
+	}
+
+	if (best >= 0) {
+
+		peer = matchmaker->tickets[best].owner;
+		cancelMatch(matchmaker, best);
+
+		return peer;
+
+	}
+
+	*ticket = enqueue(matchmaker, role, bucket, matchmaker->seq++, owner);
+
+	return NULL;
+
+}
+/**
+ * @brief      Remet en attente un client venu d'une autre file (passation), à son
+ *             ordre d'arrivée dans celle-ci
+ *
+ * @param      matchmaker  la file
+ * @param      from        le ticket du client dans l'autre file
+ * @param      owner       propriétaire du ticket (non NULL)
+ *
+ * @return     le ticket du client, -1 si la file est pleine
+ *
+ * @note       les clients remis en attente ne sont pas mis en relation entre eux : ils
+ *             ne l'étaient pas dans l'autre file. Les demandes suivantes arrivent après.
+ */
+int adoptTicket(matchmaker_t *matchmaker, matchTicket_t *from, void *owner) {
+
+	if ((int32_t) (from->seq - matchmaker->seq) >= 0) matchmaker->seq = from->seq + 1;
+
+	return enqueue(matchmaker, from->role, from->bucket, from->seq, owner);
+
+}
+/**
+ * @brief      Retire un client de la file d'attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  ticket      le ticket du client (-1 accepté)
+ */
+void cancelMatch(matchmaker_t *matchmaker, int ticket) {
+
+	matchTicket_t 	*t;
+	matchHeap_t 	*heap;
+	int 			pos;
+
+	if (ticket < 0 || matchmaker->tickets[ticket].owner == NULL) return;
+
+	t 		= &matchmaker->tickets[ticket];
+	heap 	= &matchmaker->heaps[t->role][t->bucket];
+	pos 	= t->pos;
+
+	// le dernier ticket du tas prend la place du ticket retiré puis est remis en ordre
+	if (pos != --heap->amount) {
+
+		place(matchmaker, heap, pos, heap->items[heap->amount]);
+		siftUp(matchmaker, heap, pos);
+		siftDown(matchmaker, heap, pos);
+
+	}
+
+	t->owner 				= NULL;
+	t->pos 					= matchmaker->freeList;
+	matchmaker->freeList 	= ticket;
+
+}
+/**
+ * @brief      Nombre de clients en attente
+ *
+ * @param      matchmaker  la file
+ * @param[in]  role        le rôle des clients à compter
+ *
+ * @return     le nombre de clients de ce rôle en attente
+ */
+int waitingAmount(matchmaker_t *matchmaker, userRole_t role) {
+
+	int amount = 0;
+
+	for (int b = 0; b <= MATCH_BUCKETS; b++) amount += matchmaker->heaps[role][b].amount;
+
+	return amount;
+
+}
@@ -0,0 +1,255 @@
+/**
+ *	\file		nameindex.c
+ *	\brief		Fichier implémentation de l'index des clients par nom et de la recherche par préfixe
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nameindex.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ordre de l'index : par nom, puis par position dans le registre
+ */
+static int compareIds(nameIndex_t *index, int a, int b) {
+
+	int cmp = strncmp(index->clients[a].name, index->clients[b].name, PSEUDO_SIZE);
+
+	return cmp != 0 ? cmp : a - b;
+
+}
+/**
+ * @brief      Première position de l'index dont le nom n'est pas avant name
+ */
+static int lowerBound(nameIndex_t *index, const char *name) {
+
+	int low 	= 0;
+	int high 	= index->amount;
+
+	while (low < high) {
+
+		int mid = (low + high) / 2;
+
+		if (strncmp(index->clients[index->ids[mid]].name, name, PSEUDO_SIZE) < 0) low = mid + 1;
+		else 																	high = mid;
+
+	}
+
+	return low;
+
+}
+/**
+ * @brief      Crée un index vide sur un registre
+ *
+ * @param      index     l'index à initialiser
+ * @param      clients   le registre
+ * @param[in]  capacity  taille du registre
+ *
+ * @note       termine le programme si l'index ne peut être alloué
+ */
+void createNameIndex(nameIndex_t *index, clientInfo_t *clients, int capacity) {
+
+	index->ids 		= malloc(capacity * sizeof(int));
+	index->indexed 	= calloc(capacity, sizeof(char));
+
+	if (index->ids == NULL || index->indexed == NULL) {
+		perror("Can't allocate name index");
+		exit(EXIT_FAILURE);
+	}
+
+	index->clients 	= clients;
+	index->amount 	= 0;
+	index->capacity = capacity;
+
+}
+/**
+ * @brief      Libère un index
+ *
+ * @param      index  l'index
+ */
+void destroyNameIndex(nameIndex_t *index) {
+
+	free(index->ids);
+	free(index->indexed);
+
+	index->ids 		= NULL;
+	index->indexed 	= NULL;
+	index->amount 	= 0;
+	index->capacity = 0;
+
+}
+/**
+ * @brief      Indexe une entrée du registre sous son nom actuel
+ *
+ * @param      index  l'index
+ * @param[in]  id     l'entrée (déjà indexée : réindexée)
+ */
+void indexClient(nameIndex_t *index, int id) {
+
+	int pos;
+
+	if (id < 0 || id >= index->capacity) return;
+
+	unindexClient(index, id);
+
+	pos = lowerBound(index, index->clients[id].name);
+	while (pos < index->amount && compareIds(index, index->ids[pos], id) < 0) pos++;
+
+	memmove(&index->ids[pos + 1], &index->ids[pos], (index->amount - pos) * sizeof(int));
+	index->ids[pos] 	= id;
+	index->indexed[id] 	= 1;
+	index->amount++;
+
+}
+/**
+ * @brief      Retire une entrée de l'index, avant que son nom ne change
+ *
+ * @param      index  l'index
+ * @param[in]  id     l'entrée (non indexée : sans effet)
+ */
+void unindexClient(nameIndex_t *index, int id) {
+
+	int pos;
+
+	if (id < 0 || id >= index->capacity || !index->indexed[id]) return;
+
+	// les homonymes sont rangés par position : l'entrée est parmi eux
+	pos = lowerBound(index, index->clients[id].name);
+	while (pos < index->amount && index->ids[pos] != id) pos++;
+
+	if (pos == index->amount) return;
+
+	index->amount--;
+	memmove(&index->ids[pos], &index->ids[pos + 1], (index->amount - pos) * sizeof(int));
+	index->indexed[id] = 0;
+
+}
+/**
+ * @brief      Reconstruit l'index à partir des entrées connectées ou en attente
+ *
+ * @param      index  l'index
+ */
+void rebuildNameIndex(nameIndex_t *index) {
+
+	index->amount = 0;
+	memset(index->indexed, 0, index->capacity);
+
+	for (int i = 0; i < index->capacity; i++) {
+
+		if (index->clients[i].status == CONNECTED || index->clients[i].status == PENDING)
+			indexClient(index, i);
+
+	}
+
+}
+/**
+ * @brief      Un client satisfait-il un filtre
+ *
+ * @param      client  le client
+ * @param      filter  le filtre
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int matchesFilter(clientInfo_t *client, hostFilter_t *filter) {
+
+	if (filter->role != FILTER_ANY && (int) client->role != filter->role) return 0;
+
+	if (filter->status == FILTER_ANY) {
+		if (client->status != CONNECTED && client->status != PENDING) return 0;
+	}
+	else if ((int) client->status != filter->status) return 0;
+
+	return strncmp(client->name, filter->prefix, strlen(filter->prefix)) == 0;
+
+}
+/**
+ * @brief      Liste par ordre de nom les entrées indexées satisfaisant un filtre
+ *
+ * @param      index   l'index
+ * @param      filter  le filtre
+ * @param      ids     les entrées trouvées
+ * @param[in]  max     taille de ids
+ *
+ * @return     le nombre d'entrées trouvées
+ *
+ * @note       O(log n) jusqu'au premier nom du préfixe, puis seulement les noms
+ *             qui le partagent sont parcourus. filter->skip est diminué des entrées
+ *             sautées : il reste à sauter parmi les clients listés ensuite.
+ */
+int filterClients(nameIndex_t *index, hostFilter_t *filter, int *ids, int max) {
+
+	int 	found 	= 0;
+	size_t 	length 	= strlen(filter->prefix);
+
+	for (int pos = lowerBound(index, filter->prefix); pos < index->amount && found < max; pos++) {
+
+		clientInfo_t *client = &index->clients[index->ids[pos]];
+
+		// noms triés : le premier qui ne commence pas par le préfixe termine la recherche
+		if (strncmp(client->name, filter->prefix, length) != 0) break;
+
+		if (!matchesFilter(client, filter)) continue;
+
+		if (filter->skip > 0) 	filter->skip--;
+		else 					ids[found++] = index->ids[pos];
+
+	}
+
+	return found;
+
+}
+/**
+ * @brief      sérialise un filtre
+ *
+ * @param      filter  le filtre
+ * @param      str     le buffer sérialisé
+ */
+void hostFilter2str(hostFilter_t *filter, char *str) {
+
+	sprintf(str, FILTER_OUT, filter->role, filter->status, filter->prefix, filter->skip);
+
+}
+/**
+ * @brief      désérialise un filtre
+ *
+ * @param      str     le buffer sérialisé (vide : hôtes connectés ou en attente)
+ * @param      filter  le filtre
+ *
+ * @return     1 si le filtre est bien formé, 0 sinon
+ */
+int str2hostFilter(char *str, hostFilter_t *filter) {
+
+	int 	offset 	= 0;
+	char 	*end;
+	size_t 	length;
+
+	filter->prefix[0] 	= '\0';
+	filter->role 		= HOST;
+	filter->status 		= FILTER_ANY;
+	filter->skip 		= 0;
+
+	// requête d'un client sans filtre
+	if (str[0] == '\0') return 1;
+
+	if (sscanf(str, FILTER_IN, &filter->role, &filter->status, &offset) != 2 || offset == 0) return 0;
+
+	// le préfixe peut être vide, les clients sautés absents
+	str 	+= offset;
+	end 	= strchr(str, ',');
+	length 	= end != NULL ? (size_t) (end - str) : strlen(str);
+
+	if (length >= PSEUDO_SIZE) return 0;
+
+	memcpy(filter->prefix, str, length);
+	filter->prefix[length] = '\0';
+
+	if (end != NULL && (sscanf(end + 1, "%d", &filter->skip) != 1 || filter->skip < 0)) return 0;
+
+	return 1;
+
+}
@@ -0,0 +1,288 @@
+/**
+ *	\file		placement.c
+ *	\brief		Fichier implémentation de la génération et de la validation des flottes
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <pthread.h>
+#include "placement.h"
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      placement précalculé d'un navire
+ */
+typedef struct {
+
+	/** cases du navire */
+	bitboard_t 		cells;
+	/** cases du navire et leurs voisines (règle PLACE_NO_TOUCH) */
+	bitboard_t 		halo;
+	/** case de la proue */
+	unsigned char 	bow;
+	/** orientation */
+	unsigned char 	vertical;
+
+} placement_t;
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ * placements de chaque navire, et leur nombre
+ */
+static placement_t 	placements[FLEET_SIZE][MAX_PLACEMENTS];
+static int 			placementAmounts[FLEET_SIZE];
+/**
+ * indice du placement par navire, orientation et proue (-1 : hors de la grille)
+ */
+static short 		placementIds[FLEET_SIZE][2][BOARD_CELLS];
+/**
+ * les masques ne sont calculés qu'une fois, au premier usage
+ */
+static pthread_once_t placementsOnce = PTHREAD_ONCE_INIT;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Cases voisines d'un ensemble de cases (diagonales comprises), incluses
+ */
+static bitboard_t growCells(bitboard_t cells) {
+
+	bitboard_t grown = cells;
+
+	for (int cell = 0; cell < BOARD_CELLS; cell++) {
+
+		int x = cell % BOARD_SIZE;
+		int y = cell / BOARD_SIZE;
+
+		if (!(cells & BIT(cell))) continue;
+
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+
+				if (x + dx < 0 || x + dx >= BOARD_SIZE || y + dy < 0 || y + dy >= BOARD_SIZE) continue;
+				grown |= BIT(CELL(x + dx, y + dy));
+
+			}
+		}
+
+	}
+
+	return grown;
+
+}
+/**
+ * @brief      Précalcule les masques de tous les placements de chaque navire
+ */
+static void initPlacements() {
+
+	for (int ship = 0; ship < FLEET_SIZE; ship++) {
+
+		placementAmounts[ship] = 0;
+
+		for (int vertical = 0; vertical < 2; vertical++) {
+
+			for (int cell = 0; cell < BOARD_CELLS; cell++) {
+
+				bitboard_t 	cells 	= shipCells(ship, cell, vertical);
+				placement_t *entry 	= &placements[ship][placementAmounts[ship]];
+
+				placementIds[ship][vertical][cell] = -1;
+
+				if (cells == 0) continue;
+
+				entry->cells 	= cells;
+				entry->halo 	= growCells(cells);
+				entry->bow 		= cell;
+				entry->vertical = vertical;
+
+				placementIds[ship][vertical][cell] = placementAmounts[ship]++;
+
+			}
+
+		}
+
+	}
+
+}
+/**
+ * @brief      Placement d'un navire, NULL s'il sort de la grille
+ */
+static placement_t *findPlacement(int ship, int cell, int vertical) {
+
+	pthread_once(&placementsOnce, initPlacements);
+
+	if (ship < 0 || ship >= FLEET_SIZE || cell < 0 || cell >= BOARD_CELLS) return NULL;
+	if (placementIds[ship][vertical != 0][cell] < 0) return NULL;
+
+	return &placements[ship][placementIds[ship][vertical != 0][cell]];
+
+}
+/**
+ * @brief      Générateur xorshift64* : rapide, suffisant pour tirer des flottes et
+ *             les tirs des bots
+ *
+ * @param      seed  état du générateur (non nul), avancé
+ *
+ * @return     le nombre tiré
+ */
+uint64_t nextRandom(uint64_t *seed) {
+
+	*seed ^= *seed >> 12;
+	*seed ^= *seed << 25;
+	*seed ^= *seed >> 27;
+
+	return *seed * 0x2545F4914F6CDD1DULL;
+
+}
+/**
+ * @brief      Nombre de placements d'un navire dans une grille vide
+ *
+ * @param[in]  ship  indice du navire dans la flotte
+ *
+ * @return     le nombre de placements
+ */
+int placementCount(int ship) {
+
+	pthread_once(&placementsOnce, initPlacements);
+
+	return ship >= 0 && ship < FLEET_SIZE ? placementAmounts[ship] : 0;
+
+}
+/**
+ * @brief      Cases d'un placement, lues dans les masques précalculés
+ *
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ *
+ * @return     les cases, 0 si le navire sort de la grille
+ */
+bitboard_t placementCells(int ship, int cell, int vertical) {
+
+	placement_t *placement = findPlacement(ship, cell, vertical);
+
+	return placement != NULL ? placement->cells : 0;
+
+}
+/**
+ * @brief      Un navire peut-il être ajouté à une flotte (temps constant)
+ *
+ * @param[in]  fleet     les cases des navires déjà placés
+ * @param[in]  ship      indice du navire dans la flotte
+ * @param[in]  cell      case de la proue
+ * @param[in]  vertical  1 : vers le bas, 0 : vers la droite
+ * @param[in]  rules     PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ *
+ * @return     1 si oui, 0 sinon
+ */
+int canPlaceShip(bitboard_t fleet, int ship, int cell, int vertical, int rules) {
+
+	placement_t *placement = findPlacement(ship, cell, vertical);
+
+	if (placement == NULL) return 0;
+
+	return (fleet & (rules == PLACE_NO_TOUCH ? placement->halo : placement->cells)) == 0;
+
+}
+/**
+ * @brief      Une grille porte-t-elle une flotte complète et légale
+ *
+ * @param      board  la grille (ships et fleet)
+ * @param[in]  rules  PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ *
+ * @return     1 si oui, 0 sinon
+ *
+ * @note       une vérification en temps constant par navire, quelle que soit la
+ *             provenance des masques (saisie de l'utilisateur, réseau)
+ */
+int validateBoard(board_t *board, int rules) {
+
+	bitboard_t fleet = 0;
+
+	for (int ship = 0; ship < FLEET_SIZE; ship++) {
+
+		bitboard_t 	cells = board->ships[ship];
+		placement_t *placement;
+		int 		bow;
+
+		if (cells == 0) return 0;
+
+		// la proue est la case la plus basse : le masque doit être celui de l'une
+		// des deux orientations depuis cette case
+		bow 		= lowestCell(cells);
+		placement 	= findPlacement(ship, bow, 0);
+
+		if (placement == NULL || placement->cells != cells) placement = findPlacement(ship, bow, 1);
+		if (placement == NULL || placement->cells != cells) return 0;
+
+		if (!canPlaceShip(fleet, ship, bow, placement->vertical, rules)) return 0;
+
+		fleet |= cells;
+
+	}
+
+	return fleet == board->fleet;
+
+}
+/**
+ * @brief      Tire une flotte légale uniformément parmi toutes les flottes légales
+ *
+ * @param      fleet  la flotte tirée
+ * @param[in]  rules  PLACE_ALLOW_TOUCH ou PLACE_NO_TOUCH
+ * @param      seed   état du générateur (xorshift64*, non nul), avancé
+ *
+ * @note       chaque navire est tiré parmi ses placements précalculés ; un
+ *             chevauchement relance toute la flotte, ce qui garde l'uniformité
+ */
+void randomFleet(fleet_t *fleet, int rules, uint64_t *seed) {
+
+	int ship = 0;
+
+	pthread_once(&placementsOnce, initPlacements);
+
+	fleet->cells = 0;
+
+	while (ship < FLEET_SIZE) {
+
+		// indice uniforme par multiplication (biais négligeable pour 200 placements)
+		uint32_t 	draw 		= nextRandom(seed) >> 32;
+		placement_t *placement 	= &placements[ship][((uint64_t) draw * placementAmounts[ship]) >> 32];
+
+		if (fleet->cells & (rules == PLACE_NO_TOUCH ? placement->halo : placement->cells)) {
+			fleet->cells 	= 0;
+			ship 			= 0;
+			continue;
+		}
+
+		fleet->ships[ship] 		= placement->cells;
+		fleet->bows[ship] 		= placement->bow;
+		fleet->vertical[ship] 	= placement->vertical;
+		fleet->cells 			|= placement->cells;
+		ship++;
+
+	}
+
+}
+/**
+ * @brief      Place une flotte dans une partie (journalisée comme des placements)
+ *
+ * @param      match   la partie
+ * @param[in]  player  le joueur
+ * @param      fleet   la flotte
+ *
+ * @return     0, -1 si un navire ne peut être placé
+ */
+int applyFleet(match_t *match, int player, fleet_t *fleet) {
+
+	for (int ship = 0; ship < FLEET_SIZE; ship++) {
+		if (placeShip(match, player, ship, fleet->bows[ship], fleet->vertical[ship]) == -1) return -1;
+	}
+
+	return 0;
+
+}
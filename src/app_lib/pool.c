@@ -0,0 +1,114 @@
+/**
+ *	\file		pool.c
+ *	\brief		Fichier implémentation des réserves d'objets de taille fixe
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdalign.h>
+#include "pool.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Crée une réserve d'objets
+ *
+ * @param      pool      la réserve à initialiser
+ * @param[in]  objSize   taille d'un objet
+ * @param[in]  capacity  nombre d'objets
+ * 
+ * @note       termine le programme si le bloc ne peut être alloué
+ */
+void createPool(pool_t *pool, size_t objSize, int capacity) {
+
+	size_t align = alignof(max_align_t);
+
+	// un objet libre doit pouvoir contenir le chaînage, et chaque objet rester aligné
+	if (objSize < sizeof(void *)) objSize = sizeof(void *);
+	objSize = (objSize + align - 1) / align * align;
+
+	pool->objects 		= malloc(objSize * capacity);
+	if (pool->objects == NULL) {
+		perror("Can't allocate pool");
+		exit(EXIT_FAILURE);
+	}
+
+	pool->objSize 		= objSize;
+	pool->capacity 		= capacity;
+	pool->freeList 		= NULL;
+	pool->freeAmount 	= capacity;
+	pthread_mutex_init(&pool->lock, NULL);
+
+	// empiler à l'envers : les premiers objets du bloc sortent en premier
+	for (int i = capacity - 1; i >= 0; i--) {
+
+		void **obj 		= (void **) (pool->objects + i * objSize);
+		*obj 			= pool->freeList;
+		pool->freeList 	= obj;
+
+	}
+
+}
+/**
+ * @brief      Libère le bloc d'une réserve
+ *
+ * @param      pool  la réserve
+ * 
+ * @note       les objets encore empruntés deviennent invalides
+ */
+void destroyPool(pool_t *pool) {
+
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->objects);
+
+	pool->objects 		= NULL;
+	pool->freeList 		= NULL;
+	pool->freeAmount 	= 0;
+
+}
+/**
+ * @brief      Emprunte un objet à la réserve
+ *
+ * @param      pool  la réserve
+ *
+ * @return     un objet (contenu indéterminé), NULL si la réserve est épuisée
+ */
+void *poolAlloc(pool_t *pool) {
+
+	void **obj;
+
+	pthread_mutex_lock(&pool->lock);
+
+	obj = pool->freeList;
+	if (obj != NULL) {
+		pool->freeList = *obj;
+		pool->freeAmount--;
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+
+	return obj;
+
+}
+/**
+ * @brief      Rend un objet à la réserve
+ *
+ * @param      pool  la réserve dont provient l'objet
+ * @param      obj   l'objet (NULL accepté)
+ */
+void poolFree(pool_t *pool, void *obj) {
+
+	if (obj == NULL) return;
+
+	pthread_mutex_lock(&pool->lock);
+
+	*(void **) obj 	= pool->freeList;
+	pool->freeList 	= obj;
+	pool->freeAmount++;
+
+	pthread_mutex_unlock(&pool->lock);
+
+}
@@ -5,6 +5,7 @@
  *	\date		29 janvier 2026
  *	\version	1.0
  */
+#include <stdio.h>
 #include "protocol.h"
 /*
 *****************************************************************************************
@@ -28,17 +29,14 @@ short enum2status(statusRange_t type, action_t action) {
  *
  * @param[in]  code  le status
  *
- * @return     le statusRange_t correspondant à l'intervalle de status du code
+ * @return     le statusRange_t correspondant à l'intervalle de status du code,
+ *             RANGE_UNKNOWN si le code n'appartient à aucun intervalle
  */
 statusRange_t getStatusRange(short code) {
 
-	switch (code / 100) {
+	int range = code / 100 - 1;
 
-		case 1: return REQ;
-		case 2: return ACK;
-		case 3: return ERR;
-
-	}
+	return code > 0 && range <= ERR ? (statusRange_t) range : RANGE_UNKNOWN;
 
 }
 /**
@@ -46,17 +44,49 @@ statusRange_t getStatusRange(short code) {
  *
  * @param[in]  code     code de status
  *
- * @return     l'action_t représentée par le code
+ * @return     l'action_t représentée par le code, ACTION_UNKNOWN si aucune
  */
 action_t getAction(short code) {
 
-	switch (code % 100) {
+	int action = code % 100 - 1;
+
+	return code > 0 && action >= 0 && action < ACTION_AMOUNT ? (action_t) action : ACTION_UNKNOWN;
+
+}
+/**
+ * @brief      sérialise une négociation
+ *
+ * @param      hello  la version et les capacités
+ * @param      str    le buffer sérialisé
+ */
+void hello2str(hello_t *hello, char *str) {
+
+	sprintf(str, HELLO_FMT, hello->version, hello->caps);
 
-		case 1: return CONNECT;
-		case 2: return CELL;
-		case 3: return GAME;
-		case 4: return CURRENT_PLAYER;
+}
+/**
+ * @brief      désérialise une négociation
+ *
+ * @param      str    le buffer sérialisé
+ * @param      hello  la version et les capacités
+ *
+ * @return     1 si la négociation est bien formée, 0 sinon
+ */
+int str2hello(char *str, hello_t *hello) {
+
+	return sscanf(str, HELLO_FMT, &hello->version, &hello->caps) == 2 && hello->version > 0;
+
+}
+/**
+ * @brief      convient d'une version et de capacités communes
+ *
+ * @param      offer      ce que propose l'autre partie
+ * @param      supported  ce que l'on sait faire
+ * @param      agreed     la plus petite version et les capacités communes
+ */
+void negotiateHello(hello_t *offer, hello_t *supported, hello_t *agreed) {
 
-	}
+	agreed->version = offer->version < supported->version ? offer->version : supported->version;
+	agreed->caps 	= offer->caps & supported->caps;
 
 }
\ No newline at end of file
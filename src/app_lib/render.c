@@ -0,0 +1,192 @@
+/**
+ *	\file		render.c
+ *	\brief		Fichier implémentation de l'affichage des grilles par différences (double tampon)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "render.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ajoute du texte à l'image en construction (tronqué si elle est pleine)
+ */
+static void emit(renderer_t *renderer, const char *fmt, ...) {
+
+	va_list args;
+	int 	room = RENDER_FRAME_SIZE - renderer->length;
+	int 	written;
+
+	va_start(args, fmt);
+	written = vsnprintf(renderer->frame + renderer->length, room, fmt, args);
+	va_end(args);
+
+	if (written > 0) renderer->length += written < room ? written : room - 1;
+
+}
+/**
+ * @brief      Place le curseur, sauf s'il y est déjà
+ */
+static void moveTo(renderer_t *renderer, int row, int col) {
+
+	if (renderer->row == row && renderer->col == col) return;
+
+	emit(renderer, "\033[%d;%dH", row, col);
+
+	renderer->row = row;
+	renderer->col = col;
+
+}
+/**
+ * @brief      Caractère d'une case : '#' navire intact, 'X' touché, 'o' tir dans l'eau
+ *
+ * @param      board  la grille
+ * @param[in]  cell   la case
+ *
+ * @return     le caractère
+ */
+char boardCellChar(board_t *board, int cell) {
+
+	bitboard_t bit = BIT(cell);
+
+	if (board->shots & bit) 	return board->fleet & bit ? 'X' : 'o';
+	if (board->fleet & bit) 	return '#';
+
+	return '.';
+
+}
+/**
+ * @brief      Crée un écran, la première image sera complète
+ *
+ * @param      renderer  l'écran à initialiser
+ * @param[in]  fd        descripteur du terminal
+ */
+void createRenderer(renderer_t *renderer, int fd) {
+
+	memset(renderer->back, '.', sizeof(renderer->back));
+	renderer->backStatus[0] = '\0';
+	renderer->fd 			= fd;
+	renderer->length 		= 0;
+
+	invalidateRenderer(renderer);
+
+}
+/**
+ * @brief      Force une image complète, quand le terminal a été écrit par ailleurs
+ *
+ * @param      renderer  l'écran
+ */
+void invalidateRenderer(renderer_t *renderer) {
+
+	renderer->valid = 0;
+	renderer->row 	= 0;
+	renderer->col 	= 0;
+
+}
+/**
+ * @brief      Dessine une partie dans le tampon arrière
+ *
+ * @param      renderer  l'écran
+ * @param      match     la partie
+ */
+void drawMatch(renderer_t *renderer, match_t *match) {
+
+	int length;
+
+	for (int p = 0; p < 2; p++) {
+		for (int cell = 0; cell < BOARD_CELLS; cell++) {
+			renderer->back[p][cell] = boardCellChar(&match->boards[p], cell);
+		}
+	}
+
+	length = snprintf(renderer->backStatus, RENDER_STATUS_SIZE, "Tirs: %u, au trait: joueur %d",
+		match->turn, match->current);
+
+	if (match->winner != NO_WINNER && length < RENDER_STATUS_SIZE)
+		snprintf(renderer->backStatus + length, RENDER_STATUS_SIZE - length, ", vainqueur: joueur %d", match->winner);
+
+}
+/**
+ * @brief      Envoie les différences entre les tampons en un seul write, puis les échange
+ *
+ * @param      renderer  l'écran
+ *
+ * @return     le nombre d'octets écrits, -1 en cas d'erreur
+ */
+int presentFrame(renderer_t *renderer) {
+
+	int left[2] = {RENDER_LEFT_0, RENDER_LEFT_1};
+	int sent 	= 0;
+
+	renderer->length = 0;
+
+	// image complète : cadre, puis toutes les cases comme si elles avaient changé
+	if (!renderer->valid) {
+
+		emit(renderer, "\033[H\033[2J");
+		emit(renderer, "    Joueur 0             Joueur 1\r\n");
+		emit(renderer, "    0123456789           0123456789\r\n");
+
+		for (int y = 0; y < BOARD_SIZE; y++) {
+			emit(renderer, "\033[%d;1H%2d\033[%d;%dH%2d", RENDER_TOP + y, y, RENDER_TOP + y, RENDER_LEFT_1 - 4, y);
+		}
+
+		memset(renderer->front, 0, sizeof(renderer->front));
+		renderer->frontStatus[0] 	= '\0';
+		renderer->row 				= 0;
+		renderer->col 				= 0;
+
+	}
+
+	for (int p = 0; p < 2; p++) {
+
+		for (int cell = 0; cell < BOARD_CELLS; cell++) {
+
+			if (renderer->front[p][cell] == renderer->back[p][cell]) continue;
+
+			// cases voisines d'une rangée : le curseur y est déjà
+			moveTo(renderer, RENDER_TOP + cell / BOARD_SIZE, left[p] + cell % BOARD_SIZE);
+			emit(renderer, "%c", renderer->back[p][cell]);
+			renderer->col++;
+
+		}
+
+	}
+
+	if (!renderer->valid || strcmp(renderer->frontStatus, renderer->backStatus) != 0) {
+		moveTo(renderer, RENDER_STATUS_ROW, 1);
+		emit(renderer, "%s\033[K", renderer->backStatus);
+		renderer->col = 0;
+	}
+
+	// rien n'a changé : pas d'écriture
+	if (renderer->length == 0) return 0;
+
+	// curseur rangé sous les grilles pour les affichages suivants
+	moveTo(renderer, RENDER_STATUS_ROW + 1, 1);
+
+	while (sent < renderer->length) {
+
+		int result = write(renderer->fd, renderer->frame + sent, renderer->length - sent);
+
+		if (result == -1 && errno == EINTR) continue;
+		if (result == -1) return -1;
+
+		sent += result;
+
+	}
+
+	memcpy(renderer->front, renderer->back, sizeof(renderer->front));
+	strcpy(renderer->frontStatus, renderer->backStatus);
+	renderer->valid = 1;
+
+	return sent;
+
+}
@@ -17,17 +17,64 @@
  */
 #define REQ_STR_OUT "%i:%hhu:%s"
 /**
- * @brief format de désérialisation des requêtes
+ * @brief format de désérialisation des requêtes (largeur : DATA_LENGTH, \0 non compris)
  */
-#define REQ_STR_IN "%i:%hhu:%[^\n]"
+#define REQ_STR_IN "%hi:%hhu:%99[^\n]"
 /**
  * @brief format de sérialisation des réponses
  */
 #define REP_STR_OUT "%i:%s"
 /**
- * @brief format de désérialisation des réponses
+ * @brief format de désérialisation des réponses (largeur : DATA_LENGTH, \0 non compris)
  */
-#define REP_STR_IN "%i:%[^\n]"
+#define REP_STR_IN "%hi:%99[^\n]"
+/**
+ * @brief format de l'en-tête d'une requête (status et verbe), suivi des données
+ */
+#define REQ_HDR_OUT "%i:%hhu:"
+/**
+ * @brief format de l'en-tête d'une réponse (status), suivi des données
+ */
+#define REP_HDR_OUT "%i:"
+/**
+ * @brief taille maximum d'un en-tête de requête/réponse
+ */
+#define HDR_LENGTH 16
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S   L O C A L E S
+ */
+/**
+ * @brief      Découpe un message déjà formaté en en-tête + données + \0, sans recopier
+ *             les données si elles sont déjà une chaîne de caractères
+ *
+ * @param      morceaux  les 3 morceaux à remplir
+ * @param      entete    l'en-tête formaté (REQ_HDR_OUT ou REP_HDR_OUT)
+ * @param      payload   buffer de sérialisation des données (utilisé si serial != NULL)
+ * @param[in]  data      les données
+ * @param[in]  serial    la fonction de sérialisation des données (NULL si char *)
+ *
+ * @return     le nombre de morceaux
+ */
+static int encodeMessage(struct iovec *morceaux, char *entete, char *payload, generic data, pFct serial) {
+
+	static char fin = '\0';
+
+	// sérialisation directement dans le buffer final : pas de passage par req_t/rep_t
+	if (serial != NULL) serial(data, payload);
+	else payload = data;
+
+	morceaux[0].iov_base 	= entete;
+	morceaux[0].iov_len 	= strlen(entete);
+	morceaux[1].iov_base 	= payload;
+	// le destinataire ne peut pas stocker plus que DATA_LENGTH octets
+	morceaux[1].iov_len 	= strnlen(payload, DATA_LENGTH - 1);
+	morceaux[2].iov_base 	= &fin;
+	morceaux[2].iov_len 	= 1;
+
+	return 3;
+
+}
 /*
 *****************************************************************************************
  *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
@@ -95,7 +142,9 @@ void req2str(req_t *req, char *str) {
  * \param      req  pointeur vers la struct à remplir
  */
 void str2req(char *str, req_t *req) {
-	sscanf(str, REQ_STR_IN, &req->id, &req->verb, &req->data);
+	// données absentes : rien d'une requête précédente ne doit rester
+	req->data[0] = '\0';
+	sscanf(str, REQ_STR_IN, &req->id, &req->verb, req->data);
 	
 }
 /**
@@ -115,7 +164,8 @@ void rep2str(rep_t *rep, char *str) {
  * \param      rep  pointeur vers la struct à remplir
  */
 void str2rep(char *str, rep_t *rep) {
-	sscanf(str, REP_STR_IN, &rep->id, &rep->data);
+	rep->data[0] = '\0';
+	sscanf(str, REP_STR_IN, &rep->id, rep->data);
 	
 }
 /**
@@ -128,9 +178,19 @@ void str2rep(char *str, rep_t *rep) {
  * @param[in]  serial     la fonction de sérialisation des données (NULL si char *)
  */
 void sendRequest(socket_t *sockAppel, int status, uint8_t verb, generic data, pFct serial) {
-	req_t request = creerRequete(status, verb, data, serial);
 
-	envoyer(sockAppel,(generic) &request, (pFct) req2str);
+	if (sockAppel->mode != SOCK_STREAM) {
+		req_t request = creerRequete(status, verb, data, serial);
+		envoyer(sockAppel,(generic) &request, (pFct) req2str);
+		return;
+	}
+
+	char 			entete[HDR_LENGTH];
+	buffer_t 		payload;
+	struct iovec 	morceaux[3];
+
+	sprintf(entete, REQ_HDR_OUT, status, verb);
+	envoyerIov(sockAppel, morceaux, encodeMessage(morceaux, entete, payload, data, serial));
 }
 /**
  * @brief      Envoyer une réponse à partir d'arguments
@@ -141,19 +201,63 @@ void sendRequest(socket_t *sockAppel, int status, uint8_t verb, generic data, pF
  * @param[in]  serial    la fonction de sérialisation des données (NULL si char *)
  */
 void sendResponse(socket_t *sockDial, int status, generic data, pFct serial) {
-	rep_t response = creerReponse(status, data, serial);
 
-	envoyer(sockDial, (generic) &response, (pFct) rep2str);
+	if (sockDial->mode != SOCK_STREAM) {
+		rep_t response = creerReponse(status, data, serial);
+		envoyer(sockDial, (generic) &response, (pFct) rep2str);
+		return;
+	}
+
+	char 			entete[HDR_LENGTH];
+	buffer_t 		payload;
+	struct iovec 	morceaux[3];
+
+	sprintf(entete, REP_HDR_OUT, status);
+	envoyerIov(sockDial, morceaux, encodeMessage(morceaux, entete, payload, data, serial));
+}
+/**
+ * @brief      Empiler une réponse dans le buffer d'émission de la socket
+ *
+ * @param      sockDial  la socket de dialogue
+ * @param[in]  status    le status de la réponse
+ * @param[in]  data      les données de la réponse
+ * @param[in]  serial    la fonction de sérialisation des données (NULL si char *)
+ */
+void queueResponse(socket_t *sockDial, int status, generic data, pFct serial) {
+
+	if (sockDial->mode != SOCK_STREAM) {
+		sendResponse(sockDial, status, data, serial);
+		return;
+	}
+
+	char 			entete[HDR_LENGTH];
+	buffer_t 		payload;
+	struct iovec 	morceaux[3];
+
+	sprintf(entete, REP_HDR_OUT, status);
+	empilerIov(sockDial, morceaux, encodeMessage(morceaux, entete, payload, data, serial));
+}
+/**
+ * @brief      Émettre en un seul appel système les réponses empilées
+ *
+ * @param      sockDial  la socket de dialogue
+ */
+void flushResponses(socket_t *sockDial) {
+
+	if (sockDial->mode == SOCK_STREAM) viderSortie(sockDial);
+
 }
 /**
  * @brief      Recevoir une requête
  *
  * @param      sockDial  socket de dialogue
  * @param      request   pointeur vers la struct request à remplir
+ *
+ * @return     0 si la connexion a été fermée, 1 sinon
  */
-void rcvRequest(socket_t *sockDial, req_t *request) {
+int rcvRequest(socket_t *sockDial, req_t *request) {
 
-	recevoir(sockDial,(generic) request, (pFct) str2req);
+	if (!recevoir(sockDial,(generic) request, (pFct) str2req)) return 0;
 
 #ifdef DEBUG_ENABLED
 	logMessage("[%i] %hhu : %s\n"
@@ -163,15 +267,47 @@ void rcvRequest(socket_t *sockDial, req_t *request) {
 		, request->data
 	);
 #endif
+
+	return 1;
+}
+/**
+ * @brief      Extraire une requête déjà reçue par le moteur d'E/S, sans lecture
+ *
+ * @param      sockDial  socket de dialogue
+ * @param      request   pointeur vers la struct request à remplir
+ *
+ * @return     1 si une requête complète a été extraite, 0 sinon
+ */
+int extractRequest(socket_t *sockDial, req_t *request) {
+
+	buffer_t buff;
+
+	if (!extraireMessage(sockDial, buff, MAX_BUFFER)) return 0;
+
+	str2req(buff, request);
+
+#ifdef DEBUG_ENABLED
+	logMessage("[%i] %hhu : %s\n"
+		, DEBUG
+		, request->id
+		, request->verb
+		, request->data
+	);
+#endif
+
+	return 1;
 }
 /**
  * @brief      Recevoir une réponse
  *
  * @param      sockAppel  la socket d'appel
  * @param      response   pointeur vers la struct rep_t à remplir
+ *
+ * @return     0 si la connexion a été fermée, 1 sinon
  */
-void rcvResponse(socket_t *sockAppel, rep_t *response) {
-	recevoir(sockAppel,(generic) response, (pFct) str2rep);
+int rcvResponse(socket_t *sockAppel, rep_t *response) {
+
+	if (!recevoir(sockAppel,(generic) response, (pFct) str2rep)) return 0;
 
 #ifdef DEBUG_ENABLED
 	logMessage("[%i] %s\n"
@@ -180,4 +316,6 @@ void rcvResponse(socket_t *sockAppel, rep_t *response) {
 		, response->data
 	);
 #endif
+
+	return 1;
 }
@@ -0,0 +1,349 @@
+/**
+ *	\file		replay.c
+ *	\brief		Fichier implémentation du journal binaire des parties et de sa relecture
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "replay.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   M A C R O S
+ */
+/**
+ * @brief position (relative au premier tir) du tir numéro t, points de reprise compris
+ */
+#define SHOT_AT(t) 		((t) + REPLAY_CHECKPOINT_SIZE * ((t) / REPLAY_PERIOD))
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Écrit les enregistrements en attente à la fin du fichier
+ */
+static void flushReplay(replayLog_t *log) {
+
+	char 	*data 	= (char *) log->pending;
+	size_t 	rest 	= log->amount * sizeof(replayRecord_t);
+
+	while (rest > 0) {
+
+		ssize_t written = write(log->fd, data, rest);
+
+		if (written == -1 && errno == EINTR) continue;
+		if (written == -1) {
+			perror("Can't write replay");
+			break;
+		}
+
+		data += written;
+		rest -= written;
+
+	}
+
+	log->amount = 0;
+
+}
+/**
+ * @brief      Ajoute un enregistrement au journal
+ */
+static void pushRecord(replayLog_t *log, uint8_t type, uint8_t player, uint8_t cell, uint8_t arg, uint32_t value) {
+
+	if (log->amount == REPLAY_BUFFER) flushReplay(log);
+
+	log->pending[log->amount++] = (replayRecord_t) {type, player, cell, arg, value};
+
+}
+/**
+ * @brief      Ouvre un journal en ajout
+ *
+ * @param      log   le journal
+ * @param      path  chemin du fichier (créé au besoin)
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openReplayLog(replayLog_t *log, const char *path) {
+
+	log->amount = 0;
+	log->fd 	= open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+
+	return log->fd == -1 ? -1 : 0;
+
+}
+/**
+ * @brief      Écrit les enregistrements en attente et ferme le journal
+ *
+ * @param      log   le journal
+ */
+void closeReplayLog(replayLog_t *log) {
+
+	if (log->fd == -1) return;
+
+	flushReplay(log);
+	close(log->fd);
+
+	log->fd = -1;
+
+}
+/**
+ * @brief      Commence une partie dans le journal
+ *
+ * @param      log   le journal
+ * @param[in]  id    identifiant de la partie
+ */
+void startReplay(replayLog_t *log, uint32_t id) {
+
+	pushRecord(log, REPLAY_START, 0, 0, REPLAY_VERSION, id);
+
+}
+/**
+ * @brief      Journalise le placement d'un navire
+ */
+void logPlacement(replayLog_t *log, int player, int ship, int cell, int vertical) {
+
+	pushRecord(log, REPLAY_PLACE, player, cell, ship | (vertical ? 0x80 : 0), 0);
+
+}
+/**
+ * @brief      Journalise un tir valide, précédé d'un point de reprise si besoin
+ *
+ * @param      log     le journal
+ * @param      match   la partie, avant le tir
+ * @param[in]  player  le tireur
+ * @param[in]  cell    la case visée
+ * @param[in]  result  le résultat du tir
+ */
+void logShot(replayLog_t *log, match_t *match, int player, int cell, shotResult_t result) {
+
+	if (match->turn > 0 && match->turn % REPLAY_PERIOD == 0) {
+
+		// un bloc complet part en une écriture, le point de reprise ouvre le suivant
+		flushReplay(log);
+
+		pushRecord(log, REPLAY_CHECKPOINT, match->current, 0, 0, match->turn);
+
+		memcpy(&log->pending[log->amount], &match->boards[0].shots, sizeof(bitboard_t));
+		memcpy(&log->pending[log->amount + 2], &match->boards[1].shots, sizeof(bitboard_t));
+		log->amount += REPLAY_CHECKPOINT_SIZE - 1;
+
+	}
+
+	pushRecord(log, REPLAY_SHOT, player, cell, result, match->turn);
+
+}
+/**
+ * @brief      Termine la partie dans le journal et l'écrit
+ *
+ * @param      log     le journal
+ * @param      match   la partie (winner NO_WINNER : abandon)
+ */
+void endReplay(replayLog_t *log, match_t *match) {
+
+	pushRecord(log, REPLAY_END, match->winner == NO_WINNER ? 0xFF : match->winner, 0, 0, match->turn);
+	flushReplay(log);
+
+}
+/**
+ * @brief      Ouvre un fichier de parties en lecture
+ *
+ * @param      file  le fichier
+ * @param      path  son chemin
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openReplay(replayFile_t *file, const char *path) {
+
+	struct stat st;
+	void 		*map 	= NULL;
+	int 		fd 		= open(path, O_RDONLY);
+
+	file->records 	= NULL;
+	file->amount 	= 0;
+
+	if (fd == -1) return -1;
+
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return -1;
+	}
+
+	// un enregistrement tronqué en fin de fichier (arrêt brutal) est ignoré
+	if (st.st_size >= (off_t) sizeof(replayRecord_t)) {
+
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (map == MAP_FAILED) {
+			close(fd);
+			return -1;
+		}
+
+	}
+
+	// la projection reste valide une fois le descripteur fermé
+	close(fd);
+
+	file->records 	= map;
+	file->amount 	= map != NULL ? st.st_size / sizeof(replayRecord_t) : 0;
+
+	return 0;
+
+}
+/**
+ * @brief      Ferme un fichier de parties
+ *
+ * @param      file  le fichier
+ */
+void closeReplay(replayFile_t *file) {
+
+	if (file->records != NULL) munmap((void *) file->records, file->amount * sizeof(replayRecord_t));
+
+	file->records 	= NULL;
+	file->amount 	= 0;
+
+}
+/**
+ * @brief      Trouve la partie suivante d'un fichier
+ *
+ * @param      file  le fichier
+ * @param      pos   position de la recherche, avancée après la partie trouvée
+ * @param      game  la partie trouvée
+ *
+ * @return     1 si une partie a été trouvée, 0 à la fin du fichier
+ *
+ * @note       saute d'un point de reprise à l'autre sans lire les tirs
+ */
+int nextReplayGame(replayFile_t *file, size_t *pos, replayGame_t *game) {
+
+	const replayRecord_t 	*records 	= file->records;
+	size_t 					i 			= *pos;
+	size_t 					base;
+	uint32_t 				turn 		= 0;
+
+	// une partie interrompue par un arrêt brutal est suivie d'un START : on s'y recale
+	for (;; i++) {
+
+		int placed = 0;
+
+		while (i < file->amount && records[i].type != REPLAY_START) i++;
+
+		if (i + REPLAY_HEADER > file->amount) {
+			*pos = file->amount;
+			return 0;
+		}
+
+		while (placed < 2 * FLEET_SIZE && records[i + 1 + placed].type == REPLAY_PLACE) placed++;
+
+		if (placed == 2 * FLEET_SIZE) break;
+
+	}
+
+	game->start 	= &records[i];
+	game->id 		= records[i].value;
+	game->winner 	= NO_WINNER;
+
+	base = i + REPLAY_HEADER;
+
+	// un bloc est complet si son dernier tir est à sa place
+	for (;;) {
+
+		size_t last = base + SHOT_AT(turn + REPLAY_PERIOD - 1);
+
+		if (last >= file->amount
+			|| records[last].type != REPLAY_SHOT
+			|| records[last].value != turn + REPLAY_PERIOD - 1) break;
+
+		turn += REPLAY_PERIOD;
+
+	}
+
+	// dernier bloc : point de reprise éventuel puis au plus REPLAY_PERIOD - 1 tirs
+	i = base + SHOT_AT(turn);
+	if (turn > 0) {
+		i -= REPLAY_CHECKPOINT_SIZE;
+		if (i < file->amount && records[i].type == REPLAY_CHECKPOINT) i += REPLAY_CHECKPOINT_SIZE;
+	}
+
+	if (i > file->amount) i = file->amount;
+
+	while (i < file->amount && records[i].type == REPLAY_SHOT) {
+		turn++;
+		i++;
+	}
+
+	if (i < file->amount && records[i].type == REPLAY_END) {
+		if (records[i].player != 0xFF) game->winner = records[i].player;
+		i++;
+	}
+
+	game->turns 	= turn;
+	game->length 	= i - (game->start - records);
+	*pos 			= i;
+
+	return 1;
+
+}
+/**
+ * @brief      Reconstruit une partie après un nombre de tirs donné
+ *
+ * @param      game   la partie
+ * @param[in]  turn   nombre de tirs à rejouer (borné à game->turns)
+ * @param      match  la partie reconstruite (sans journal)
+ *
+ * @note       part du point de reprise précédent : au plus REPLAY_PERIOD - 1 tirs rejoués
+ */
+void replayMatchAt(replayGame_t *game, uint32_t turn, match_t *match) {
+
+	const replayRecord_t 	*shots 	= game->start + REPLAY_HEADER;
+	size_t 					amount 	= game->length - REPLAY_HEADER;
+	uint32_t 				block;
+
+	createMatch(match, NULL);
+
+	for (int i = 1; i < REPLAY_HEADER; i++) {
+
+		const replayRecord_t *record = &game->start[i];
+
+		if (record->type == REPLAY_PLACE)
+			placeShip(match, record->player, record->arg & 0x7F, record->cell, record->arg >> 7);
+
+	}
+
+	if (turn > game->turns) turn = game->turns;
+
+	// une partie finie sur un multiple de REPLAY_PERIOD n'a pas de dernier point de reprise
+	block = turn / REPLAY_PERIOD;
+	if (block > 0 && (SHOT_AT(block * REPLAY_PERIOD) > amount
+		|| shots[SHOT_AT(block * REPLAY_PERIOD) - REPLAY_CHECKPOINT_SIZE].type != REPLAY_CHECKPOINT))
+		block--;
+
+	if (block > 0) {
+
+		const replayRecord_t *checkpoint = &shots[SHOT_AT(block * REPLAY_PERIOD) - REPLAY_CHECKPOINT_SIZE];
+
+		memcpy(&match->boards[0].shots, checkpoint + 1, sizeof(bitboard_t));
+		memcpy(&match->boards[1].shots, checkpoint + 3, sizeof(bitboard_t));
+		match->current 	= checkpoint->player;
+		match->turn 	= checkpoint->value;
+
+	}
+
+	while (match->turn < turn) {
+
+		const replayRecord_t *shot = &shots[SHOT_AT(match->turn)];
+
+		match->boards[1 - shot->player].shots |= BIT(shot->cell);
+		match->current = 1 - shot->player;
+		match->turn++;
+
+	}
+
+	if (turn == game->turns) match->winner = game->winner;
+
+}
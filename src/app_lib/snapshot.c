@@ -0,0 +1,188 @@
+/**
+ *	\file		snapshot.c
+ *	\brief		Fichier implémentation des instantanés du registre des clients
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Ouvre (ou crée) un fichier d'instantané et le projette en mémoire
+ *
+ * @param      snap      l'instantané à initialiser
+ * @param      path      chemin du fichier
+ * @param[in]  capacity  taille du registre
+ * @param[in]  wait      attendre qu'une autre instance le libère plutôt qu'échouer
+ *
+ * @return     0 en cas de succès, -1 sinon (errno positionné, EWOULDBLOCK si une
+ *             autre instance le tient)
+ *
+ * @note       le fichier est verrouillé jusqu'à closeSnapshot : deux serveurs ne
+ *             peuvent écrire le même instantané
+ */
+int openSnapshot(registrySnapshot_t *snap, char *path, int capacity, int wait) {
+
+	struct stat st;
+	size_t 		size = sizeof(snapshotHeader_t) + capacity * sizeof(snapshotRecord_t);
+	void 		*map;
+
+	snap->header = NULL;
+
+	snap->fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (snap->fd == -1) return -1;
+
+	if (flock(snap->fd, wait ? LOCK_EX : LOCK_EX | LOCK_NB) == -1) {
+		close(snap->fd);
+		return -1;
+	}
+
+	// un fichier neuf (ou plus petit) est complété par des zéros : signature absente
+	if (fstat(snap->fd, &st) == -1
+		|| (st.st_size < (off_t) size && ftruncate(snap->fd, size) == -1)) {
+		close(snap->fd);
+		return -1;
+	}
+
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, snap->fd, 0);
+	if (map == MAP_FAILED) {
+		close(snap->fd);
+		return -1;
+	}
+
+	snap->header 	= map;
+	snap->records 	= (snapshotRecord_t *) (snap->header + 1);
+	snap->size 		= size;
+	snap->capacity 	= capacity;
+
+	return 0;
+
+}
+/**
+ * @brief      Restaure un registre depuis un instantané
+ *
+ * @param      snap     l'instantané ouvert
+ * @param      clients  le registre à remplir
+ * @param[in]  size     taille du registre
+ *
+ * @return     le nombre de clients restaurés
+ * 
+ * @note       les clients restaurés sont PENDING : ils attendent la reconnexion de
+ * 			   leur propriétaire. Un instantané absent, d'un autre format ou
+ * 			   interrompu en cours d'écriture ne restaure rien.
+ */
+int loadSnapshot(registrySnapshot_t *snap, clientInfo_t *clients, int size) {
+
+	snapshotHeader_t 	*header = snap->header;
+	int 				restored = 0;
+	int 				amount;
+
+	if (header == NULL
+		|| header->magic != SNAPSHOT_MAGIC
+		|| header->version != SNAPSHOT_VERSION
+		|| header->recordSize != sizeof(snapshotRecord_t)
+		|| header->generation % 2 == 1) return 0;
+
+	// le registre a pu changer de taille entre deux lancements
+	amount = header->capacity;
+	if (amount > size) 				amount = size;
+	if (amount > snap->capacity) 	amount = snap->capacity;
+
+	for (int i = 0; i < amount; i++) {
+
+		snapshotRecord_t *record = &snap->records[i];
+
+		// une connexion en cours n'a pas encore d'infos valides
+		if (record->status != CONNECTED && record->status != PENDING) continue;
+
+		memcpy(clients[i].name, record->name, PSEUDO_SIZE);
+		memcpy(clients[i].address, record->address, ADDR_SIZE);
+		memcpy(clients[i].peer, record->peer, ADDR_SIZE);
+		clients[i].name[PSEUDO_SIZE - 1] 	= '\0';
+		clients[i].address[ADDR_SIZE - 1] 	= '\0';
+		clients[i].peer[ADDR_SIZE - 1] 		= '\0';
+		clients[i].role 	= record->role;
+		clients[i].port 	= record->port;
+		clients[i].status 	= PENDING;
+
+		restored++;
+
+	}
+
+	return restored;
+
+}
+/**
+ * @brief      Écrit le registre dans l'instantané
+ *
+ * @param      snap     l'instantané ouvert
+ * @param      clients  le registre
+ * @param[in]  size     taille du registre
+ * 
+ * @note       sans effet si aucun instantané n'est ouvert
+ */
+void saveSnapshot(registrySnapshot_t *snap, clientInfo_t *clients, int size) {
+
+	snapshotHeader_t *header = snap->header;
+
+	if (header == NULL) return;
+
+	if (size > snap->capacity) size = snap->capacity;
+
+	// génération impaire : un arrêt brutal pendant l'écriture invalide l'instantané
+	if (header->magic != SNAPSHOT_MAGIC) header->generation = 0;
+	header->generation |= 1;
+	__sync_synchronize();
+
+	header->magic 		= SNAPSHOT_MAGIC;
+	header->version 	= SNAPSHOT_VERSION;
+	header->recordSize 	= sizeof(snapshotRecord_t);
+	header->capacity 	= size;
+	header->savedAt 	= time(NULL);
+
+	for (int i = 0; i < size; i++) {
+
+		snapshotRecord_t *record = &snap->records[i];
+
+		memcpy(record->name, clients[i].name, PSEUDO_SIZE);
+		memcpy(record->address, clients[i].address, ADDR_SIZE);
+		memcpy(record->peer, clients[i].peer, ADDR_SIZE);
+		record->status 	= clients[i].status;
+		record->role 	= clients[i].role;
+		record->port 	= clients[i].port;
+
+	}
+
+	__sync_synchronize();
+	header->generation++;
+
+	// la projection survit au processus, msync la pousse vers le disque sans attendre
+	msync(header, snap->size, MS_ASYNC);
+
+}
+/**
+ * @brief      Ferme un instantané (la projection est écrite sur le disque)
+ *
+ * @param      snap  l'instantané
+ */
+void closeSnapshot(registrySnapshot_t *snap) {
+
+	if (snap->header == NULL) return;
+
+	msync(snap->header, snap->size, MS_SYNC);
+	munmap(snap->header, snap->size);
+	close(snap->fd);
+
+	snap->header = NULL;
+
+}
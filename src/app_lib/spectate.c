@@ -0,0 +1,551 @@
+/**
+ *	\file		spectate.c
+ *	\brief		Fichier implémentation du relais des parties en cours vers leurs spectateurs
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "repReq.h"
+#include "protocol.h"
+#include "spectate.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Rend une référence sur un événement, libéré à la dernière
+ */
+static void releaseEvent(spectateEvent_t *event) {
+
+	if (event != NULL && --event->refs == 0) free(event);
+
+}
+/**
+ * @brief      Recherche une partie par le nom de son hôte
+ */
+static spectateGame_t *findGame(spectateRelay_t *relay, char *host) {
+
+	for (spectateGame_t *game = relay->games; game != NULL; game = game->next) {
+
+		if (strcmp(game->host, host) == 0) return game;
+
+	}
+
+	return NULL;
+
+}
+/**
+ * @brief      Recopie le reste d'un événement entamé devant le buffer d'émission du
+ *             spectateur, puis rend l'événement
+ */
+static void spillPartial(spectateSub_t *sub) {
+
+	socket_t 	*sock 	= sub->sock;
+	int 		rest;
+
+	if (sub->partial == NULL) return;
+
+	rest = sub->partial->len - sub->offset;
+
+	// tant qu'un événement est entamé, le buffer d'émission n'a pas commencé à partir
+	// et ne contient que des réponses entières : faute de place, abandonner les plus
+	// anciennes une à une, le reste de l'événement tenant toujours dans le buffer
+	while (sock->nbSortie > 0 && sock->nbSortie + rest > TAILLE_SORTIE) {
+
+		char 	*end 	= memchr(sock->sortie, '\0', sock->nbSortie);
+		int 	size 	= end == NULL ? sock->nbSortie : end - sock->sortie + 1;
+
+		sock->nbSortie -= size;
+		memmove(sock->sortie, sock->sortie + size, sock->nbSortie);
+
+	}
+
+	memmove(sock->sortie + rest, sock->sortie, sock->nbSortie);
+	memcpy(sock->sortie, sub->partial->data + sub->offset, rest);
+	sock->nbSortie += rest;
+
+	releaseEvent(sub->partial);
+	sub->partial = NULL;
+
+}
+/**
+ * @brief      Événement du cycle de vie porté par un événement publié
+ */
+static flowEvent_t flowEventOf(short status) {
+
+	switch (getAction(status)) {
+
+		case CURRENT_PLAYER: 	return FLOW_TURN;
+		case CELL: 				return FLOW_SHOT;
+		default: 				return FLOW_SNAPSHOT;
+
+	}
+
+}
+/**
+ * @brief      Crée un événement déjà encodé, avec une référence
+ *
+ * @return     l'événement, NULL s'il n'a pu être alloué
+ */
+static spectateEvent_t *createEvent(uint32_t seq, const char *encoded, int len) {
+
+	spectateEvent_t *event = malloc(sizeof(spectateEvent_t) + len);
+
+	if (event == NULL) return NULL;
+
+	event->refs = 1;
+	event->seq 	= seq;
+	event->len 	= len;
+	memcpy(event->data, encoded, len);
+
+	return event;
+
+}
+/**
+ * @brief      Encode un événement, le range dans l'anneau de la partie et l'émet
+ *             vers ses spectateurs
+ *
+ * @return     0, -1 si l'événement n'a pu être alloué
+ */
+static int pushEvent(spectateGame_t *game, short status, char *data) {
+
+	spectateEvent_t *event;
+	spectateEvent_t **slot;
+	rep_t 			response;
+	char 			encoded[MAX_BUFFER];
+
+	// encodé une seule fois, quel que soit le nombre de spectateurs
+	response = creerReponse(status, data, NULL);
+	rep2str(&response, encoded);
+
+	event = createEvent(game->published, encoded, strlen(encoded) + 1);
+	if (event == NULL) return -1;
+
+	game->published++;
+
+	slot = &game->ring[event->seq % SPECTATE_RING];
+	releaseEvent(*slot);
+	*slot = event;
+
+	if (status == enum2status(ACK, GAME)) {
+		releaseEvent(game->snapshot);
+		game->snapshot = event;
+		event->refs++;
+	}
+
+	for (spectateSub_t *sub = game->subs; sub != NULL; sub = sub->next) flushSubscriber(sub);
+
+	return 0;
+
+}
+/**
+ * @brief      Termine tous les abonnements d'une partie et la libère
+ */
+static void closeGame(spectateRelay_t *relay, spectateGame_t *game) {
+
+	while (game->subs != NULL) {
+
+		void *owner = game->subs->owner;
+
+		unsubscribeGame(game->subs);
+		relay->onEnded(owner);
+
+	}
+
+	cancelTimer(&relay->wheel, &game->flow.deadline);
+
+	for (int i = 0; i < SPECTATE_RING; i++) releaseEvent(game->ring[i]);
+	releaseEvent(game->snapshot);
+
+	if (game->prev != NULL) game->prev->next = game->next;
+	else 					relay->games = game->next;
+	if (game->next != NULL) game->next->prev = game->prev;
+
+	free(game);
+
+}
+/**
+ * @brief      Échéance d'une partie dépassée : forfait du joueur au trait ou abandon
+ */
+static void onGameDeadline(wheelTimer_t *timer) {
+
+	spectateGame_t 	*game = timer->owner;
+	char 			reason[DATA_LENGTH];
+
+	if (game->flow.state == GAME_PLAYING && game->flow.owner[0] != '\0')
+		snprintf(reason, sizeof(reason), FORFEIT_FMT, game->flow.owner);
+	else
+		snprintf(reason, sizeof(reason), STALLED_FMT, flowStateName(game->flow.state));
+
+	stepFlow(&game->flow, &game->relay->wheel, FLOW_TIMEOUT, NULL);
+
+	// au pire, un spectateur en retard ne voit que la fin de la partie
+	pushEvent(game, enum2status(ACK, GAME), reason);
+	closeGame(game->relay, game);
+
+}
+/**
+ * @brief      Ouvre une partie sans événement, en attente d'adversaire
+ *
+ * @return     la partie, NULL si elle n'a pu être allouée
+ */
+static spectateGame_t *openGame(spectateRelay_t *relay, char *host) {
+
+	spectateGame_t *game = calloc(1, sizeof(spectateGame_t));
+
+	if (game == NULL) return NULL;
+
+	strncpy(game->host, host, PSEUDO_SIZE - 1);
+	game->relay 	= relay;
+	createFlow(&game->flow, &relay->wheel, onGameDeadline, game);
+
+	game->next 		= relay->games;
+	if (relay->games != NULL) relay->games->prev = game;
+	relay->games 	= game;
+
+	return game;
+
+}
+/**
+ * @brief      Prépare un relais sans partie
+ *
+ * @param      relay    le relais
+ * @param[in]  onEnded  action appelée pour chaque abonnement terminé par une fin de
+ *                      partie, une fois l'abonnement libéré
+ */
+void createRelay(spectateRelay_t *relay, void (*onEnded)(void *owner)) {
+
+	relay->games 	= NULL;
+	relay->onEnded 	= onEnded;
+
+	createWheel(&relay->wheel, wheelClock());
+
+}
+/**
+ * @brief      Publie un événement d'une partie (créée au premier événement) et
+ *             l'émet vers ses spectateurs
+ *
+ * @param      relay   le relais
+ * @param      host    nom de l'hôte de la partie
+ * @param[in]  status  code de la réponse émise aux spectateurs (GAME : instantané)
+ * @param      data    données de la réponse
+ *
+ * @return     0, -1 si l'événement est refusé par le cycle de vie de la partie ou
+ *             n'a pu être alloué
+ *
+ * @note       les spectateurs ne ralentissent jamais la partie : celui qui ne suit
+ *             pas saute au dernier instantané. Un tir (CELL) n'est permis qu'après
+ *             le premier changement de joueur (CURRENT_PLAYER).
+ */
+int publishEvent(spectateRelay_t *relay, char *host, short status, char *data) {
+
+	spectateGame_t 	*game = findGame(relay, host);
+
+	if (game == NULL) game = openGame(relay, host);
+	if (game == NULL) return -1;
+
+	if (stepFlow(&game->flow, &relay->wheel, flowEventOf(status), data) == FLOW_REFUSED) {
+
+		// une partie ouverte par un événement refusé n'a jamais existé
+		if (game->published == 0) closeGame(relay, game);
+		return -1;
+
+	}
+
+	return pushEvent(game, status, data);
+
+}
+/**
+ * @brief      Termine une partie et tous ses abonnements
+ *
+ * @param      relay  le relais
+ * @param      host   nom de l'hôte de la partie
+ * @param[in]  why    FLOW_END (fin par l'hôte) ou FLOW_LEAVE (départ de l'hôte)
+ *
+ * @note       le reste d'un événement entamé est recopié dans le buffer d'émission
+ *             de chaque spectateur avant l'appel de onEnded
+ */
+void endGame(spectateRelay_t *relay, char *host, flowEvent_t why) {
+
+	spectateGame_t *game = findGame(relay, host);
+
+	if (game == NULL) return;
+
+	stepFlow(&game->flow, &relay->wheel, why, NULL);
+	closeGame(relay, game);
+
+}
+/**
+ * @brief      Reprend une partie d'une autre instance (passation), sans événement
+ *
+ * @param      relay      le relais
+ * @param      host       nom de l'hôte de la partie
+ * @param[in]  state      état de la partie
+ * @param      owner      joueur au trait (vide : aucun)
+ * @param[in]  moves      nombre de coups joués
+ * @param[in]  published  nombre d'événements publiés
+ *
+ * @return     la partie, NULL si elle n'a pu être allouée
+ *
+ * @note       ses derniers événements sont ensuite repris par adoptEvent
+ */
+spectateGame_t *adoptGame(spectateRelay_t *relay, char *host, gameState_t state, char *owner, unsigned moves, uint32_t published) {
+
+	spectateGame_t *game = openGame(relay, host);
+
+	if (game == NULL) return NULL;
+
+	resumeFlow(&game->flow, &relay->wheel, state, owner, moves);
+	game->published = published;
+
+	return game;
+
+}
+/**
+ * @brief      Reprend un des derniers événements d'une partie reprise
+ *
+ * @param      game      la partie (adoptGame)
+ * @param[in]  seq       numéro de l'événement
+ * @param      encoded   réponse encodée
+ * @param[in]  len       taille de la réponse encodée, \0 compris
+ * @param[in]  snapshot  1 si c'est le dernier instantané de la partie
+ *
+ * @return     0, -1 si l'événement n'a pu être alloué
+ *
+ * @note       un événement sorti de l'anneau n'est gardé que s'il est l'instantané
+ */
+int adoptEvent(spectateGame_t *game, uint32_t seq, char *encoded, int len, int snapshot) {
+
+	// différence non signée : reste juste quand le compteur reboucle
+	int 			inRing 	= game->published - seq - 1 < SPECTATE_RING;
+	spectateEvent_t *event;
+
+	if (!inRing && !snapshot) return 0;
+
+	event = createEvent(seq, encoded, len);
+	if (event == NULL) return -1;
+
+	if (inRing) {
+		releaseEvent(game->ring[seq % SPECTATE_RING]);
+		game->ring[seq % SPECTATE_RING] = event;
+	}
+
+	if (snapshot) {
+		releaseEvent(game->snapshot);
+		game->snapshot = event;
+		if (inRing) event->refs++;
+	}
+
+	return 0;
+
+}
+/**
+ * @brief      Abonne un spectateur à une partie en cours
+ *
+ * @param      relay  le relais
+ * @param      host   nom de l'hôte de la partie
+ * @param      sock   socket du spectateur
+ * @param      owner  propriétaire de l'abonnement
+ *
+ * @return     l'abonnement, NULL si la partie n'existe pas
+ *
+ * @note       le spectateur reçoit le dernier instantané puis les événements suivants
+ */
+spectateSub_t *subscribeGame(spectateRelay_t *relay, char *host, socket_t *sock, void *owner) {
+
+	spectateGame_t 	*game = findGame(relay, host);
+	spectateSub_t 	*sub;
+
+	if (game == NULL) return NULL;
+
+	sub = malloc(sizeof(spectateSub_t));
+	if (sub == NULL) return NULL;
+
+	sub->game 		= game;
+	sub->sock 		= sock;
+	sub->owner 		= owner;
+	sub->partial 	= NULL;
+	sub->offset 	= 0;
+	sub->prev 		= NULL;
+	sub->next 		= game->subs;
+
+	// sans instantané : tout ce que l'anneau a gardé
+	if (game->snapshot != NULL) 				sub->cursor = game->snapshot->seq;
+	else if (game->published > SPECTATE_RING) 	sub->cursor = game->published - SPECTATE_RING;
+	else 										sub->cursor = 0;
+
+	if (game->subs != NULL) game->subs->prev = sub;
+	game->subs = sub;
+	game->subAmount++;
+
+	return sub;
+
+}
+/**
+ * @brief      Résilie un abonnement
+ *
+ * @param      sub   l'abonnement (libéré)
+ *
+ * @note       le reste d'un événement entamé est recopié devant le buffer d'émission
+ */
+void unsubscribeGame(spectateSub_t *sub) {
+
+	spectateGame_t *game = sub->game;
+
+	spillPartial(sub);
+
+	if (sub->prev != NULL) 	sub->prev->next = sub->next;
+	else 					game->subs = sub->next;
+	if (sub->next != NULL) 	sub->next->prev = sub->prev;
+	game->subAmount--;
+
+	free(sub);
+
+}
+/**
+ * @brief      Émet sans bloquer vers un spectateur ses réponses puis les événements
+ *             qu'il n'a pas encore reçus
+ *
+ * @param      sub   l'abonnement
+ *
+ * @return     1 s'il reste des données à émettre, 0 sinon
+ */
+int flushSubscriber(spectateSub_t *sub) {
+
+	spectateGame_t 	*game 	= sub->game;
+	socket_t 		*sock 	= sub->sock;
+	struct iovec 	iov[SPECTATE_IOV + 2];
+	spectateEvent_t *events[SPECTATE_IOV + 2];
+	uint32_t 		cursors[SPECTATE_IOV + 2];
+	uint32_t 		cursor 	= sub->cursor;
+	int 			nb 		= 0;
+	int 			sent;
+
+
+	// trop en retard : reprendre au dernier instantané, en tout cas au plus ancien gardé
+	if (game->published - cursor > SPECTATE_LAG
+		&& game->snapshot != NULL && game->snapshot->seq > cursor)
+		cursor = game->snapshot->seq;
+
+	if (game->published - cursor > SPECTATE_RING)
+		cursor = game->published - SPECTATE_RING;
+
+	// d'abord la fin de l'événement entamé, puis les réponses propres au spectateur
+	if (sub->partial != NULL) {
+		iov[nb] 	= (struct iovec) {sub->partial->data + sub->offset, sub->partial->len - sub->offset};
+		events[nb] 	= sub->partial;
+		cursors[nb++] = cursor;
+	}
+
+	if (sock->nbSortie > 0) {
+		iov[nb] 	= (struct iovec) {sock->sortie, sock->nbSortie};
+		events[nb] 	= NULL;
+		cursors[nb++] = cursor;
+	}
+
+	while (nb < SPECTATE_IOV + 2 && cursor != game->published) {
+
+		spectateEvent_t *event = game->ring[cursor % SPECTATE_RING];
+
+		iov[nb] 	= (struct iovec) {event->data, event->len};
+		events[nb] 	= event;
+		cursors[nb++] = ++cursor;
+
+	}
+
+	if (nb == 0) {
+		sub->cursor = cursor;
+		return 0;
+	}
+
+	sent = envoyerIovSansAttente(sock, iov, nb);
+
+	// erreur : la réception en cours signalera la fermeture
+	if (sent < 0) return 0;
+
+	for (int i = 0; i < nb; i++) {
+
+		int chunk = iov[i].iov_len;
+
+		if (sent >= chunk) {
+
+			sent -= chunk;
+
+			if (events[i] == NULL) 					sock->nbSortie = 0;
+			else if (events[i] == sub->partial) {
+				releaseEvent(sub->partial);
+				sub->partial = NULL;
+			}
+			sub->cursor = cursors[i];
+			continue;
+
+		}
+
+		// émission interrompue au milieu de ce morceau
+		if (events[i] == NULL) {
+			sock->nbSortie -= sent;
+			memmove(sock->sortie, sock->sortie + sent, sock->nbSortie);
+		}
+		else if (events[i] == sub->partial) {
+			sub->offset += sent;
+		}
+		else if (sent > 0) {
+			sub->partial 	= events[i];
+			sub->offset 	= sent;
+			sub->cursor 	= cursors[i];
+			events[i]->refs++;
+		}
+
+		return 1;
+
+	}
+
+	return sub->cursor != game->published;
+
+}
+/**
+ * @brief      Reprend l'émission vers les spectateurs en retard
+ *
+ * @param      relay  le relais
+ *
+ * @return     1 si des spectateurs restent en retard, 0 sinon
+ */
+int flushRelay(spectateRelay_t *relay) {
+
+	int late = 0;
+
+	for (spectateGame_t *game = relay->games; game != NULL; game = game->next) {
+
+		for (spectateSub_t *sub = game->subs; sub != NULL; sub = sub->next) {
+
+			if (sub->partial != NULL || sub->sock->nbSortie > 0 || sub->cursor != game->published)
+				late |= flushSubscriber(sub);
+
+		}
+
+	}
+
+	return late;
+
+}
+/**
+ * @brief      Termine les parties dont l'échéance est dépassée
+ *
+ * @param      relay  le relais
+ * @param[in]  now    l'instant présent (wheelClock)
+ *
+ * @return     le délai avant la prochaine échéance (ms), WHEEL_IDLE si aucune
+ *
+ * @note       le joueur au trait déclare forfait, une partie bloquée avant le premier
+ *             coup est abandonnée : un dernier instantané l'annonce aux spectateurs
+ */
+int expireGames(spectateRelay_t *relay, uint64_t now) {
+
+	advanceWheel(&relay->wheel, now);
+
+	return nextTimerDelay(&relay->wheel, now);
+
+}
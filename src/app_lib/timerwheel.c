@@ -0,0 +1,185 @@
+/**
+ *	\file		timerwheel.c
+ *	\brief		Fichier implémentation de la roue de minuteries partagée par les parties en cours
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <string.h>
+#include <time.h>
+#include "timerwheel.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone de la roue
+ *
+ * @return     l'instant présent (ms)
+ */
+uint64_t wheelClock() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+
+}
+/**
+ * @brief      Prépare une roue sans minuterie
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ */
+void createWheel(timerWheel_t *wheel, uint64_t now) {
+
+	memset(wheel->slots, 0, sizeof(wheel->slots));
+
+	wheel->tick 	= now / WHEEL_TICK;
+	wheel->armed 	= 0;
+	wheel->cursor 	= NULL;
+
+}
+/**
+ * @brief      Prépare une minuterie désarmée
+ *
+ * @param      timer      la minuterie
+ * @param[in]  onExpired  action appelée à l'échéance
+ * @param      owner      propriétaire de la minuterie
+ */
+void createTimer(wheelTimer_t *timer, void (*onExpired)(wheelTimer_t *timer), void *owner) {
+
+	timer->expires 		= 0;
+	timer->armed 		= 0;
+	timer->onExpired 	= onExpired;
+	timer->owner 		= owner;
+	timer->prev 		= NULL;
+	timer->next 		= NULL;
+
+}
+/**
+ * @brief      Arme (ou réarme) une minuterie
+ *
+ * @param      wheel  la roue
+ * @param      timer  la minuterie
+ * @param[in]  delay  délai avant l'échéance (ms), compté depuis le dernier advanceWheel
+ */
+void armTimer(timerWheel_t *wheel, wheelTimer_t *timer, int delay) {
+
+	wheelTimer_t **slot;
+
+	cancelTimer(wheel, timer);
+
+	// arrondi à la case supérieure : jamais d'échéance avant le délai
+	timer->expires 	= wheel->tick + (delay > 0 ? (delay + WHEEL_TICK - 1) / WHEEL_TICK : 1);
+	timer->armed 	= 1;
+
+	slot 			= &wheel->slots[timer->expires % WHEEL_SLOTS];
+	timer->prev 	= NULL;
+	timer->next 	= *slot;
+	if (*slot != NULL) (*slot)->prev = timer;
+	*slot 			= timer;
+
+	wheel->armed++;
+
+}
+/**
+ * @brief      Désarme une minuterie
+ *
+ * @param      wheel  la roue
+ * @param      timer  la minuterie (désarmée : sans effet)
+ */
+void cancelTimer(timerWheel_t *wheel, wheelTimer_t *timer) {
+
+	if (!timer->armed) return;
+
+	// la case en cours de traitement continue après la minuterie retirée
+	if (wheel->cursor == timer) wheel->cursor = timer->next;
+
+	if (timer->prev != NULL) 	timer->prev->next = timer->next;
+	else 						wheel->slots[timer->expires % WHEEL_SLOTS] = timer->next;
+	if (timer->next != NULL) 	timer->next->prev = timer->prev;
+
+	timer->armed 	= 0;
+	timer->prev 	= NULL;
+	timer->next 	= NULL;
+
+	wheel->armed--;
+
+}
+/**
+ * @brief      Fait tourner la roue jusqu'à un instant et appelle les minuteries échues
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ *
+ * @return     le nombre de minuteries échues
+ *
+ * @note       une action peut armer ou annuler n'importe quelle minuterie. Après une
+ *             longue attente, chaque case n'est parcourue qu'une fois.
+ */
+int advanceWheel(timerWheel_t *wheel, uint64_t now) {
+
+	uint64_t 	target 	= now / WHEEL_TICK;
+	uint64_t 	tick 	= wheel->tick;
+	int 		fired 	= 0;
+
+	if (target <= tick) return 0;
+
+	// au-delà d'un tour, les cases sautées sont revues une fois avec la cible
+	if (target - tick > WHEEL_SLOTS) tick = target - WHEEL_SLOTS;
+
+	// les minuteries armées par les actions partent de la cible : jamais dans le passé
+	wheel->tick = target;
+
+	while (tick < target && wheel->armed > 0) {
+
+		wheelTimer_t *timer = wheel->slots[++tick % WHEEL_SLOTS];
+
+		for (; timer != NULL; timer = wheel->cursor) {
+
+			wheel->cursor = timer->next;
+
+			// une case ne contient que des échéances de ce tour ou des suivants
+			if (timer->expires > target) continue;
+
+			cancelTimer(wheel, timer);
+			fired++;
+			timer->onExpired(timer);
+
+		}
+
+		wheel->cursor = NULL;
+
+	}
+
+	return fired;
+
+}
+/**
+ * @brief      Délai avant la prochaine case occupée, pour borner une attente
+ *
+ * @param      wheel  la roue
+ * @param[in]  now    l'instant présent (ms)
+ *
+ * @return     le délai (ms), WHEEL_IDLE si aucune minuterie n'est armée
+ *
+ * @note       la case peut ne contenir que des échéances d'un tour suivant : le
+ *             délai n'est alors qu'un minorant
+ */
+int nextTimerDelay(timerWheel_t *wheel, uint64_t now) {
+
+	if (wheel->armed == 0) return WHEEL_IDLE;
+
+	for (uint64_t tick = wheel->tick + 1; tick <= wheel->tick + WHEEL_SLOTS; tick++) {
+
+		if (wheel->slots[tick % WHEEL_SLOTS] == NULL) continue;
+
+		return tick * WHEEL_TICK > now ? (int) (tick * WHEEL_TICK - now) : 0;
+
+	}
+
+	return WHEEL_IDLE;
+
+}
@@ -0,0 +1,304 @@
+/**
+ *	\file		trace.c
+ *	\brief		Fichier implémentation de la capture binaire du trafic reçu par le
+ *				serveur et de sa relecture
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "trace.h"
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Écrit tout un bloc à la fin du fichier
+ */
+static void writeAll(int fd, const char *data, size_t rest) {
+
+	while (rest > 0) {
+
+		ssize_t written = write(fd, data, rest);
+
+		if (written == -1 && errno == EINTR) continue;
+		if (written == -1) {
+			perror("Can't write trace");
+			break;
+		}
+
+		data += written;
+		rest -= written;
+
+	}
+
+}
+/**
+ * @brief      Ajoute un enregistrement à la capture
+ *
+ * @param      log      la capture
+ * @param[in]  at       instant de l'événement (traceClock)
+ * @param[in]  record   l'enregistrement (delay rempli ici)
+ * @param      payload  octets qui le suivent (record.length)
+ */
+static void pushRecord(traceLog_t *log, uint64_t at, traceRecord_t record, const char *payload) {
+
+	uint64_t delay = at > log->last ? at - log->last : 0;
+
+	if (log->fd == -1) return;
+
+	if (log->amount + sizeof(record) + record.length > TRACE_BUFFER) flushTrace(log);
+
+	record.delay 	= delay > UINT32_MAX ? UINT32_MAX : delay;
+	log->last 		= at > log->last ? at : log->last;
+
+	// les enregistrements se suivent sans alignement
+	memcpy(log->pending + log->amount, &record, sizeof(record));
+	memcpy(log->pending + log->amount + sizeof(record), payload, record.length);
+	log->amount += sizeof(record) + record.length;
+
+}
+/**
+ * @brief      Horloge monotone des captures
+ *
+ * @return     l'instant présent (µs)
+ */
+uint64_t traceClock() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+}
+/**
+ * @brief      Commence une capture (un fichier existant est remplacé)
+ *
+ * @param      log   la capture
+ * @param      path  chemin du fichier
+ *
+ * @return     0, -1 en cas d'erreur (errno)
+ */
+int openTrace(traceLog_t *log, const char *path) {
+
+	struct timespec now;
+	traceHeader_t 	header;
+
+	log->amount 	= 0;
+	log->nextConn 	= 0;
+	log->last 		= traceClock();
+	log->fd 		= open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+
+	if (log->fd == -1) return -1;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	header.magic 	= TRACE_MAGIC;
+	header.version 	= TRACE_VERSION;
+	header.start 	= (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+	memcpy(log->pending, &header, sizeof(header));
+	log->amount = sizeof(header);
+
+	return 0;
+
+}
+/**
+ * @brief      Écrit les enregistrements en attente et ferme la capture
+ *
+ * @param      log   la capture (fd -1 : sans effet)
+ */
+void closeTrace(traceLog_t *log) {
+
+	if (log->fd == -1) return;
+
+	flushTrace(log);
+	close(log->fd);
+
+	log->fd = -1;
+
+}
+/**
+ * @brief      Écrit les enregistrements en attente
+ *
+ * @param      log   la capture (fd -1 : sans effet)
+ */
+void flushTrace(traceLog_t *log) {
+
+	if (log->fd == -1 || log->amount == 0) return;
+
+	writeAll(log->fd, log->pending, log->amount);
+
+	log->amount = 0;
+
+}
+/**
+ * @brief      Enregistre l'ouverture d'une connexion
+ *
+ * @param      log   la capture
+ *
+ * @return     le numéro de la connexion
+ */
+uint32_t traceOpen(traceLog_t *log) {
+
+	uint32_t conn = log->nextConn++;
+
+	pushRecord(log, traceClock(), (traceRecord_t) {0, conn, 0, TRACE_OPEN, 0, 0}, NULL);
+
+	return conn;
+
+}
+/**
+ * @brief      Enregistre une requête traitée
+ *
+ * @param      log        la capture
+ * @param[in]  conn       numéro de la connexion
+ * @param      request    la requête
+ * @param[in]  start      début de son traitement (traceClock)
+ * @param[in]  responses  réponses empilées pendant le traitement
+ *
+ * @note       l'enregistrement est daté de la réception : début du traitement
+ */
+void traceRequest(traceLog_t *log, uint32_t conn, req_t *request, uint64_t start, int responses) {
+
+	buffer_t 	str;
+	uint64_t 	service = traceClock() - start;
+	size_t 		length;
+
+	if (log->fd == -1) return;
+
+	req2str(request, str);
+	length = strlen(str);
+
+	pushRecord(log, start, (traceRecord_t) {
+		0, conn,
+		service > UINT32_MAX ? UINT32_MAX : service,
+		TRACE_REQUEST,
+		length > UINT8_MAX ? UINT8_MAX : length,
+		responses > UINT16_MAX ? UINT16_MAX : responses
+	}, str);
+
+}
+/**
+ * @brief      Enregistre la fermeture d'une connexion
+ *
+ * @param      log   la capture
+ * @param[in]  conn  numéro de la connexion
+ */
+void traceClose(traceLog_t *log, uint32_t conn) {
+
+	pushRecord(log, traceClock(), (traceRecord_t) {0, conn, 0, TRACE_CLOSE, 0, 0}, NULL);
+
+}
+/**
+ * @brief      Ouvre une capture en lecture
+ *
+ * @param      file  la capture
+ * @param      path  chemin du fichier
+ *
+ * @return     0, -1 en cas d'erreur (errno) ou si le fichier n'est pas une capture
+ */
+int openTraceFile(traceFile_t *file, const char *path) {
+
+	struct stat 	st;
+	traceHeader_t 	header;
+	void 			*map;
+	int 			fd = open(path, O_RDONLY);
+
+	file->data = NULL;
+	file->size = 0;
+
+	if (fd == -1) return -1;
+
+	if (fstat(fd, &st) == -1) {
+		close(fd);
+		return -1;
+	}
+
+	if (st.st_size < (off_t) sizeof(header)) {
+		close(fd);
+		errno = EINVAL;
+		return -1;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// la projection reste valide une fois le descripteur fermé
+	close(fd);
+
+	if (map == MAP_FAILED) return -1;
+
+	memcpy(&header, map, sizeof(header));
+
+	if (header.magic != TRACE_MAGIC || header.version != TRACE_VERSION) {
+		munmap(map, st.st_size);
+		errno = EINVAL;
+		return -1;
+	}
+
+	file->data = map;
+	file->size = st.st_size;
+
+	return 0;
+
+}
+/**
+ * @brief      Ferme une capture ouverte en lecture
+ *
+ * @param      file  la capture
+ */
+void closeTraceFile(traceFile_t *file) {
+
+	if (file->data != NULL) munmap((void *) file->data, file->size);
+
+	file->data = NULL;
+	file->size = 0;
+
+}
+/**
+ * @brief      Lit l'enregistrement suivant
+ *
+ * @param      file     la capture
+ * @param      pos      position de la lecture (0 : premier), avancée
+ * @param      record   l'enregistrement lu
+ * @param      request  la requête (TRACE_REQUEST), NULL si inutile
+ *
+ * @return     1 si un enregistrement a été lu, 0 à la fin de la capture
+ *
+ * @note       un enregistrement tronqué en fin de fichier (arrêt brutal) est ignoré
+ */
+int nextTraceRecord(traceFile_t *file, size_t *pos, traceRecord_t *record, req_t *request) {
+
+	if (*pos < sizeof(traceHeader_t)) *pos = sizeof(traceHeader_t);
+
+	if (*pos + sizeof(*record) > file->size) return 0;
+
+	memcpy(record, file->data + *pos, sizeof(*record));
+
+	if (*pos + sizeof(*record) + record->length > file->size) return 0;
+
+	if (request != NULL && record->type == TRACE_REQUEST) {
+
+		buffer_t str;
+
+		memcpy(str, file->data + *pos + sizeof(*record), record->length);
+		str[record->length] = '\0';
+
+		memset(request, 0, sizeof(*request));
+		str2req(str, request);
+
+	}
+
+	*pos += sizeof(*record) + record->length;
+
+	return 1;
+
+}
@@ -0,0 +1,410 @@
+/**
+ *	\file		bancEssai.c
+ *	\brief		banc d'essai : parties entre bots à travers toute la pile réseau
+ *				(dimensionnement des hôtes de partie)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include <session.h>
+#include <repReq.h>
+#include <protocol.h>
+#include <placement.h>
+#include <bot.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      adresse d'écoute par défaut de l'arbitre
+ */
+#define BENCH_ADDRESS 		"127.0.0.1"
+/**
+ * @brief      port d'écoute par défaut de l'arbitre
+ */
+#define BENCH_PORT 			15600
+/**
+ * @brief      nombre de parties jouées par défaut
+ */
+#define BENCH_GAMES 		1000
+/**
+ * @brief      nombre de parties simultanées par défaut
+ */
+#define BENCH_CONCURRENCY 	8
+/**
+ * @brief      graine des parties : la même charge d'une exécution à l'autre
+ */
+#define BENCH_SEED 			0x243F6A8885A308D3ULL
+/**
+ * @brief      réponse à un tir : résultat, case de la riposte (-1 : aucune), son résultat
+ */
+#define SHOT_REPLY_FMT 		"%d:%d:%d"
+/**
+ * @brief      échanges gardés au départ par chaque joueur (agrandi au besoin)
+ */
+#define LATENCY_CHUNK 		4096
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      mesures d'un joueur : ses parties sur une même connexion
+ */
+typedef struct {
+
+	/** graine de ses parties */
+	uint64_t 		seed;
+	/** parties jouées */
+	unsigned long 	games;
+	/** tirs joués, ripostes de l'arbitre comprises */
+	unsigned long 	moves;
+	/** durée de chaque échange de tirs (µs) */
+	int 			*latencies;
+	/** nombre d'échanges mesurés */
+	int 			amount;
+	/** taille de latencies */
+	int 			capacity;
+
+} benchPlayer_t;
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ *	\var		progName
+ *	\brief		Nom de l'exécutable : libnet nécessite cette variable qui pointe sur argv[0]
+ */
+char 			*progName;
+/**
+ * @brief      socket d'écoute de l'arbitre
+ */
+socket_t 		sockEcoute;
+/**
+ * @brief      adresse et port de l'arbitre
+ */
+char 			*benchAddress 	= BENCH_ADDRESS;
+short 			benchPort 		= BENCH_PORT;
+/**
+ * @brief      parties restant à lancer, partagées par les joueurs
+ */
+long 			gamesLeft;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone en microsecondes
+ */
+static long long nowUs() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+}
+/**
+ * @brief      Temps processeur consommé par le processus (µs)
+ */
+static long long cpuUs() {
+
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+
+	return (long long) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+		+ usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+
+}
+/**
+ * @brief      Ordre croissant des durées
+ */
+static int compareLatencies(const void *a, const void *b) {
+
+	return *(const int *) a - *(const int *) b;
+
+}
+/**
+ * @brief      Arbitre d'une connexion : une partie par REQ GAME POST, puis un échange
+ *             par tir (le joueur tire, le bot de l'arbitre riposte)
+ *
+ * @param      sock  la socket de dialogue (libérée)
+ */
+void refereeGames(socket_t *sock) {
+
+	match_t 	match;
+	fleet_t 	fleet;
+	bot_t 		bot;
+	req_t 		request;
+	char 		reply[DATA_LENGTH];
+	int 		playing = 0;
+
+	while (rcvRequest(sock, &request)) {
+
+		shotResult_t 	result, answer = SHOT_INVALID;
+		int 			cell, counter = -1;
+		uint64_t 		seed;
+
+		switch (getAction(request.id)) {
+
+			case GAME:
+
+				seed = strtoull(request.data, NULL, 10);
+
+				createMatch(&match, NULL);
+				randomFleet(&fleet, PLACE_ALLOW_TOUCH, &seed);
+				applyFleet(&match, 0, &fleet);
+				randomFleet(&fleet, PLACE_ALLOW_TOUCH, &seed);
+				applyFleet(&match, 1, &fleet);
+				createBot(&bot, BOT_HUNT, nextRandom(&seed));
+
+				playing = 1;
+				sendResponse(sock, enum2status(ACK, GAME), "", NULL);
+				break;
+
+			case CELL:
+
+				result = playing && sscanf(request.data, "%d", &cell) == 1
+					? fireAt(&match, 0, cell) : SHOT_INVALID;
+
+				if (result == SHOT_INVALID) {
+					sendResponse(sock, enum2status(ERR, CELL), "Tir refusé.", NULL);
+					break;
+				}
+
+				if (result != SHOT_WON) {
+					counter = botShot(&bot);
+					answer 	= fireAt(&match, 1, counter);
+					botRecord(&bot, counter, answer);
+				}
+
+				playing = match.winner == NO_WINNER;
+
+				snprintf(reply, sizeof(reply), SHOT_REPLY_FMT, result, counter, answer);
+				sendResponse(sock, enum2status(ACK, CELL), reply, NULL);
+				break;
+
+			default:
+
+				sendResponse(sock, enum2status(ERR, getAction(request.id)), "Requête inconnue.", NULL);
+				break;
+
+		}
+
+	}
+
+	close(sock->fd);
+	free(sock);
+
+}
+/**
+ * @brief      Accepte les joueurs, un thread d'arbitrage par connexion
+ */
+void refereeServer() {
+
+	while (1) {
+
+		socket_t 	*sock = malloc(sizeof(socket_t));
+		pthread_t 	thread;
+
+		if (sock == NULL) {
+			perror("Can't allocate referee socket");
+			exit(EXIT_FAILURE);
+		}
+
+		*sock = accepterClt(sockEcoute);
+
+		pthread_create(&thread, 0, (void*)(void*) refereeGames, sock);
+		pthread_detach(thread);
+
+	}
+
+}
+/**
+ * @brief      Mesure un échange de tirs
+ */
+static void recordLatency(benchPlayer_t *player, int latency) {
+
+	if (player->amount == player->capacity) {
+
+		player->capacity 	+= LATENCY_CHUNK;
+		player->latencies 	= realloc(player->latencies, player->capacity * sizeof(int));
+
+		if (player->latencies == NULL) {
+			perror("Can't allocate latencies");
+			exit(EXIT_FAILURE);
+		}
+
+	}
+
+	player->latencies[player->amount++] = latency;
+
+}
+/**
+ * @brief      Joueur : enchaîne des parties sur une connexion tant qu'il en reste
+ *
+ * @param      player  ses mesures
+ */
+void playGames(benchPlayer_t *player) {
+
+	socket_t 	sock = connecterClt2Srv(benchAddress, benchPort);
+	rep_t 		response;
+	bot_t 		bot;
+	char 		data[DATA_LENGTH];
+
+	while (__atomic_sub_fetch(&gamesLeft, 1, __ATOMIC_RELAXED) >= 0) {
+
+		int over = 0;
+
+		snprintf(data, sizeof(data), "%llu", (unsigned long long) nextRandom(&player->seed));
+		sendRequest(&sock, enum2status(REQ, GAME), POST, data, NULL);
+
+		if (!rcvResponse(&sock, &response) || response.id != enum2status(ACK, GAME)) break;
+
+		createBot(&bot, BOT_HUNT, nextRandom(&player->seed));
+
+		while (!over) {
+
+			int 		cell = botShot(&bot);
+			int 		result, counter, answer;
+			long long 	start = nowUs();
+
+			snprintf(data, sizeof(data), "%d", cell);
+			sendRequest(&sock, enum2status(REQ, CELL), POST, data, NULL);
+
+			if (!rcvResponse(&sock, &response) || response.id != enum2status(ACK, CELL)
+				|| sscanf(response.data, SHOT_REPLY_FMT, &result, &counter, &answer) != 3) {
+				fprintf(stderr, "Échange refusé : %s\n", response.data);
+				close(sock.fd);
+				return;
+			}
+
+			recordLatency(player, nowUs() - start);
+			botRecord(&bot, cell, result);
+
+			player->moves 	+= counter == -1 ? 1 : 2;
+			over 			= result == SHOT_WON || answer == SHOT_WON;
+
+		}
+
+		player->games++;
+
+	}
+
+	close(sock.fd);
+
+}
+/**
+ * @brief      Affiche les mesures de tous les joueurs
+ *
+ * @param      players   les joueurs
+ * @param[in]  amount    leur nombre
+ * @param[in]  elapsed   durée du banc (µs)
+ * @param[in]  cpu       temps processeur consommé, arbitre compris (µs)
+ */
+static void printResults(benchPlayer_t *players, int amount, long long elapsed, long long cpu) {
+
+	unsigned long 	games 	= 0;
+	unsigned long 	moves 	= 0;
+	int 			total 	= 0;
+	int 			*all;
+
+	for (int i = 0; i < amount; i++) {
+		games 	+= players[i].games;
+		moves 	+= players[i].moves;
+		total 	+= players[i].amount;
+	}
+
+	printf("Parties: %lu en %.3f s, %d simultanées\n", games, elapsed / 1e6, amount);
+	if (games == 0 || total == 0) return;
+
+	printf("Parties/s: %.1f\n", games * 1e6 / elapsed);
+	printf("Tirs/s: %.1f (%.1f par partie)\n", moves * 1e6 / elapsed, (double) moves / games);
+	printf("CPU par tir: %.2f µs (joueurs et arbitre)\n", (double) cpu / moves);
+
+	all = malloc(total * sizeof(int));
+	if (all == NULL) {
+		perror("Can't allocate latencies");
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0, pos = 0; i < amount; pos += players[i].amount, i++)
+		memcpy(all + pos, players[i].latencies, players[i].amount * sizeof(int));
+
+	qsort(all, total, sizeof(int), compareLatencies);
+
+	printf("Latence d'un échange (µs): p50 %d, p90 %d, p99 %d, p99.9 %d, max %d\n",
+		all[total / 2], all[(int) (total * 0.9)], all[(int) (total * 0.99)],
+		all[(int) (total * 0.999)], all[total - 1]);
+
+	free(all);
+
+}
+/**
+ * @brief      Point d'entrée : bench [parties [simultanées [adresse [port]]]]
+ *
+ * 			   lance un arbitre local puis autant de joueurs que de parties
+ * 			   simultanées, chacun sur sa connexion (requêtes, tramage et codage
+ * 			   réels), et mesure débit, coût processeur et latence des échanges
+ */
+int main(int argc, char **argv) {
+
+	benchPlayer_t 	*players;
+	pthread_t 		*threads;
+	pthread_t 		server;
+	int 			concurrency = argc > 2 ? atoi(argv[2]) : BENCH_CONCURRENCY;
+	uint64_t 		seed 		= BENCH_SEED;
+	long long 		start, cpu;
+
+	progName 	= argv[0];
+	gamesLeft 	= argc > 1 ? atol(argv[1]) : BENCH_GAMES;
+
+	if (argc > 3) benchAddress 	= argv[3];
+	if (argc > 4) benchPort 	= atoi(argv[4]);
+
+	if (gamesLeft <= 0 || concurrency <= 0) {
+		fprintf(stderr, "Usage: %s [parties [simultanées [adresse [port]]]]\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	players = calloc(concurrency, sizeof(benchPlayer_t));
+	threads = malloc(concurrency * sizeof(pthread_t));
+
+	if (players == NULL || threads == NULL) {
+		perror("Can't allocate players");
+		exit(EXIT_FAILURE);
+	}
+
+	sockEcoute = creerSocketEcoute(benchAddress, benchPort);
+
+	pthread_create(&server, 0, (void*)(void*) refereeServer, NULL);
+	pthread_detach(server);
+
+	start 	= nowUs();
+	cpu 	= cpuUs();
+
+	for (int i = 0; i < concurrency; i++) {
+		players[i].seed = nextRandom(&seed);
+		pthread_create(&threads[i], 0, (void*)(void*) playGames, &players[i]);
+	}
+
+	for (int i = 0; i < concurrency; i++) pthread_join(threads[i], NULL);
+
+	printResults(players, concurrency, nowUs() - start, cpuUs() - cpu);
+
+	for (int i = 0; i < concurrency; i++) free(players[i].latencies);
+	free(players);
+	free(threads);
+
+	return 0;
+
+}
@@ -15,7 +15,11 @@
 
 #include <dial.h>
 #include <datastructs.h>
+#include <discovery.h>
 #include <interface.h>
+#include <events.h>
+#include <latency.h>
+#include <logging.h>
 /*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
@@ -67,17 +71,82 @@ socket_t 		sockAppel;	// socket d'appel
  */
 sem_t			semCanClose;
 /**
- * @brief		sémaphore permettant d'attendre la fin d'une requête
+ * @brief		événements du dialogue, traités par l'interface en attendant les saisies
  */
-sem_t 			semRequestFin;
+eventQueue_t 	events;
 /**
  * @brief       informations sur le client
  */
 clientInfo_t 	self;
 /**
- * @brief       liste d'hôtes maintenue par le client 
+ * @brief       liste d'hôtes maintenue par le client (page affichée)
  */
 clientInfo_t	hosts[MAX_HOSTS_GET];
+/**
+ * @brief       pages d'hôtes chargées par le dialogue
+ */
+hostCache_t 	hostCache;
+/**
+ * @brief       numéro de la page d'hôtes affichée
+ */
+int 			hostPage = 0;
+/**
+ * @brief       latences des hôtes affichés, dans l'ordre de hosts
+ */
+int 			hostRtts[MAX_HOSTS_GET];
+/**
+ * @brief       latences lissées des hôtes sondés
+ */
+rttTable_t 		rttTable;
+/**
+ * @brief       hôtes en cours de mesure et leur page (lus par le thread de mesure)
+ */
+clientInfo_t 	probed[MAX_HOSTS_GET];
+int 			probedPage;
+/**
+ * @brief       une mesure est en cours (levé par l'interface, baissé à son événement)
+ */
+int 			probing = 0;
+/**
+ * @brief       page d'hôtes attendue du dialogue, NO_PAGE si aucune
+ */
+int 			pendingPage = NO_PAGE;
+/**
+ * @brief       la page attendue rafraîchit la page affichée
+ */
+int 			refreshing = 0;
+/**
+ * @brief       adversaire trouvé par la mise en relation
+ */
+clientInfo_t 	opponent;
+/**
+ * @brief       classement envoyé à la mise en relation
+ */
+int 			rating = MATCH_ANY;
+/**
+ * @brief       nom de l'hôte de la partie regardée
+ */
+char 			spectated[PSEUDO_SIZE];
+/**
+ * @brief       protocole convenu avec le serveur d'enregistrement
+ */
+hello_t 		protocol;
+/**
+ * @brief       filtre de la liste des hôtes
+ */
+hostFilter_t 	hostFilter = {.prefix = "", .role = HOST, .status = FILTER_ANY, .skip = 0};
+/**
+ * @brief       mode LAN sans serveur d'enregistrement
+ */
+int 			lanMode = 0;
+/**
+ * @brief 		id du thread de réponse aux sondes de recherche d'hôtes (mode LAN)
+ */
+pthread_t 		hostDiscoveryThread;
+/**
+ * @brief 		socket de réponse aux sondes de recherche d'hôtes (mode LAN)
+ */
+socket_t 		sockHostDiscovery;
 /*
 *****************************************************************************************
  *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
@@ -101,6 +170,9 @@ void onExit() {
 	int result;
 
 
+	// pas de serveur d'enregistrement à prévenir
+	if (lanMode) exit(EXIT_SUCCESS);
+
 	mustDisconnect = 1;
 
 	// s'assure qu'on ait bien pu fermer la connexion
@@ -117,7 +189,133 @@ void onExit() {
 
 }
 /**
- * @brief     nettoyage, requêtes et affichage des hôtes
+ * @brief      Fonction du thread de mesure des latences des hôtes affichés
+ */
+void probeHostsThread() {
+
+	int 	rtts[MAX_HOSTS_GET];
+	char 	page[12];
+
+	probeHosts(probed, MAX_HOSTS_GET, rtts, PROBE_TIMEOUT);
+	updateRtts(&rttTable, probed, rtts, MAX_HOSTS_GET);
+
+	sprintf(page, "%d", probedPage);
+	postEvent(&events, EVENT_LATENCY, page);
+
+}
+/**
+ * @brief      Mesure en arrière-plan la latence des hôtes affichés, le classement
+ *             est revu à la fin de la mesure (onDialEvent)
+ */
+void probeShownHosts() {
+
+	pthread_t thread;
+
+	if (probing || getHostsAmount(hosts, MAX_HOSTS_GET) == 0) return;
+
+	memcpy(probed, hosts, sizeof(hosts));
+	probedPage 	= hostPage;
+	probing 	= 1;
+
+	pthread_create(&thread, 0, (void*)(void *) probeHostsThread, NULL);
+	pthread_detach(thread);
+
+}
+/**
+ * @brief      Affiche une page d'hôtes du cache et fait précharger la suivante, ou
+ *             la fait charger par le dialogue (affichée à son arrivée)
+ *
+ * @param[in]  page  numéro de la page
+ *
+ * @return     1 si la page est affichée, 0 si elle est vide (au-delà de la
+ *             première), NO_PAGE si elle est en chargement
+ */
+int showHostPage(int page) {
+
+	clientInfo_t 	shown[MAX_HOSTS_GET];
+	int 			amount = getHostPage(&hostCache, page, shown);
+
+	if (amount == NO_PAGE) {
+
+		pendingPage 		= page;
+		setWantedHostPage(&hostCache, page);
+		postRequest(&requestHosts);
+
+		return NO_PAGE;
+
+	}
+
+	if (amount == 0 && page > 0) return 0;
+
+	memcpy(hosts, shown, sizeof(hosts));
+	hostPage = page;
+
+	if (amount == 0) printf("\nAucun hôte enregistré.\n");
+
+	// hôtes déjà sondés classés tout de suite, les autres après leur mesure
+	rankHosts(&rttTable, hosts, hostRtts, MAX_HOSTS_GET);
+	displayRankedHosts(hosts, hostRtts, MAX_HOSTS_GET);
+	displayHostsPage(page, hasNextHostPage(&hostCache, page));
+
+	probeShownHosts();
+
+	// lue par le dialogue pendant que l'utilisateur lit la page
+	if (hasNextHostPage(&hostCache, page) && !hasHostPage(&hostCache, page + 1)) {
+		setPrefetchHostPage(&hostCache, page + 1);
+		postRequest(&requestPrefetch);
+	}
+
+	return 1;
+
+}
+/**
+ * @brief      Affiche une page d'hôtes chargée par le dialogue, si elle est attendue
+ *
+ * @param[in]  page  numéro de la page
+ *
+ * @return     1 si quelque chose est affiché, 0 sinon
+ */
+int onHostPageLoaded(int page) {
+
+	clientInfo_t 	shown[MAX_HOSTS_GET];
+	int 			amount;
+	int 			result;
+	int 			changed = 0;
+
+	// page abandonnée depuis (changement de page ou de filtre)
+	if (page != pendingPage) return 0;
+
+	pendingPage = NO_PAGE;
+
+	// rafraîchissement : réaffichée seulement si elle a changé
+	if (refreshing) {
+
+		refreshing 	= 0;
+		amount 		= getHostPage(&hostCache, page, shown);
+
+		// la page affichée est classée par latence : comparée sans son ordre
+		changed = getHostsAmount(shown, MAX_HOSTS_GET) != getHostsAmount(hosts, MAX_HOSTS_GET);
+
+		for (int i = 0; i < MAX_HOSTS_GET; i++) {
+			changed |= findClient(hosts, MAX_HOSTS_GET, &shown[i], shown[i].status) < 0;
+		}
+
+		if (amount != NO_PAGE && !changed) return 0;
+
+		// les hôtes de la page affichée sont partis : retour à la première
+		if (amount == 0 && page > 0) page = 0;
+
+	}
+
+	result = showHostPage(page);
+
+	if (result == 0) printf("Pas d'autre page.\n");
+
+	return result != NO_PAGE;
+
+}
+/**
+ * @brief     nettoyage, requêtes et affichage de la première page d'hôtes
  */
 void onDisplayHosts() {
 
@@ -126,8 +324,193 @@ void onDisplayHosts() {
 		hosts[i].status 	= DISCONNECTED;
 	}
 
-	postRequest(&requestHosts, &semRequestFin);
-	displayHosts(hosts, MAX_HOSTS_GET);
+	askHostPrefix(hostFilter.prefix);
+
+	// les hôtes ont pu changer depuis le dernier affichage
+	clearHostCache(&hostCache);
+	refreshing = 0;
+
+	if (showHostPage(0) == NO_PAGE) printf("Chargement des hôtes...\n");
+
+}
+/**
+ * @brief      Affiche la page d'hôtes précédente ou suivante
+ *
+ * @param[in]  delta  -1 ou +1
+ */
+void onTurnHostsPage(int delta) {
+
+	int page = hostPage + delta;
+
+	if (page < 0 || (delta > 0 && !hasNextHostPage(&hostCache, hostPage))) {
+		printf("Pas d'autre page.\n");
+		return;
+	}
+
+	refreshing = 0;
+
+	switch (showHostPage(page)) {
+
+		case 0: 		printf("Pas d'autre page.\n"); 					break;
+		case NO_PAGE: 	printf("Chargement de la page %d...\n", page + 1); 	break;
+
+	}
+
+}
+/**
+ * @brief      Recharge la page d'hôtes affichée (minuterie du menu des hôtes)
+ *
+ * @return     0 : rien n'est affiché avant l'arrivée de la page
+ */
+int onRefreshHosts() {
+
+	// mesures répétées : la latence lissée suit les variations durables
+	probeShownHosts();
+
+	// une page est déjà attendue
+	if (pendingPage != NO_PAGE) return 0;
+
+	clearHostCache(&hostCache);
+	refreshing = 1;
+	showHostPage(hostPage);
+
+	return 0;
+
+}
+/**
+ * @brief      Traite les événements du dialogue (fin de requête, partie regardée)
+ *
+ * @return     1 si quelque chose est affiché, 0 sinon
+ */
+int onDialEvent() {
+
+	uiEvent_t 	event;
+	int 		shown = 0;
+
+	while (nextEvent(&events, &event)) {
+
+		// nouveau classement de la page mesurée si elle est toujours affichée
+		if (event.status == EVENT_LATENCY) {
+
+			probing = 0;
+
+			if (atoi(event.data) == hostPage && rankHosts(&rttTable, hosts, hostRtts, MAX_HOSTS_GET)) {
+				displayRankedHosts(hosts, hostRtts, MAX_HOSTS_GET);
+				displayHostsPage(hostPage, hasNextHostPage(&hostCache, hostPage));
+				shown = 1;
+			}
+
+			continue;
+
+		}
+
+		switch (getAction(event.status)) {
+
+			case CONNECT:
+				shown |= onHostPageLoaded(atoi(event.data));
+				break;
+
+			case MATCH:
+				displayOpponent(&opponent);
+				shown = 1;
+				break;
+
+			case SPECTATE:
+				printf("Fin de la partie.\n");
+				shown = 1;
+				break;
+
+			default:
+				displayGameEvent(event.status, event.data);
+				shown = 1;
+				break;
+
+		}
+
+	}
+
+	return shown;
+
+}
+/**
+ * @brief      Transmet un événement du dialogue à l'interface (thread de dialogue)
+ *
+ * @param[in]  status  code d'état
+ * @param      data    données
+ */
+void queueDialEvent(short status, char *data) {
+
+	if (!postEvent(&events, status, data)) logMessage("[%d] Événement perdu.\n", DEBUG, status);
+
+}
+/**
+ * @brief     nettoyage, recherche sur le LAN et affichage des hôtes (mode LAN)
+ */
+void onDisplayLanHosts() {
+
+	for (int i = 0; i < MAX_HOSTS_GET; i++) {
+		createClientInfo(&hosts[i], "", 0, "", 0);
+		hosts[i].status 	= DISCONNECTED;
+	}
+
+	printf("\nRecherche des hôtes sur le LAN...\n");
+	discoverHosts(hosts, MAX_HOSTS_GET, DISCOVERY_TIMEOUT);
+
+	// hôtes proches : mesurés avant l'affichage
+	probeHosts(hosts, MAX_HOSTS_GET, hostRtts, PROBE_TIMEOUT);
+	updateRtts(&rttTable, hosts, hostRtts, MAX_HOSTS_GET);
+	rankHosts(&rttTable, hosts, hostRtts, MAX_HOSTS_GET);
+	displayRankedHosts(hosts, hostRtts, MAX_HOSTS_GET);
+
+}
+/**
+ * @brief     recherche d'un adversaire par le serveur d'enregistrement
+ */
+void onFindOpponent() {
+
+	rating = askRating();
+
+	// l'adversaire est affiché à son arrivée (onDialEvent)
+	printf("Recherche d'un adversaire...\n");
+	postRequest(&requestOpponent);
+
+}
+/**
+ * @brief     pas de mise en relation sans serveur d'enregistrement (mode LAN)
+ */
+void onFindLanOpponent() {
+
+	printf("\nMise en relation indisponible en mode LAN.\n");
+
+}
+/**
+ * @brief     suivi d'une partie relayée par le serveur d'enregistrement, jusqu'à sa fin
+ */
+void onSpectateGame() {
+
+	askHostName(spectated);
+
+	if (spectated[0] == '\0') return;
+
+	// les coups sont affichés à leur arrivée, jusqu'à la fin de la partie (onDialEvent)
+	printf("Partie de %s:\n", spectated);
+	postRequest(&requestSpectate);
+
+}
+/**
+ * @brief     pas de spectateurs sans serveur d'enregistrement (mode LAN)
+ */
+void onSpectateLanGame() {
+
+	printf("\nSuivi des parties indisponible en mode LAN.\n");
+
+}
+/**
+ * @brief      Fonction du thread de réponse aux sondes de recherche d'hôtes (mode LAN)
+ */
+void hostDiscoveryResponder() {
+
+	serveHostDiscovery(&sockHostDiscovery, &self);
 
 }
 /**
@@ -143,7 +526,10 @@ void initClient() {
 
 
 	CHECK(sem_init(&semCanClose, 0, 0), "sem_init()");
-	CHECK(sem_init(&semRequestFin, 0, 0), "sem_init()");
+
+	createHostCache(&hostCache);
+	createEventQueue(&events);
+	createRttTable(&rttTable);
 
 	// initialise les hôtes avec des valeurs pour éviter
 	// de lire n'importe quoi.
@@ -165,7 +551,7 @@ void client(char *adrIP, unsigned short port) {
 
 	char 				userIP[INPUT_BUFFER_SIZE];
 	short				userPort;
-	eCltThreadParams_t	*params;
+	eCltThreadParams_t	params;
 	playerMenuParams_t	menuParams;
 	
 
@@ -173,24 +559,77 @@ void client(char *adrIP, unsigned short port) {
 
 	getSrvEAddress(adrIP, port, userIP, &userPort);
 
+	if (strcmp(userIP, DISCOVERY_KEYWORD) == 0) {
+
+		printf("Recherche d'un serveur d'enregistrement sur le LAN...\n");
+
+		if (discoverSrvE(userIP, &userPort, DISCOVERY_TIMEOUT)) {
+			printf("Serveur trouvé: %s:%hu\n", userIP, (unsigned short) userPort);
+		} else {
+			printf("Aucun serveur trouvé. Utilisation des valeurs par défaut...\n");
+			strcpy(userIP, adrIP);
+			userPort = port;
+		}
+
+	}
+
+	lanMode = strcmp(userIP, LAN_KEYWORD) == 0;
+
 	setupUserInfos(&self);
 
+	if (lanMode) {
+
+		// pas de serveur : l'hôte répond lui-même aux sondes des joueurs
+		if (self.role == HOST) {
+
+			sockHostDiscovery = createHostDiscoverySocket();
+
+			pthread_create(&hostDiscoveryThread, 0, (void*)(void *) hostDiscoveryResponder, NULL);
+			pthread_detach(hostDiscoveryThread);
+
+		}
+
+		menuParams.showHosts	= onDisplayLanHosts;
+		menuParams.exitProgram	= onExit;
+		menuParams.findOpponent	= onFindLanOpponent;
+		menuParams.spectateGame	= onSpectateLanGame;
+		menuParams.turnHostsPage 	= NULL;
+		menuParams.refreshHosts 	= NULL;
+		menuParams.hosts 		= hosts;
+
+		displayPlayerMenu(menuParams);
+
+		onExit();
+
+	}
+
 	// Créer une connexion avec le serveur
 	sockAppel = connecterClt2Srv (userIP, userPort);
 
 
-	params 					= malloc(sizeof(eCltThreadParams_t));
-	params->sockAppel 		= &sockAppel;
-	params->infos 			= &self;
-	params->hostBuffer		= hosts;
-	params->semCanClose		= &semCanClose;
-	params->semRequestFin 	= &semRequestFin;
+	// un seul dialogue par client : les paramètres restent sur la pile de client()
+	params.sockAppel 		= &sockAppel;
+	params.infos 			= &self;
+	params.hostCache		= &hostCache;
+	params.opponent 		= &opponent;
+	params.rating 			= &rating;
+	params.spectated 		= spectated;
+	params.onEvent 			= queueDialEvent;
+	params.hello 			= &protocol;
+	params.hostFilter 		= &hostFilter;
+	params.semCanClose		= &semCanClose;
 
-	pthread_create(&dialServE, 0, (void*)(void *) dialClt2SrvE, params);
+	pthread_create(&dialServE, 0, (void*)(void *) dialClt2SrvE, &params);
 	
 
 	menuParams.showHosts	= onDisplayHosts;
 	menuParams.exitProgram	= onExit;
+	menuParams.findOpponent	= onFindOpponent;
+	menuParams.spectateGame	= onSpectateGame;
+	menuParams.turnHostsPage 	= onTurnHostsPage;
+	menuParams.refreshHosts 	= onRefreshHosts;
+
+	setInputSource(getEventFd(&events), onDialEvent);
 	menuParams.hosts 		= hosts;
 
 	displayPlayerMenu(menuParams);
@@ -220,8 +659,14 @@ int main(int argc, char** argv) {
 	progName = argv[0];
 
 
-	if (argc<3) {
-		fprintf(stderr,"usage : %s @IP port\n", basename(progName));
+	if (argc == 2 && estAdrUnix(argv[1])) {
+		// serveur sur la même machine : socket locale, pas de port
+		fprintf(stderr,"lancement du client [PID:%d] connecté à l'adresse applicative [%s]\n",
+			getpid(), argv[1]);
+		client(argv[1], 0);
+	}
+	else if (argc<3) {
+		fprintf(stderr,"usage : %s @IP port | %s/chemin\n", basename(progName), PREFIXE_UNIX);
 		 /*exit(-1);*/ 
 		fprintf(stderr,"lancement du client [PID:%d] connecté à l'adresse applicative [%s:%d]\n", 
 				getpid(), IP_ANY, PORT_SRV);
@@ -5,6 +5,7 @@
  *	\date		1 février 2026
  *	\version	1.0
  */
+#define _GNU_SOURCE			// sendmmsg/recvmmsg
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -74,9 +75,14 @@ extern char *progName;
  */
 void envoyerMessDGRAM (socket_t *sockEch, char *msg, char *adrDest, short portDest) {
 	
-	struct sockaddr_in target;
-	adr2struct(&target, adrDest, portDest);
+	struct sockaddr_storage target;
+	socklen_t targetLen = adr2struct(&target, adrDest, portDest);
 	
+	if (targetLen == 0) {
+		fprintf(stderr, "Adresse invalide: [%s]\n", adrDest);
+		return;
+	}
+
 	CHECK(
 		sendto(
 			sockEch->fd
@@ -84,7 +90,7 @@ void envoyerMessDGRAM (socket_t *sockEch, char *msg, char *adrDest, short portDe
 			, strlen(msg)+1
 			, SEND_FLAGS
 			, (struct sockaddr *) &target
-			, sizeof(target)
+			, targetLen
 		)
 		, "Can't send"
 	);
@@ -100,7 +106,7 @@ void envoyerMessDGRAM (socket_t *sockEch, char *msg, char *adrDest, short portDe
  */
 void recevoirMessDGRAM (socket_t *sockEch, char *msg, int msgSize) {
 	
-	socklen_t sockLen;
+	socklen_t sockLen = sizeof(sockEch->addrDst);
 	
 	CHECK(recvfrom(sockEch->fd
 			, msg
@@ -112,6 +118,103 @@ void recevoirMessDGRAM (socket_t *sockEch, char *msg, int msgSize) {
 		, "Can't receive"
 	);
 	
+}
+/**
+ *	\fn			int envoyerLot(socket_t *sockEch, datagramme_t *lot, int nb)
+ *	\brief		Envoi d'un lot de datagrammes en un minimum d'appels système (sendmmsg)
+ *	\param 		sockEch : socket DGRAM à utiliser pour l'envoi
+ *	\param 		lot : datagrammes à envoyer (buff, len, addr et addrLen remplis)
+ *	\param 		nb : nombre de datagrammes du lot
+ *	\result		nombre de datagrammes envoyés, -1 si aucun n'a pu l'être
+ *	\note		un datagramme refusé (destinataire injoignable...) est abandonné et
+ *				l'envoi reprend au suivant
+ */
+int envoyerLot(socket_t *sockEch, datagramme_t *lot, int nb) {
+
+	struct mmsghdr 	msgs[MAX_LOT];
+	struct iovec 	iovs[MAX_LOT];
+	int 			envoyes = 0;
+	int 			echecs 	= 0;
+
+	while (envoyes < nb) {
+
+		int taille = nb - envoyes < MAX_LOT ? nb - envoyes : MAX_LOT;
+		int sts;
+
+		memset(msgs, 0, taille * sizeof(struct mmsghdr));
+
+		for (int i = 0; i < taille; i++) {
+
+			datagramme_t *dg = &lot[envoyes + i];
+
+			iovs[i].iov_base 			= dg->buff;
+			iovs[i].iov_len 			= dg->len;
+			msgs[i].msg_hdr.msg_iov 	= &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen 	= 1;
+			msgs[i].msg_hdr.msg_name 	= &dg->addr;
+			msgs[i].msg_hdr.msg_namelen = dg->addrLen;
+
+		}
+
+		sts = sendmmsg(sockEch->fd, msgs, taille, SEND_FLAGS);
+
+		// sendmmsg n'échoue que sur le premier datagramme du lot : le sauter
+		if (sts == -1 && errno == EINTR) continue;
+		if (sts == -1) {
+			echecs++;
+			envoyes++;
+			continue;
+		}
+
+		envoyes += sts;
+
+	}
+
+	return echecs > 0 && echecs == nb ? -1 : nb - echecs;
+
+}
+/**
+ *	\fn			int recevoirLot(socket_t *sockEch, datagramme_t *lot, int nb)
+ *	\brief		Réception d'un lot de datagrammes en un seul appel système (recvmmsg)
+ *	\param 		sockEch : socket DGRAM à utiliser pour la réception
+ *	\param 		lot : tableau d'au moins nb datagrammes à remplir
+ *	\param 		nb : nombre maximum de datagrammes à recevoir
+ *	\result		nombre de datagrammes reçus, -1 en cas d'erreur
+ */
+int recevoirLot(socket_t *sockEch, datagramme_t *lot, int nb) {
+
+	struct mmsghdr 	msgs[MAX_LOT];
+	struct iovec 	iovs[MAX_LOT];
+	int 			recus;
+
+	if (nb > MAX_LOT) nb = MAX_LOT;
+
+	memset(msgs, 0, nb * sizeof(struct mmsghdr));
+
+	for (int i = 0; i < nb; i++) {
+
+		// on garde un octet pour terminer la chaîne reçue
+		iovs[i].iov_base 			= lot[i].buff;
+		iovs[i].iov_len 			= MAX_BUFFER - 1;
+		msgs[i].msg_hdr.msg_iov 	= &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen 	= 1;
+		msgs[i].msg_hdr.msg_name 	= &lot[i].addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(lot[i].addr);
+
+	}
+
+	recus = recvmmsg(sockEch->fd, msgs, nb, RECV_FLAGS | MSG_WAITFORONE, NULL);
+
+	for (int i = 0; i < recus; i++) {
+
+		lot[i].len 				= msgs[i].msg_len;
+		lot[i].addrLen 			= msgs[i].msg_hdr.msg_namelen;
+		lot[i].buff[lot[i].len] = '\0';
+
+	}
+
+	return recus;
+
 }
 /*
 *****************************************************************************************
@@ -119,27 +222,222 @@ void recevoirMessDGRAM (socket_t *sockEch, char *msg, int msgSize) {
  *					M O D E    S T R E A M
  */
 /**
- *	\fn			void envoyerMessSTREAM (const socket_t *sockEch, char *msg)
+ *	\fn			static void ecrireIov (int fd, struct iovec *morceaux, int nb)
+ *	\brief		Écrit entièrement une suite de morceaux, en reprenant les écritures partielles
+ *	\param 		fd : descripteur de la socket
+ *	\param 		morceaux : morceaux à écrire (modifiés au fil des écritures)
+ *	\param 		nb : nombre de morceaux
+ */
+static void ecrireIov (int fd, struct iovec *morceaux, int nb) {
+
+	while (nb > 0) {
+
+		ssize_t ecrits;
+
+		CHECK(ecrits = writev(fd, morceaux, nb), "Can't send");
+
+		// passer les morceaux entièrement écrits puis avancer dans le suivant
+		while (nb > 0 && ecrits >= (ssize_t) morceaux->iov_len) {
+			ecrits -= morceaux->iov_len;
+			morceaux++;
+			nb--;
+		}
+
+		if (nb > 0) {
+			morceaux->iov_base = (char *) morceaux->iov_base + ecrits;
+			morceaux->iov_len -= ecrits;
+		}
+
+	}
+
+}
+/**
+ *	\fn			void envoyerIov(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Envoi immédiat d'un message STREAM fourni en morceaux, sans recopie
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux du message (le dernier doit contenir le \0)
+ *	\param 		nb : nombre de morceaux (au plus MAX_MORCEAUX)
+ */
+void envoyerIov(socket_t *sockEch, struct iovec *morceaux, int nb) {
+
+	struct iovec 	iov[MAX_MORCEAUX + 1];
+	int 			nbIov = 0;
+
+	// les messages empilés partent devant, dans le même appel système
+	if (sockEch->nbSortie > 0) {
+		iov[nbIov].iov_base = sockEch->sortie;
+		iov[nbIov].iov_len 	= sockEch->nbSortie;
+		nbIov++;
+	}
+
+	for (int i = 0; i < nb && i < MAX_MORCEAUX; i++) iov[nbIov++] = morceaux[i];
+
+	ecrireIov(sockEch->fd, iov, nbIov);
+
+	sockEch->nbSortie = 0;
+	if (nb > 0) sockEch->nbMessages++;
+
+}
+/**
+ *	\fn			void empilerIov(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Empile un message STREAM dans le buffer d'émission de la socket
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux du message (le dernier doit contenir le \0)
+ *	\param 		nb : nombre de morceaux (au plus MAX_MORCEAUX)
+ */
+void empilerIov(socket_t *sockEch, struct iovec *morceaux, int nb) {
+
+	size_t taille = 0;
+
+	for (int i = 0; i < nb; i++) taille += morceaux[i].iov_len;
+
+	// socket du moteur d'E/S : ni écriture bloquante ni arrêt du processus sur une
+	// erreur du pair. Le client ne lit plus : couper la connexion, dont le moteur
+	// rendra l'échec à la prochaine opération
+	if (sockEch->idMoteur != 0 && sockEch->nbSortie + taille > TAILLE_SORTIE) {
+		shutdown(sockEch->fd, SHUT_RDWR);
+		return;
+	}
+
+	// message plus grand que le buffer : il part directement derrière les autres
+	if (taille > TAILLE_SORTIE) {
+		envoyerIov(sockEch, morceaux, nb);
+		return;
+	}
+
+	if (sockEch->nbSortie + taille > TAILLE_SORTIE) viderSortie(sockEch);
+
+	for (int i = 0; i < nb; i++) {
+		memcpy(sockEch->sortie + sockEch->nbSortie, morceaux[i].iov_base, morceaux[i].iov_len);
+		sockEch->nbSortie += morceaux[i].iov_len;
+	}
+
+	sockEch->nbMessages++;
+
+}
+/**
+ *	\fn			void viderSortie(socket_t *sockEch)
+ *	\brief		Émet en un seul appel système les messages empilés sur la socket
+ *	\param 		sockEch : socket STREAM dont le buffer d'émission est à vider
+ */
+void viderSortie(socket_t *sockEch) {
+
+	if (sockEch->nbSortie == 0) return;
+
+	envoyerIov(sockEch, NULL, 0);
+
+}
+/**
+ *	\fn			int envoyerIovSansAttente(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Émet ce qui peut partir immédiatement d'une suite de morceaux STREAM,
+ *				sans bloquer ni lever SIGPIPE
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux à émettre (le buffer d'émission n'est pas utilisé)
+ *	\param 		nb : nombre de morceaux
+ *	\result		nombre d'octets émis (0 si la socket est pleine), -1 en cas d'erreur
+ */
+int envoyerIovSansAttente(socket_t *sockEch, struct iovec *morceaux, int nb) {
+
+	struct msghdr 	msg = {0};
+	ssize_t 		n;
+
+	msg.msg_iov 	= morceaux;
+	msg.msg_iovlen 	= nb;
+
+	n = sendmsg(sockEch->fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+	if (n == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+
+	return n;
+
+}
+/**
+ *	\fn			void envoyerMessSTREAM (socket_t *sockEch, char *msg)
  *	\brief		Envoi d'un message sur une socket en mode STREAM
  *	\param 		sockEch : socket d'échange à utiliser pour l'envoi
  *	\param 		msg : message à envoyer
 */
-void envoyerMessSTREAM (const socket_t *sockEch, char *msg) {
+void envoyerMessSTREAM (socket_t *sockEch, char *msg) {
 	
-	CHECK(write(sockEch->fd, msg, strlen(msg)+1), "Can't send");
+	struct iovec morceau = {msg, strlen(msg)+1};
+
+	envoyerIov(sockEch, &morceau, 1);
 	
 }
 /**
- *	\fn			void recevoirMessSTREAM (const socket_t *sockEch, char *msg, int msgSize)
+ *	\fn			int extraireMessage(socket_t *sockEch, char *msg, int msgSize)
+ *	\brief		Extrait sans lecture le prochain message complet du buffer de réception
+ *	\param 		sockEch : socket STREAM dont sockEch->entree a été rempli
+ *	\param 		msg : message extrait (terminé par \0)
+ *	\param 		msgSize : taille de l'espace mémoire préalablement alloué à msg
+ *	\note		Un message plus long que msgSize ou que le buffer est ignoré en entier
+ *	\result		1 si un message a été extrait, 0 si aucun message n'est complet
+ */
+int extraireMessage(socket_t *sockEch, char *msg, int msgSize) {
+
+	char 	*fin;
+	int 	taille;
+	int 	ignore;
+
+	while ((fin = memchr(sockEch->entree, '\0', sockEch->nbEntree)) != NULL
+		|| sockEch->nbEntree == TAILLE_ENTREE) {
+
+		// message trop long pour le buffer : ignoré jusqu'à son \0
+		if (fin == NULL) {
+			sockEch->rejet 		= 1;
+			sockEch->nbEntree 	= 0;
+			return 0;
+		}
+
+		taille 	= fin - sockEch->entree + 1;
+		ignore 	= sockEch->rejet || taille > msgSize;
+
+		// un message tronqué serait traité comme un autre : il est ignoré
+		if (!ignore) memcpy(msg, sockEch->entree, taille);
+
+		// décaler les messages suivants au début du buffer
+		sockEch->rejet 		= 0;
+		sockEch->nbEntree 	-= taille;
+		memmove(sockEch->entree, sockEch->entree + taille, sockEch->nbEntree);
+
+		if (!ignore) return 1;
+
+	}
+
+	return 0;
+
+}
+/**
+ *	\fn			int recevoirMessSTREAM (socket_t *sockEch, char *msg, int msgSize)
  *	\brief		Réception d'un message sur une socket en mode STREAM
  *	\param 		sockEch : socket d'échange à utiliser pour la réception
  *	\param 		msg	 : message reçu
  *	\param 		msgSize : taille de l'espace mémoire préalablement alloué à msg
+ *	\note		Les octets reçus après le \0 du message restent dans sockEch->entree
  *	\result		paramètre modifié avec le message reçu
+ *				retourne 0 si la connexion est fermée, 1 sinon
  */
-void recevoirMessSTREAM (const socket_t *sockEch, char *msg, int msgSize) {
+int recevoirMessSTREAM (socket_t *sockEch, char *msg, int msgSize) {
 	
-	CHECK(read(sockEch->fd, msg, msgSize), "Can't read");
+	// lire tant qu'aucun message complet n'est dans le buffer de réception
+	while (!extraireMessage(sockEch, msg, msgSize)) {
+
+		ssize_t lus;
+
+		CHECK(
+			lus = read(sockEch->fd
+				, sockEch->entree + sockEch->nbEntree
+				, TAILLE_ENTREE - sockEch->nbEntree)
+			, "Can't read"
+		);
+
+		if (lus == 0) return 0;
+
+		sockEch->nbEntree += lus;
+
+	}
+
+	return 1;
 	
 }
 /*
@@ -173,8 +471,8 @@ void envoyer(socket_t *sockEch, generic quoi, pFct serial, ...) {
 		va_end(pArg);
 		}	
 }
-/**cpy(buff , (char *)quoi);
- *	\fn			void recevoir(socket_t *sockEch, generic quoi, pFct deSerial)
+/**
+ *	\fn			int recevoir(socket_t *sockEch, generic quoi, pFct deSerial)
  *	\brief		Réception d'une requête/réponse sur une socket
  *	\param 		sockEch : socket d'échange à utiliser pour la réception
  *	\param 		quoi : requête/réponse reçue après dé-serialisation du buffer de réception
@@ -182,14 +480,129 @@ void envoyer(socket_t *sockEch, generic quoi, pFct serial, ...) {
  *	\note		si le paramètre deSerial vaut NULL alors quoi est une chaîne de caractères
  *	\result		paramètre quoi modifié avec le requête/réponse reçue
  *				paramètre sockEch modifié pour le mode DGRAM
+ *				retourne 0 si la connexion a été fermée (quoi inchangé), 1 sinon
  */
-void recevoir(socket_t *sockEch, generic quoi, pFct deSerial) {
+int recevoir(socket_t *sockEch, generic quoi, pFct deSerial) {
 	buffer_t buff;	// buffer de réception
 	
 	// Réception : appel de la fonction adéquate selon le mode
-	if (sockEch->mode==SOCK_STREAM) recevoirMessSTREAM(sockEch, buff, MAX_BUFFER);
+	if (sockEch->mode==SOCK_STREAM) {
+		if (!recevoirMessSTREAM(sockEch, buff, MAX_BUFFER)) return 0;
+	}
 	else recevoirMessDGRAM(sockEch, buff, MAX_BUFFER);
 	// Dé-serialiser la requête/réponse
 	if (deSerial != NULL) deSerial(buff, quoi);
 	else strcpy((char *) quoi, buff);
+
+	return 1;
+}
+/**
+ *	\fn			int envoyerDescripteurs(socket_t *sockEch, int *fds, int nbFds, void *donnees, int taille)
+ *	\brief		Transmet des descripteurs ouverts à un autre processus (SCM_RIGHTS)
+ *	\param 		sockEch : socket AF_UNIX STREAM connectée au processus destinataire
+ *	\param 		fds : descripteurs à transmettre (restent ouverts chez l'émetteur)
+ *	\param 		nbFds : nombre de descripteurs (au plus MAX_DESCRIPTEURS, 0 accepté)
+ *	\param 		donnees : données d'accompagnement, émises en entier
+ *	\param 		taille : taille des données (au moins 1 octet)
+ *	\result		0 en cas de succès, -1 sinon
+ */
+int envoyerDescripteurs(socket_t *sockEch, int *fds, int nbFds, void *donnees, int taille) {
+
+	union {
+		char 			buf[CMSG_SPACE(MAX_DESCRIPTEURS * sizeof(int))];
+		struct cmsghdr 	align;
+	} ctrl;
+	struct iovec 	iov 	= {donnees, taille};
+	struct msghdr 	msg 	= {0};
+	ssize_t 		n;
+
+	msg.msg_iov 	= &iov;
+	msg.msg_iovlen 	= 1;
+
+	if (nbFds > 0) {
+
+		struct cmsghdr *cmsg;
+
+		msg.msg_control 	= ctrl.buf;
+		msg.msg_controllen 	= CMSG_SPACE(nbFds * sizeof(int));
+
+		cmsg 				= CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level 	= SOL_SOCKET;
+		cmsg->cmsg_type 	= SCM_RIGHTS;
+		cmsg->cmsg_len 		= CMSG_LEN(nbFds * sizeof(int));
+		memcpy(CMSG_DATA(cmsg), fds, nbFds * sizeof(int));
+
+	}
+
+	// les descripteurs partent avec le premier octet, le reste suit en flux
+	n = sendmsg(sockEch->fd, &msg, SEND_FLAGS);
+	if (n <= 0) return -1;
+
+	while (n < taille) {
+
+		ssize_t sts = write(sockEch->fd, (char *) donnees + n, taille - n);
+		if (sts <= 0) return -1;
+		n += sts;
+
+	}
+
+	return 0;
+
+}
+/**
+ *	\fn			int recevoirDescripteurs(socket_t *sockEch, int *fds, int maxFds, void *donnees, int taille)
+ *	\brief		Reçoit un message émis par envoyerDescripteurs
+ *	\param 		sockEch : socket AF_UNIX STREAM connectée au processus émetteur
+ *	\param 		fds : tableau d'au moins maxFds descripteurs à remplir
+ *	\param 		maxFds : nombre maximum de descripteurs attendus
+ *	\param 		donnees : données d'accompagnement, reçues en entier
+ *	\param 		taille : taille des données attendues
+ *	\result		nombre de descripteurs reçus, -1 en cas d'erreur ou de fermeture
+ */
+int recevoirDescripteurs(socket_t *sockEch, int *fds, int maxFds, void *donnees, int taille) {
+
+	union {
+		char 			buf[CMSG_SPACE(MAX_DESCRIPTEURS * sizeof(int))];
+		struct cmsghdr 	align;
+	} ctrl;
+	struct iovec 	iov 	= {donnees, taille};
+	struct msghdr 	msg 	= {0};
+	struct cmsghdr 	*cmsg;
+	int 			nbFds 	= 0;
+	ssize_t 		n;
+
+	msg.msg_iov 		= &iov;
+	msg.msg_iovlen 		= 1;
+	msg.msg_control 	= ctrl.buf;
+	msg.msg_controllen 	= sizeof(ctrl.buf);
+
+	n = recvmsg(sockEch->fd, &msg, RECV_FLAGS | MSG_CMSG_CLOEXEC);
+	if (n <= 0) return -1;
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+		int 	recus = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+		int 	*tab = (int *) CMSG_DATA(cmsg);
+
+		for (int i = 0; i < recus; i++) {
+			// descripteurs en trop : les fermer plutôt que de les perdre ouverts
+			if (nbFds < maxFds) fds[nbFds++] = tab[i];
+			else close(tab[i]);
+		}
+
+	}
+
+	// le noyau ne recolle pas les données qui suivent un envoi de descripteurs
+	while (n < taille) {
+
+		ssize_t sts = read(sockEch->fd, (char *) donnees + n, taille - n);
+		if (sts <= 0) return -1;
+		n += sts;
+
+	}
+
+	return nbFds;
+
 }
\ No newline at end of file
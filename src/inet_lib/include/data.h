@@ -11,6 +11,7 @@
 *****************************************************************************************
  *	\noop		I N C L U D E S   S P E C I F I Q U E S
  */
+#include <sys/uio.h>
 #include "session.h"
 /*
 *****************************************************************************************
@@ -21,6 +22,21 @@
  *	\brief		taille d'un buffer_t d'émission/réception
  */
 #define MAX_BUFFER	1024
+/**
+ *	\def		MAX_LOT
+ *	\brief		nombre maximum de datagrammes émis/reçus en un seul appel système
+ */
+#define MAX_LOT		64
+/**
+ *	\def		MAX_MORCEAUX
+ *	\brief		nombre maximum de morceaux (iovec) d'un message émis par envoyerIov
+ */
+#define MAX_MORCEAUX	8
+/**
+ *	\def		MAX_DESCRIPTEURS
+ *	\brief		nombre maximum de descripteurs transmis avec un message (SCM_RIGHTS)
+ */
+#define MAX_DESCRIPTEURS	4
 /*
 *****************************************************************************************
  *	\noop		S T R C T U R E S   DE   D O N N E E S
@@ -40,6 +56,23 @@ typedef void * generic;
  *	\brief		pointer sur fonction générique à 2 parametres génériques
  */
 typedef void (*pFct) (generic, generic);
+/**
+ *	\struct		datagramme
+ *	\brief		Un datagramme d'un lot émis/reçu en mode DGRAM
+ *	\note		En réception, addr est l'adresse de l'émetteur ; en émission,
+ *				celle du destinataire
+ */
+struct datagramme {
+	buffer_t 				buff;		/**< contenu du datagramme				*/
+	int 					len;		/**< nombre d'octets utiles de buff		*/
+	struct sockaddr_storage addr;		/**< adresse de l'émetteur/destinataire	*/
+	socklen_t 				addrLen;	/**< taille utile de addr				*/
+};
+/**
+ *	\typedef	datagramme_t
+ *	\brief		Définition du type de données datagramme_t
+ */
+typedef struct datagramme datagramme_t;
 /*
 *****************************************************************************************
  *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
@@ -56,16 +89,114 @@ typedef void (*pFct) (generic, generic);
  */
 void envoyer(socket_t *sockEch, generic quoi, pFct serial, ...);
 /**
- *	\fn			void recevoir(socket_t *sockEch, generic quoi, pFct deSerial)
+ *	\fn			int recevoir(socket_t *sockEch, generic quoi, pFct deSerial)
  *	\brief		Réception d'une requête/réponse sur une socket
  *	\param 		sockEch : socket d'échange à utiliser pour la réception
  *	\param 		quoi : requête/réponse reçue après dé-serialisation du buffer de réception
  *	\param 		deSerial : pointeur sur la fonction de dé-serialisation d'une requête/réponse
  *	\note		si le paramètre deSerial vaut NULL alors quoi est une chaîne de caractères
+ *	\note		En mode STREAM, un message est délimité par son \0 : plusieurs messages
+ *				reçus en une lecture sont rendus un par un aux appels suivants
  *	\result		paramètre quoi modifié avec le requête/réponse reçue
  *				paramètre sockEch modifié pour le mode DGRAM
+ *				retourne 0 si la connexion a été fermée (quoi inchangé), 1 sinon
+ */
+int recevoir(socket_t *sockEch, generic quoi, pFct deSerial);
+/**
+ *	\fn			int extraireMessage(socket_t *sockEch, char *msg, int msgSize)
+ *	\brief		Extrait sans lecture le prochain message complet du buffer de réception
+ *	\param 		sockEch : socket STREAM dont sockEch->entree a été rempli (moteur d'E/S)
+ *	\param 		msg : message extrait (terminé par \0)
+ *	\param 		msgSize : taille de l'espace mémoire préalablement alloué à msg
+ *	\note		Un message plus long que msgSize ou que le buffer est ignoré en entier
+ *				(octets écartés jusqu'à son \0) : la socket n'est jamais bloquée et le
+ *				découpage des messages suivants est préservé
+ *	\result		1 si un message a été extrait, 0 si aucun message n'est complet
+ */
+int extraireMessage(socket_t *sockEch, char *msg, int msgSize);
+/**
+ *	\fn			void envoyerIov(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Envoi immédiat d'un message STREAM fourni en morceaux, sans recopie
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux du message (le dernier doit contenir le \0)
+ *	\param 		nb : nombre de morceaux (au plus MAX_MORCEAUX)
+ *	\note		Les messages empilés auparavant partent dans le même appel writev
+ */
+void envoyerIov(socket_t *sockEch, struct iovec *morceaux, int nb);
+/**
+ *	\fn			void empilerIov(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Empile un message STREAM dans le buffer d'émission de la socket
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux du message (le dernier doit contenir le \0)
+ *	\param 		nb : nombre de morceaux (au plus MAX_MORCEAUX)
+ *	\note		Le message ne part qu'au prochain viderSortie/envoyerIov, ou quand
+ *				le buffer d'émission est plein
+ *	\note		Socket confiée au moteur d'E/S (idMoteur) : un buffer plein n'est pas
+ *				vidé, la connexion est coupée (shutdown) et le message perdu
+ */
+void empilerIov(socket_t *sockEch, struct iovec *morceaux, int nb);
+/**
+ *	\fn			void viderSortie(socket_t *sockEch)
+ *	\brief		Émet en un seul appel système les messages empilés sur la socket
+ *	\param 		sockEch : socket STREAM dont le buffer d'émission est à vider
+ */
+void viderSortie(socket_t *sockEch);
+/**
+ *	\fn			int envoyerIovSansAttente(socket_t *sockEch, struct iovec *morceaux, int nb)
+ *	\brief		Émet ce qui peut partir immédiatement d'une suite de morceaux STREAM,
+ *				sans bloquer ni lever SIGPIPE
+ *	\param 		sockEch : socket STREAM à utiliser pour l'envoi
+ *	\param 		morceaux : morceaux à émettre (le buffer d'émission n'est pas utilisé)
+ *	\param 		nb : nombre de morceaux
+ *	\result		nombre d'octets émis (0 si la socket est pleine), -1 en cas d'erreur
+ */
+int envoyerIovSansAttente(socket_t *sockEch, struct iovec *morceaux, int nb);
+/**
+ *	\fn			int envoyerLot(socket_t *sockEch, datagramme_t *lot, int nb)
+ *	\brief		Envoi d'un lot de datagrammes en un minimum d'appels système (sendmmsg)
+ *	\param 		sockEch : socket DGRAM à utiliser pour l'envoi
+ *	\param 		lot : datagrammes à envoyer (buff, len, addr et addrLen remplis)
+ *	\param 		nb : nombre de datagrammes du lot
+ *	\result		nombre de datagrammes envoyés, -1 si aucun n'a pu l'être
+ *	\note		un datagramme refusé (destinataire injoignable...) est abandonné et
+ *				l'envoi reprend au suivant
+ *	\note		Contrairement à envoyer(), une erreur ne termine pas le programme :
+ *				un serveur qui répond en masse ne doit pas s'arrêter sur un envoi raté
+ */
+int envoyerLot(socket_t *sockEch, datagramme_t *lot, int nb);
+/**
+ *	\fn			int recevoirLot(socket_t *sockEch, datagramme_t *lot, int nb)
+ *	\brief		Réception d'un lot de datagrammes en un seul appel système (recvmmsg)
+ *	\param 		sockEch : socket DGRAM à utiliser pour la réception
+ *	\param 		lot : tableau d'au moins nb datagrammes à remplir
+ *	\param 		nb : nombre maximum de datagrammes à recevoir
+ *	\note		Bloque jusqu'à l'arrivée d'au moins un datagramme puis récupère
+ *				sans attendre ceux déjà en file. Chaque buff est terminé par '\0'.
+ *	\result		nombre de datagrammes reçus, -1 en cas d'erreur
+ */
+int recevoirLot(socket_t *sockEch, datagramme_t *lot, int nb);
+/**
+ *	\fn			int envoyerDescripteurs(socket_t *sockEch, int *fds, int nbFds, void *donnees, int taille)
+ *	\brief		Transmet des descripteurs ouverts à un autre processus (SCM_RIGHTS)
+ *	\param 		sockEch : socket AF_UNIX STREAM connectée au processus destinataire
+ *	\param 		fds : descripteurs à transmettre (restent ouverts chez l'émetteur)
+ *	\param 		nbFds : nombre de descripteurs (au plus MAX_DESCRIPTEURS, 0 accepté)
+ *	\param 		donnees : données d'accompagnement, émises en entier
+ *	\param 		taille : taille des données (au moins 1 octet)
+ *	\result		0 en cas de succès, -1 sinon
+ */
+int envoyerDescripteurs(socket_t *sockEch, int *fds, int nbFds, void *donnees, int taille);
+/**
+ *	\fn			int recevoirDescripteurs(socket_t *sockEch, int *fds, int maxFds, void *donnees, int taille)
+ *	\brief		Reçoit un message émis par envoyerDescripteurs
+ *	\param 		sockEch : socket AF_UNIX STREAM connectée au processus émetteur
+ *	\param 		fds : tableau d'au moins maxFds descripteurs à remplir
+ *	\param 		maxFds : nombre maximum de descripteurs attendus
+ *	\param 		donnees : données d'accompagnement, reçues en entier
+ *	\param 		taille : taille des données attendues
+ *	\result		nombre de descripteurs reçus, -1 en cas d'erreur ou de fermeture
  */
-void recevoir(socket_t *sockEch, generic quoi, pFct deSerial);
+int recevoirDescripteurs(socket_t *sockEch, int *fds, int maxFds, void *donnees, int taille);
 
 
 #endif /* DATA_H */
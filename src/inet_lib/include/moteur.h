@@ -0,0 +1,172 @@
+/**
+ *	\file		moteur.h
+ *	\brief		Spécification du moteur d'entrées/sorties asynchrones (io_uring ou epoll)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#ifndef MOTEUR_H
+#define MOTEUR_H
+/*
+*****************************************************************************************
+ *	\noop		I N C L U D E S   S P E C I F I Q U E S
+ */
+#include "session.h"
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ *	\def		MAX_EVENEMENTS
+ *	\brief		nombre maximum d'événements rendus par un appel à moteurAttendre
+ */
+#define MAX_EVENEMENTS	64
+/**
+ *	\def		PAUSE_ACCEPTATION
+ *	\brief		délai en millisecondes avant de réarmer une acceptation en échec
+ *				(plus de descripteurs...) : la réarmer aussitôt bouclerait
+ */
+#define PAUSE_ACCEPTATION	100
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ *	\enum		typeEvenement
+ *	\brief		Nature d'une opération terminée
+ */
+enum typeEvenement {
+	EV_ACCEPTATION,		/**< connexion acceptée : res est le fd de la socket de dialogue	*/
+	EV_RECEPTION,		/**< octets ajoutés à sock->entree : res est leur nombre (0 : fermée)	*/
+	EV_EMISSION			/**< sock->sortie entièrement émis : res est le nombre d'octets	*/
+};
+/**
+ *	\typedef	typeEvenement_t
+ *	\brief		Définition du type de données typeEvenement_t
+ */
+typedef enum typeEvenement typeEvenement_t;
+/**
+ *	\struct		evenement
+ *	\brief		Opération terminée rendue par moteurAttendre
+ *	\note		res est négatif (-errno) en cas d'erreur
+ */
+struct evenement {
+	typeEvenement_t type;		/**< nature de l'opération terminée				*/
+	socket_t 		*sock;		/**< socket concernée							*/
+	void 			*ctx;		/**< contexte fourni à moteurAjouter			*/
+	int 			res;		/**< résultat de l'opération					*/
+};
+/**
+ *	\typedef	evenement_t
+ *	\brief		Définition du type de données evenement_t
+ */
+typedef struct evenement evenement_t;
+/**
+ *	\typedef	moteur_t
+ *	\brief		Moteur d'E/S : io_uring si disponible à la compilation, epoll sinon
+ */
+typedef struct moteur moteur_t;
+/*
+*****************************************************************************************
+ *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
+ */
+/**
+ *	\fn			moteur_t *creerMoteur (int capacite)
+ *	\brief		Création d'un moteur d'E/S
+ *	\param		capacite : nombre maximum de sockets suivies simultanément
+ *	\result		le moteur créé
+ */
+moteur_t *creerMoteur (int capacite);
+/**
+ *	\fn			void detruireMoteur (moteur_t *moteur)
+ *	\brief		Destruction d'un moteur d'E/S (les sockets ne sont pas fermées)
+ *	\param		moteur : moteur à détruire
+ */
+void detruireMoteur (moteur_t *moteur);
+/**
+ *	\fn			const char *nomMoteur (void)
+ *	\brief		Nom du backend compilé ("io_uring" ou "epoll")
+ */
+const char *nomMoteur (void);
+/**
+ *	\fn			int moteurAjouter (moteur_t *moteur, socket_t *sock, void *ctx)
+ *	\brief		Confie une socket au moteur
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket à suivre (son adresse doit rester valide jusqu'au retrait)
+ *	\param		ctx : contexte rendu avec chaque événement de la socket
+ *	\note		Avec io_uring, les buffers entree/sortie de la socket sont enregistrés
+ *				auprès du noyau (lectures/écritures sur buffers fixes)
+ *	\result		0 en cas de succès, -1 si le moteur est plein
+ */
+int moteurAjouter (moteur_t *moteur, socket_t *sock, void *ctx);
+/**
+ *	\fn			void moteurRetirer (moteur_t *moteur, socket_t *sock)
+ *	\brief		Retire une socket du moteur (aucune opération ne doit être en cours)
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket à retirer
+ */
+void moteurRetirer (moteur_t *moteur, socket_t *sock);
+/**
+ *	\fn			void moteurDetacher (moteur_t *moteur, socket_t *sock)
+ *	\brief		Retire une socket du moteur même si une opération est en cours, pour
+ *				la confier à un autre processus
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket à détacher
+ *	\note		L'opération en cours est annulée et ce qu'elle a déjà reçu ou émis est
+ *				reporté dans sock->entree et sock->sortie, qui décrivent alors exactement
+ *				l'état de la connexion. Les connexions acceptées par une socket d'écoute
+ *				détachée avant l'annulation sont encore rendues par moteurAttendre.
+ */
+void moteurDetacher (moteur_t *moteur, socket_t *sock);
+/**
+ *	\fn			void moteurAccepter (moteur_t *moteur, socket_t *sockEcoute)
+ *	\brief		Arme l'acceptation continue des connexions sur une socket d'écoute
+ *	\param		moteur : moteur d'E/S
+ *	\param		sockEcoute : socket d'écoute préalablement ajoutée
+ *	\note		Chaque connexion produit un EV_ACCEPTATION ; l'acceptation reste armée
+ *	\note		Une acceptation en échec durable (EMFILE, ENFILE...) est suspendue
+ *				PAUSE_ACCEPTATION ms puis réarmée ; avec io_uring, un noyau sans
+ *				acceptation multiple (< 5.19) est servi par une soumission par connexion
+ */
+void moteurAccepter (moteur_t *moteur, socket_t *sockEcoute);
+/**
+ *	\fn			void moteurRecevoir (moteur_t *moteur, socket_t *sock)
+ *	\brief		Arme une réception à la suite de sock->entree
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket préalablement ajoutée
+ *	\note		Produit un EV_RECEPTION ; à réarmer après chaque événement
+ */
+void moteurRecevoir (moteur_t *moteur, socket_t *sock);
+/**
+ *	\fn			void moteurEnvoyer (moteur_t *moteur, socket_t *sock)
+ *	\brief		Arme l'émission de sock->sortie
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket préalablement ajoutée
+ *	\note		Produit un EV_EMISSION une fois sock->sortie entièrement émis ;
+ *				sock->sortie ne doit pas être modifié d'ici là
+ *	\note		Un pair parti rend une erreur (EPIPE) sans SIGPIPE, sauf avec io_uring
+ *				sur buffers fixes, qui n'accepte pas MSG_NOSIGNAL : y ignorer SIGPIPE
+ */
+void moteurEnvoyer (moteur_t *moteur, socket_t *sock);
+/**
+ *	\fn			int moteurReceptionArmee (moteur_t *moteur, socket_t *sock)
+ *	\brief		Indique si une réception est armée sur une socket
+ *	\param		moteur : moteur d'E/S
+ *	\param		sock : socket préalablement ajoutée
+ *	\result		1 si la réception n'a pas encore été rendue par moteurAttendre, 0 sinon
+ */
+int moteurReceptionArmee (moteur_t *moteur, socket_t *sock);
+/**
+ *	\fn			int moteurAttendre (moteur_t *moteur, evenement_t *evts, int max, int delai)
+ *	\brief		Soumet en un lot les opérations armées et attend leurs terminaisons
+ *	\param		moteur : moteur d'E/S
+ *	\param		evts : tableau d'au moins max événements à remplir
+ *	\param		max : nombre maximum d'événements à rendre
+ *	\param		delai : délai d'attente maximum en ms (-1 : infini)
+ *	\result		nombre d'événements rendus (0 si délai écoulé), -1 en cas d'erreur
+ *				(errno positionné, EINTR si interrompu par un signal)
+ */
+int moteurAttendre (moteur_t *moteur, evenement_t *evts, int max, int delai);
+
+
+#endif /* MOTEUR_H */
@@ -20,11 +20,41 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <stddef.h>
+#include <errno.h>
 
 #ifdef DEBUG_ENABLED
 	#include "logging.h"
 #endif
 /*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ *	\def		ADR_SIZE
+ *	\brief		taille d'une adresse IP (IPv4 ou IPv6) au format humain, \0 compris
+ */
+#define ADR_SIZE	INET6_ADDRSTRLEN
+/**
+ *	\def		PREFIXE_UNIX
+ *	\brief		préfixe désignant une adresse de socket locale (AF_UNIX) : "unix:/chemin"
+ */
+#define PREFIXE_UNIX	"unix:"
+/**
+ *	\def		TAILLE_ENTREE
+ *	\brief		taille du buffer de réception d'une socket STREAM
+ *	\note		doit contenir au moins un message complet (\0 compris)
+ */
+#define TAILLE_ENTREE	1024
+/**
+ *	\def		TAILLE_SORTIE
+ *	\brief		taille du buffer d'émission d'une socket STREAM
+ *	\note		les messages empilés y sont regroupés pour un seul appel système
+ */
+#define TAILLE_SORTIE	4096
+/*
 *****************************************************************************************
  *	\noop		S T R C T U R E S   DE   D O N N E E S
  */
@@ -33,12 +63,23 @@
  *	\brief		Définition de la structure de données socket
  *	\note		Ce type est composé du fd de la socket, du mode (connecté/non)
  *				et des adresses applicatives (locale/distante)
+ *	\note		Les adresses sont stockées dans des sockaddr_storage : la famille
+ *				(PF_INET/PF_INET6/PF_UNIX) est donnée par le champ ss_family
+ *	\note		En mode STREAM, la socket porte ses buffers de réception (découpage
+ *				des messages terminés par \0) et d'émission (regroupement des envois)
  */
 struct socket {
-	int fd;							/**< numéro de la socket créée			*/
-	int mode;						/**< mode connecté/non : STREAM/DGRAM	*/
-	struct sockaddr_in addrLoc;		/**< adresse locale de la socket 		*/
-	struct sockaddr_in addrDst;		/**< adresse distante de la socket 		*/
+	int fd;								/**< numéro de la socket créée			*/
+	int mode;							/**< mode connecté/non : STREAM/DGRAM	*/
+	struct sockaddr_storage addrLoc;	/**< adresse locale de la socket 		*/
+	struct sockaddr_storage addrDst;	/**< adresse distante de la socket 		*/
+	char entree[TAILLE_ENTREE];			/**< octets reçus non encore consommés	*/
+	int nbEntree;						/**< nombre d'octets dans entree		*/
+	int rejet;							/**< message trop long ignoré jusqu'au \0*/
+	char sortie[TAILLE_SORTIE];			/**< messages empilés non encore émis	*/
+	int nbSortie;						/**< nombre d'octets dans sortie		*/
+	unsigned int nbMessages;			/**< messages empilés ou émis			*/
+	int idMoteur;						/**< emplacement moteur d'E/S (0: aucun)*/
 };
 /**
  *	\typedef	socket_t
@@ -50,22 +91,50 @@ typedef struct socket socket_t;
  *	\noop		P R O T O T Y P E S   DES   F O N C T I O N S
  */
 /**
- *	\fn			void adr2struct (struct sockaddr_in *addr, char *adrIP, short port)
+ *	\fn			socklen_t adr2struct (struct sockaddr_storage *addr, char *adrIP, short port)
  *	\brief		Transformer une adresse au format humain en structure SocketBSD
- *	\param		addr : structure d'adressage BSD d'une socket INET
- *	\param		adrIP : adresse IP de la socket créée
- *	\param		port : port de la socket créée
- *	\note		Le domaine dépend du mode choisi (TCP/UDP)
- *	\result		paramètre *adr modifié
+ *	\param		addr : structure d'adressage BSD d'une socket INET/INET6/UNIX
+ *	\param		adrIP : adresse IP de la socket créée (IPv4 pointée, IPv6 ou unix:/chemin)
+ *	\param		port : port de la socket créée (ignoré pour une socket locale)
+ *	\note		La famille est déduite de la syntaxe de adrIP
+ *	\result		paramètre *adr modifié, retourne la taille utile de l'adresse,
+ *				0 si adrIP est invalide ou le chemin trop long
+ */
+socklen_t adr2struct (struct sockaddr_storage *addr, char *adrIP, short port);
+/**
+ *	\fn			int struct2adr (const struct sockaddr_storage *addr, char *adrIP, short *port)
+ *	\brief		Transformer une structure SocketBSD en adresse au format humain
+ *	\param		addr : structure d'adressage BSD d'une socket INET/INET6/UNIX
+ *	\param		adrIP : buffer d'au moins ADR_SIZE octets recevant l'adresse IP
+ *	\param		port : port de l'adresse (peut être NULL)
+ *	\note		Une adresse IPv4 mappée (::ffff:a.b.c.d) est rendue au format IPv4
+ *	\note		Une adresse locale est rendue "unix:/chemin", tronquée à ADR_SIZE
+ *	\result		paramètres adrIP et port modifiés, retourne 0 si l'adresse a été
+ *				tronquée, 1 sinon
+ */
+int struct2adr (const struct sockaddr_storage *addr, char *adrIP, short *port);
+/**
+ *	\fn			socklen_t tailleAdr (const struct sockaddr_storage *addr)
+ *	\brief		Taille utile d'une adresse selon sa famille
+ *	\param		addr : structure d'adressage BSD d'une socket
+ *	\result		taille à passer à bind/connect/sendto
+ */
+socklen_t tailleAdr (const struct sockaddr_storage *addr);
+/**
+ *	\fn			int estAdrUnix (const char *adrIP)
+ *	\brief		Indique si une adresse désigne une socket locale (unix:/chemin)
+ *	\param		adrIP : adresse au format humain
+ *	\result		1 si l'adresse est préfixée par PREFIXE_UNIX, 0 sinon
  */
-void adr2struct (struct sockaddr_in *addr, char *adrIP, short port);
+int estAdrUnix (const char *adrIP);
 /**
- *	\fn			socket_t creerSocket (int mode)
+ *	\fn			socket_t creerSocket (int famille, int mode)
  *	\brief		Création d'une socket de type DGRAM/STREAM
+ *	\param		famille : famille de la socket (PF_INET/PF_INET6/PF_UNIX)
  *	\param		mode : mode connecté (STREAM) ou non (DGRAM)
  *	\result		socket créée selon le mode choisi
  */
-socket_t creerSocket (int mode);
+socket_t creerSocket (int famille, int mode);
 /**
  *	\fn			socket_t creerSocketAdr (int mode, char *adrIP, short port)
  *	\brief		Création d'une socket de type DGRAM/STREAM
@@ -73,6 +142,8 @@ socket_t creerSocket (int mode);
  *	\param		adrIP : adresse IP de la socket créée
  *	\param		port : port de la socket créée
  *	\result		socket créée dans le domaine choisi avec l'adressage fourni
+ *	\note		Le fichier d'une socket locale n'est remplacé que s'il s'agit d'une
+ *				socket où plus personne n'écoute
  */
 socket_t creerSocketAdr (int mode, char *adrIP, short port);
 /**
@@ -82,8 +153,19 @@ socket_t creerSocketAdr (int mode, char *adrIP, short port);
  *	\param		port : port TCP du serveur à mettre en écoute
  *	\result		socket créée avec l'adressage fourni en paramètre et dans un état d'écoute
  *	\note		Le domaine est nécessairement STREAM
+ *	\note		Une écoute sur "::" est double pile (IPv4 et IPv6) ; si l'IPv6 est
+ *				indisponible sur la machine, l'écoute se replie sur "0.0.0.0"
  */
 socket_t creerSocketEcoute (char *adrIP, short port);
+/**
+ *	\fn			int fermerSocketEcoute (socket_t *sockEcoute)
+ *	\brief		Fermeture d'une socket d'écoute
+ *	\param		sockEcoute : socket d'écoute à fermer
+ *	\note		Pour une socket locale, le fichier de la socket est aussi supprimé
+ *				(seulement s'il s'agit toujours d'une socket)
+ *	\result		0 en cas de succès, -1 sinon (errno positionné par close)
+ */
+int fermerSocketEcoute (socket_t *sockEcoute);
 /**
  *	\fn			socket_t accepterClt (const socket_t sockEcoute)
  *	\brief		Acceptation d'une demande de connexion d'un client
@@ -91,6 +173,15 @@ socket_t creerSocketEcoute (char *adrIP, short port);
  *	\result		socket (dialogue) connectée par le serveur avec un client
  */
 socket_t accepterClt (const socket_t sockEcoute);
+/**
+ *	\fn			socket_t fd2socket (int fd, int mode)
+ *	\brief		Construit une socket_t autour d'un fd déjà ouvert (accepté par
+ *				un moteur d'E/S, reçu d'un autre processus...)
+ *	\param		fd : descripteur de la socket
+ *	\param		mode : mode connecté (STREAM) ou non (DGRAM)
+ *	\result		socket dont les adresses locale/distante sont lues sur le fd
+ */
+socket_t fd2socket (int fd, int mode);
 /**
  *	\fn			socket_t connecterClt2Srv (char *adrIP, short port)
  *	\brief		Crétaion d'une socket d'appel et connexion au seveur dont
@@ -101,9 +192,9 @@ socket_t accepterClt (const socket_t sockEcoute);
  */
 socket_t connecterClt2Srv (char *adrIP, short port);
 /**
- * @brief      récupère l'adresse IPv4 LAN du client
+ * @brief      récupère l'adresse LAN (IPv4 ou IPv6) du client
  *
- * @param      ipBuffer  le buffer à remplir avec l'adresse IPv4
+ * @param      ipBuffer  le buffer (ADR_SIZE octets) à remplir avec l'adresse
  */
 void getIpAddress(char *ipBuffer);
 
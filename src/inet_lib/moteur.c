@@ -0,0 +1,673 @@
+/**
+ *	\file		moteur.c
+ *	\brief		Implémentation du moteur d'entrées/sorties asynchrones
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ *	\note		Compilé avec HAVE_LIBURING, le moteur soumet les acceptations,
+ *				réceptions et émissions par lots dans un anneau io_uring, sur les
+ *				buffers enregistrés des sockets. Sinon, il les réalise lui-même
+ *				à la disponibilité signalée par epoll.
+ */
+#define _GNU_SOURCE			// accept4
+#include <fcntl.h>
+#include <time.h>
+#include "moteur.h"
+#ifdef HAVE_LIBURING
+	#include <liburing.h>
+#else
+	#include <sys/epoll.h>
+#endif
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   M A C R O S
+ */
+/**
+ *	\def		CHECK(sts, msg)
+ *	\brief		Macro-fonction qui vérifie que sts est égal -1 (cas d'erreur : sts==-1) 
+ *				En cas d'erreur, il y a affichage du message adéquat et fin d'exécution  
+ */
+#define CHECK(sts, msg) if ((sts)==-1) {perror(msg); exit(-1);}
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ *	\enum		operation
+ *	\brief		Opération armée sur un emplacement
+ */
+enum operation {OP_AUCUNE, OP_ACCEPTATION, OP_RECEPTION, OP_EMISSION, OP_ANNULATION, OP_PAUSE};
+/**
+ *	\struct		emplacement
+ *	\brief		Socket suivie par le moteur
+ */
+struct emplacement {
+	socket_t 		*sock;		/**< socket suivie (NULL : emplacement libre)	*/
+	void 			*ctx;		/**< contexte de l'utilisateur					*/
+	enum operation 	op;			/**< opération en cours							*/
+	int 			suivant;	/**< emplacement libre suivant (-1 : aucun)		*/
+#ifndef HAVE_LIBURING
+	long long 		reprise;	/**< fin de la pause d'une acceptation (ms)		*/
+#endif
+};
+/**
+ *	\struct		moteur
+ *	\brief		Définition du moteur d'E/S
+ */
+struct moteur {
+	int 				capacite;		/**< nombre d'emplacements				*/
+	struct emplacement	*emplacements;	/**< table des sockets suivies			*/
+	int 				libre;			/**< premier emplacement libre			*/
+#ifdef HAVE_LIBURING
+	struct io_uring 	anneau;			/**< files de soumission/terminaison	*/
+	int 				tamponsFixes;	/**< buffers enregistrés disponibles	*/
+	evenement_t 		*enAttente;		/**< événements reçus pendant un détachement */
+	int 				nbEnAttente;	/**< nombre d'événements en attente		*/
+	int 				maxEnAttente;	/**< taille du tableau enAttente		*/
+	int 				acceptUnique;	/**< noyau sans acceptation multiple	*/
+	struct __kernel_timespec pause;		/**< durée d'une pause d'acceptation	*/
+#else
+	int 				epfd;			/**< instance epoll						*/
+	int 				nbEnPause;		/**< acceptations suspendues			*/
+#endif
+};
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S   C O M M U N E S
+ */
+moteur_t *creerMoteur (int capacite) {
+
+	moteur_t *moteur = malloc(sizeof(moteur_t));
+
+	moteur->capacite 		= capacite;
+	moteur->emplacements 	= calloc(capacite, sizeof(struct emplacement));
+	moteur->libre 			= 0;
+
+	for (int i = 0; i < capacite; i++)
+		moteur->emplacements[i].suivant = i + 1 < capacite ? i + 1 : -1;
+
+#ifdef HAVE_LIBURING
+	int sts = io_uring_queue_init(capacite < MAX_EVENEMENTS ? MAX_EVENEMENTS : capacite
+		, &moteur->anneau, 0);
+	if (sts < 0) { errno = -sts; perror("Can't init io_uring"); exit(-1); }
+
+	// deux buffers fixes par emplacement : entree puis sortie
+	moteur->tamponsFixes = io_uring_register_buffers_sparse(&moteur->anneau, 2 * capacite) == 0;
+
+	moteur->enAttente 		= NULL;
+	moteur->nbEnAttente 	= 0;
+	moteur->maxEnAttente 	= 0;
+	moteur->acceptUnique 	= 0;
+	moteur->pause 			= (struct __kernel_timespec) {0, PAUSE_ACCEPTATION * 1000000L};
+#else
+	CHECK(moteur->epfd = epoll_create1(EPOLL_CLOEXEC), "Can't create epoll");
+	moteur->nbEnPause = 0;
+#endif
+
+	return moteur;
+
+}
+
+
+void detruireMoteur (moteur_t *moteur) {
+
+#ifdef HAVE_LIBURING
+	io_uring_queue_exit(&moteur->anneau);
+	free(moteur->enAttente);
+#else
+	close(moteur->epfd);
+#endif
+
+	free(moteur->emplacements);
+	free(moteur);
+
+}
+
+
+const char *nomMoteur (void) {
+
+#ifdef HAVE_LIBURING
+	return "io_uring";
+#else
+	return "epoll";
+#endif
+
+}
+/**
+ *	\fn			static struct emplacement *emplacementDe (moteur_t *moteur, socket_t *sock)
+ *	\brief		Emplacement d'une socket ajoutée au moteur
+ */
+static struct emplacement *emplacementDe (moteur_t *moteur, socket_t *sock) {
+
+	return &moteur->emplacements[sock->idMoteur - 1];
+
+}
+
+
+int moteurReceptionArmee (moteur_t *moteur, socket_t *sock) {
+
+	return emplacementDe(moteur, sock)->op == OP_RECEPTION;
+
+}
+/**
+ *	\fn			static int erreurPassagere (int err)
+ *	\brief		Indique si l'échec d'une acceptation ne concerne que la connexion
+ *				refusée (client parti avant l'acceptation...)
+ *	\result		1 si l'acceptation peut être réarmée aussitôt, 0 sinon
+ */
+static int erreurPassagere (int err) {
+
+	return err == ECONNABORTED || err == EINTR || err == EAGAIN || err == EPROTO;
+
+}
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ *					B A C K E N D   I O _ U R I N G
+ */
+#ifdef HAVE_LIBURING
+/**
+ *	\def		DONNEES(id, op)
+ *	\brief		Encode l'emplacement et l'opération dans le user_data d'une soumission
+ */
+#define DONNEES(id, op)	(((__u64) (id) << 8) | (op))
+/**
+ *	\fn			static struct io_uring_sqe *soumission (moteur_t *moteur)
+ *	\brief		Réserve une entrée de soumission, en vidant la file si elle est pleine
+ */
+static struct io_uring_sqe *soumission (moteur_t *moteur) {
+
+	struct io_uring_sqe *sqe;
+
+	while ((sqe = io_uring_get_sqe(&moteur->anneau)) == NULL)
+		io_uring_submit(&moteur->anneau);
+
+	return sqe;
+
+}
+
+
+/**
+ *	\fn			static void reprendreAcceptation (moteur_t *moteur, socket_t *sockEcoute, int res)
+ *	\brief		Réarme une acceptation terminée avec le résultat res
+ */
+static void reprendreAcceptation (moteur_t *moteur, socket_t *sockEcoute, int res) {
+
+	struct io_uring_sqe *sqe;
+
+	// noyau antérieur au 5.19 : une soumission par connexion
+	if (res == -EINVAL && !moteur->acceptUnique) moteur->acceptUnique = 1;
+
+	// plus de descripteurs (EMFILE, ENFILE...) : réarmer aussitôt bouclerait
+	else if (res < 0 && !erreurPassagere(-res)) {
+
+		sqe = soumission(moteur);
+		io_uring_prep_timeout(sqe, &moteur->pause, 0, 0);
+		io_uring_sqe_set_data64(sqe, DONNEES(sockEcoute->idMoteur - 1, OP_PAUSE));
+		emplacementDe(moteur, sockEcoute)->op = OP_PAUSE;
+		return;
+
+	}
+
+	moteurAccepter(moteur, sockEcoute);
+
+}
+/**
+ *	\fn			static void traiter (moteur_t *moteur, struct io_uring_cqe *cqe, evenement_t *evts, int *nb)
+ *	\brief		Traduit une terminaison en événement, ajouté à evts[*nb]
+ */
+static void traiter (moteur_t *moteur, struct io_uring_cqe *cqe, evenement_t *evts, int *nb) {
+
+	int 				id 	= io_uring_cqe_get_data64(cqe) >> 8;
+	enum operation 		op 	= io_uring_cqe_get_data64(cqe) & 0xFF;
+	struct emplacement 	*e 	= &moteur->emplacements[id];
+
+	switch (op) {
+
+		case OP_ACCEPTATION:
+			// acceptation unique, ou multiple interrompue par le noyau : la réarmer
+			// (sauf annulation)
+			if (!(cqe->flags & IORING_CQE_F_MORE) && e->op == OP_ACCEPTATION)
+				reprendreAcceptation(moteur, e->sock, cqe->res);
+			if (cqe->res < 0) return;
+			evts[(*nb)++] = (evenement_t) {EV_ACCEPTATION, e->sock, e->ctx, cqe->res};
+			break;
+
+		case OP_PAUSE:
+			// fin de la pause (sauf annulation)
+			if (e->op == OP_PAUSE) moteurAccepter(moteur, e->sock);
+			break;
+
+		case OP_RECEPTION:
+			e->op = OP_AUCUNE;
+			if (cqe->res > 0) e->sock->nbEntree += cqe->res;
+			evts[(*nb)++] = (evenement_t) {EV_RECEPTION, e->sock, e->ctx, cqe->res};
+			break;
+
+		case OP_EMISSION:
+			if (cqe->res > 0 && cqe->res < e->sock->nbSortie) {
+				// émission partielle : renvoyer le reste
+				e->sock->nbSortie -= cqe->res;
+				memmove(e->sock->sortie, e->sock->sortie + cqe->res, e->sock->nbSortie);
+				moteurEnvoyer(moteur, e->sock);
+				return;
+			}
+			e->op = OP_AUCUNE;
+			if (cqe->res > 0) e->sock->nbSortie = 0;
+			evts[(*nb)++] = (evenement_t) {EV_EMISSION, e->sock, e->ctx, cqe->res};
+			break;
+
+		default:
+			// terminaison d'une annulation
+			break;
+
+	}
+
+}
+/**
+ *	\fn			static void mettreEnAttente (moteur_t *moteur, struct io_uring_cqe *cqe)
+ *	\brief		Traduit une terminaison reçue pendant un détachement et garde
+ *				l'événement pour le prochain moteurAttendre
+ */
+static void mettreEnAttente (moteur_t *moteur, struct io_uring_cqe *cqe) {
+
+	if (moteur->nbEnAttente == moteur->maxEnAttente) {
+		moteur->maxEnAttente 	= moteur->maxEnAttente ? 2 * moteur->maxEnAttente : MAX_EVENEMENTS;
+		moteur->enAttente 		= realloc(moteur->enAttente, moteur->maxEnAttente * sizeof(evenement_t));
+	}
+
+	traiter(moteur, cqe, moteur->enAttente, &moteur->nbEnAttente);
+
+}
+
+
+int moteurAjouter (moteur_t *moteur, socket_t *sock, void *ctx) {
+
+	int id = moteur->libre;
+
+	if (id == -1) return -1;
+
+	moteur->libre 					= moteur->emplacements[id].suivant;
+	moteur->emplacements[id].sock 	= sock;
+	moteur->emplacements[id].ctx 	= ctx;
+	moteur->emplacements[id].op 	= OP_AUCUNE;
+	sock->idMoteur 					= id + 1;
+
+	if (moteur->tamponsFixes) {
+
+		struct iovec tampons[2] = {
+			{sock->entree, TAILLE_ENTREE},
+			{sock->sortie, TAILLE_SORTIE}
+		};
+
+		if (io_uring_register_buffers_update_tag(&moteur->anneau, 2 * id, tampons, NULL, 2) < 0)
+			moteur->tamponsFixes = 0;
+
+	}
+
+	return 0;
+
+}
+
+
+void moteurRetirer (moteur_t *moteur, socket_t *sock) {
+
+	int id = sock->idMoteur - 1;
+
+	if (moteur->tamponsFixes) {
+
+		// un iovec vide libère l'emplacement de la table des buffers
+		struct iovec vides[2] = {{NULL, 0}, {NULL, 0}};
+		io_uring_register_buffers_update_tag(&moteur->anneau, 2 * id, vides, NULL, 2);
+
+	}
+
+	moteur->emplacements[id].sock 		= NULL;
+	moteur->emplacements[id].suivant 	= moteur->libre;
+	moteur->libre 						= id;
+	sock->idMoteur 						= 0;
+
+}
+
+
+void moteurDetacher (moteur_t *moteur, socket_t *sock) {
+
+	int 					id 		= sock->idMoteur - 1;
+	enum operation 			op 		= moteur->emplacements[id].op;
+	__u64 					cible 	= DONNEES(id, op);
+	struct io_uring_sqe 	*sqe;
+	struct io_uring_cqe 	*cqe;
+	int 					termine = op == OP_AUCUNE;
+
+	if (!termine) {
+
+		sqe = soumission(moteur);
+		io_uring_prep_cancel64(sqe, cible, 0);
+		io_uring_sqe_set_data64(sqe, DONNEES(id, OP_ANNULATION));
+		moteur->emplacements[id].op = OP_ANNULATION;
+
+	}
+
+	// attendre la dernière terminaison de l'opération annulée ; les autres sont gardées
+	while (!termine) {
+
+		int sts = io_uring_submit_and_wait(&moteur->anneau, 1);
+
+		if (sts == -EINTR) continue;
+		if (sts < 0) { errno = -sts; perror("Can't cancel"); exit(-1); }
+
+		while (!termine && io_uring_peek_cqe(&moteur->anneau, &cqe) == 0) {
+
+			int derniere = io_uring_cqe_get_data64(cqe) == cible
+				&& !(cqe->flags & IORING_CQE_F_MORE);
+
+			// connexions acceptées avant l'annulation, autres sockets...
+			if (!derniere || op == OP_ACCEPTATION)
+				mettreEnAttente(moteur, cqe);
+			else if (op == OP_RECEPTION && cqe->res > 0)
+				sock->nbEntree += cqe->res;
+			else if (op == OP_EMISSION && cqe->res > 0) {
+				sock->nbSortie -= cqe->res;
+				memmove(sock->sortie, sock->sortie + cqe->res, sock->nbSortie);
+			}
+
+			termine = derniere;
+			io_uring_cqe_seen(&moteur->anneau, cqe);
+
+		}
+
+	}
+
+	moteurRetirer(moteur, sock);
+
+}
+
+
+void moteurAccepter (moteur_t *moteur, socket_t *sockEcoute) {
+
+	struct io_uring_sqe *sqe = soumission(moteur);
+
+	// une seule soumission produit une terminaison par connexion acceptée
+	if (moteur->acceptUnique) 	io_uring_prep_accept(sqe, sockEcoute->fd, NULL, NULL, 0);
+	else 						io_uring_prep_multishot_accept(sqe, sockEcoute->fd, NULL, NULL, 0);
+	io_uring_sqe_set_data64(sqe, DONNEES(sockEcoute->idMoteur - 1, OP_ACCEPTATION));
+	emplacementDe(moteur, sockEcoute)->op = OP_ACCEPTATION;
+
+}
+
+
+void moteurRecevoir (moteur_t *moteur, socket_t *sock) {
+
+	struct io_uring_sqe *sqe 	= soumission(moteur);
+	int 				id 		= sock->idMoteur - 1;
+	char 				*debut 	= sock->entree + sock->nbEntree;
+	unsigned 			taille 	= TAILLE_ENTREE - sock->nbEntree;
+
+	if (moteur->tamponsFixes) io_uring_prep_read_fixed(sqe, sock->fd, debut, taille, 0, 2 * id);
+	else io_uring_prep_recv(sqe, sock->fd, debut, taille, 0);
+
+	io_uring_sqe_set_data64(sqe, DONNEES(id, OP_RECEPTION));
+	moteur->emplacements[id].op = OP_RECEPTION;
+
+}
+
+
+void moteurEnvoyer (moteur_t *moteur, socket_t *sock) {
+
+	struct io_uring_sqe *sqe 	= soumission(moteur);
+	int 				id 		= sock->idMoteur - 1;
+
+	if (moteur->tamponsFixes) io_uring_prep_write_fixed(sqe, sock->fd, sock->sortie, sock->nbSortie, 0, 2 * id + 1);
+	else io_uring_prep_send(sqe, sock->fd, sock->sortie, sock->nbSortie, MSG_NOSIGNAL);
+
+	io_uring_sqe_set_data64(sqe, DONNEES(id, OP_EMISSION));
+	moteur->emplacements[id].op = OP_EMISSION;
+
+}
+
+
+int moteurAttendre (moteur_t *moteur, evenement_t *evts, int max, int delai) {
+
+	struct io_uring_cqe 		*cqe;
+	struct __kernel_timespec 	ts = {delai / 1000, (delai % 1000) * 1000000L};
+	unsigned 					tete, consommees = 0;
+	int 						nb = 0;
+	int 						sts;
+
+	// rendre d'abord les événements mis de côté par un détachement
+	if (moteur->nbEnAttente > 0) {
+
+		nb = moteur->nbEnAttente < max ? moteur->nbEnAttente : max;
+		memcpy(evts, moteur->enAttente, nb * sizeof(evenement_t));
+		moteur->nbEnAttente -= nb;
+		memmove(moteur->enAttente, moteur->enAttente + nb, moteur->nbEnAttente * sizeof(evenement_t));
+
+		return nb;
+
+	}
+
+	// un seul appel système soumet tout ce qui a été armé et attend
+	if (delai < 0) 	sts = io_uring_submit_and_wait(&moteur->anneau, 1);
+	else 			sts = io_uring_submit_and_wait_timeout(&moteur->anneau, &cqe, 1, &ts, NULL);
+
+	if (sts == -ETIME) return 0;
+	if (sts < 0) { errno = -sts; return -1; }
+
+	io_uring_for_each_cqe(&moteur->anneau, tete, cqe) {
+
+		if (nb == max) break;
+		consommees++;
+
+		traiter(moteur, cqe, evts, &nb);
+
+	}
+
+	io_uring_cq_advance(&moteur->anneau, consommees);
+
+	return nb;
+
+}
+#else
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ *					B A C K E N D   E P O L L
+ */
+/**
+ *	\fn			static void armer (moteur_t *moteur, socket_t *sock, uint32_t evts)
+ *	\brief		Change les événements attendus sur une socket du moteur
+ */
+static void armer (moteur_t *moteur, socket_t *sock, uint32_t evts) {
+
+	struct epoll_event ev = {0};
+
+	ev.events 	= evts;
+	ev.data.u32 = sock->idMoteur - 1;
+
+	CHECK(epoll_ctl(moteur->epfd, EPOLL_CTL_MOD, sock->fd, &ev), "Can't epoll_ctl");
+
+}
+/**
+ *	\fn			static long long maintenantMs (void)
+ *	\brief		Horloge monotone des pauses d'acceptation
+ */
+static long long maintenantMs (void) {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (long long) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+
+}
+/**
+ *	\fn			static int reprendrePauses (moteur_t *moteur, int delai)
+ *	\brief		Réarme les acceptations dont la pause est finie
+ *	\result		delai, raccourci jusqu'à la fin de la prochaine pause
+ */
+static int reprendrePauses (moteur_t *moteur, int delai) {
+
+	long long maintenant = maintenantMs();
+
+	for (int i = 0; i < moteur->capacite; i++) {
+
+		struct emplacement *e = &moteur->emplacements[i];
+
+		if (e->sock == NULL || e->op != OP_PAUSE) continue;
+
+		if (e->reprise <= maintenant) {
+			moteur->nbEnPause--;
+			moteurAccepter(moteur, e->sock);
+		}
+		else if (delai < 0 || e->reprise - maintenant < delai)
+			delai = e->reprise - maintenant;
+
+	}
+
+	return delai;
+
+}
+
+
+int moteurAjouter (moteur_t *moteur, socket_t *sock, void *ctx) {
+
+	struct epoll_event 	ev = {0};
+	int 				id = moteur->libre;
+
+	if (id == -1) return -1;
+
+	moteur->libre 					= moteur->emplacements[id].suivant;
+	moteur->emplacements[id].sock 	= sock;
+	moteur->emplacements[id].ctx 	= ctx;
+	moteur->emplacements[id].op 	= OP_AUCUNE;
+	sock->idMoteur 					= id + 1;
+
+	// suivie mais désarmée tant qu'aucune opération n'est demandée
+	ev.data.u32 = id;
+	CHECK(epoll_ctl(moteur->epfd, EPOLL_CTL_ADD, sock->fd, &ev), "Can't epoll_ctl");
+
+	return 0;
+
+}
+
+
+void moteurRetirer (moteur_t *moteur, socket_t *sock) {
+
+	int id = sock->idMoteur - 1;
+
+	epoll_ctl(moteur->epfd, EPOLL_CTL_DEL, sock->fd, NULL);
+
+	if (moteur->emplacements[id].op == OP_PAUSE) moteur->nbEnPause--;
+
+	moteur->emplacements[id].sock 		= NULL;
+	moteur->emplacements[id].suivant 	= moteur->libre;
+	moteur->libre 						= id;
+	sock->idMoteur 						= 0;
+
+}
+
+
+void moteurDetacher (moteur_t *moteur, socket_t *sock) {
+
+	// les lectures et écritures sont faites par moteurAttendre : entree et sortie
+	// sont toujours à jour, il suffit de ne plus suivre la socket
+	moteurRetirer(moteur, sock);
+
+}
+
+
+void moteurAccepter (moteur_t *moteur, socket_t *sockEcoute) {
+
+	// non bloquante : on accepte toutes les connexions en attente d'un coup
+	fcntl(sockEcoute->fd, F_SETFL, fcntl(sockEcoute->fd, F_GETFL) | O_NONBLOCK);
+
+	emplacementDe(moteur, sockEcoute)->op = OP_ACCEPTATION;
+	armer(moteur, sockEcoute, EPOLLIN);
+
+}
+
+
+void moteurRecevoir (moteur_t *moteur, socket_t *sock) {
+
+	emplacementDe(moteur, sock)->op = OP_RECEPTION;
+	armer(moteur, sock, EPOLLIN | EPOLLONESHOT);
+
+}
+
+
+void moteurEnvoyer (moteur_t *moteur, socket_t *sock) {
+
+	emplacementDe(moteur, sock)->op = OP_EMISSION;
+	armer(moteur, sock, EPOLLOUT | EPOLLONESHOT);
+
+}
+
+
+int moteurAttendre (moteur_t *moteur, evenement_t *evts, int max, int delai) {
+
+	struct epoll_event 	prets[MAX_EVENEMENTS];
+	int 				nbPrets;
+	int 				nb = 0;
+
+	if (max > MAX_EVENEMENTS) max = MAX_EVENEMENTS;
+
+	if (moteur->nbEnPause > 0) delai = reprendrePauses(moteur, delai);
+
+	nbPrets = epoll_wait(moteur->epfd, prets, max, delai);
+
+	if (nbPrets == -1) return -1;
+
+	for (int i = 0; i < nbPrets && nb < max; i++) {
+
+		struct emplacement 	*e 		= &moteur->emplacements[prets[i].data.u32];
+		socket_t 			*sock 	= e->sock;
+		ssize_t 			n;
+
+		switch (e->op) {
+
+			case OP_ACCEPTATION:
+				// vider la file d'attente de la socket d'écoute
+				while (nb < max && (n = accept4(sock->fd, NULL, NULL, SOCK_CLOEXEC)) >= 0)
+					evts[nb++] = (evenement_t) {EV_ACCEPTATION, sock, e->ctx, n};
+				// plus de descripteurs (EMFILE, ENFILE...) : la connexion reste en
+				// attente et epoll la signalerait aussitôt, suspendre l'acceptation
+				if (nb < max && !erreurPassagere(errno)) {
+					e->op 		= OP_PAUSE;
+					e->reprise 	= maintenantMs() + PAUSE_ACCEPTATION;
+					moteur->nbEnPause++;
+					armer(moteur, sock, 0);
+				}
+				break;
+
+			case OP_RECEPTION:
+				e->op = OP_AUCUNE;
+				n = read(sock->fd, sock->entree + sock->nbEntree, TAILLE_ENTREE - sock->nbEntree);
+				if (n > 0) sock->nbEntree += n;
+				evts[nb++] = (evenement_t) {EV_RECEPTION, sock, e->ctx, n < 0 ? -errno : n};
+				break;
+
+			case OP_EMISSION:
+				n = send(sock->fd, sock->sortie, sock->nbSortie, MSG_NOSIGNAL);
+				if (n >= 0 && n < sock->nbSortie) {
+					// émission partielle : attendre de pouvoir envoyer le reste
+					sock->nbSortie -= n;
+					memmove(sock->sortie, sock->sortie + n, sock->nbSortie);
+					armer(moteur, sock, EPOLLOUT | EPOLLONESHOT);
+					break;
+				}
+				e->op = OP_AUCUNE;
+				if (n > 0) sock->nbSortie = 0;
+				evts[nb++] = (evenement_t) {EV_EMISSION, sock, e->ctx, n < 0 ? -errno : n};
+				break;
+
+			default:
+				break;
+
+		}
+
+	}
+
+	return nb;
+
+}
+#endif
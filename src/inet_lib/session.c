@@ -26,29 +26,179 @@
  *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
  */
 
-void adr2struct(struct sockaddr_in *addr, char *adrIP, short port) {
+/**
+ *	\fn			static int ipv6Disponible (void)
+ *	\brief		Vérifie que la machine sait créer des sockets PF_INET6
+ *	\result		1 si l'IPv6 est disponible, 0 sinon
+ */
+static int ipv6Disponible (void) {
+
+	int fd = socket(PF_INET6, SOCK_STREAM, 0);
+
+	if (fd == -1) return 0;
+
+	close(fd);
+	return 1;
+
+}
+
+
+/**
+ *	\fn			static int estFichierSocket (const char *chemin)
+ *	\brief		Vérifie que chemin désigne un fichier de socket (lien non suivi)
+ *	\result		1 si c'est une socket, 0 sinon (absent, fichier ordinaire...)
+ */
+static int estFichierSocket (const char *chemin) {
+
+	struct stat st;
+
+	return lstat(chemin, &st) == 0 && S_ISSOCK(st.st_mode);
+
+}
+/**
+ *	\fn			static int estSocketOrpheline (int mode, const struct sockaddr_un *addrU)
+ *	\brief		Vérifie que le fichier de socket addrU a été laissé par une exécution
+ *				précédente : c'est une socket et personne n'y répond plus
+ *	\param		mode : mode de la socket à créer (STREAM/DGRAM)
+ *	\param		addrU : adresse locale de la socket à créer
+ *	\result		1 si le fichier peut être supprimé, 0 sinon
+ */
+static int estSocketOrpheline (int mode, const struct sockaddr_un *addrU) {
+
+	int fd;
+	int orpheline;
+
+	if (!estFichierSocket(addrU->sun_path)) return 0;
+
+	// non bloquante : une écoute vivante à la file pleine répond EAGAIN
+	fd = socket(PF_UNIX, mode | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd == -1) return 0;
+
+	orpheline = connect(fd, (const struct sockaddr *) addrU, sizeof(*addrU)) == -1
+		&& errno == ECONNREFUSED;
+
+	close(fd);
+	return orpheline;
+
+}
+
+
+int estAdrUnix(const char *adrIP) {
+
+	return strncmp(adrIP, PREFIXE_UNIX, strlen(PREFIXE_UNIX)) == 0;
+
+}
+
+
+socklen_t adr2struct(struct sockaddr_storage *addr, char *adrIP, short port) {
 	
+	struct sockaddr_in 	*addr4 = (struct sockaddr_in *) addr;
+	struct sockaddr_in6 *addr6 = (struct sockaddr_in6 *) addr;
+	struct sockaddr_un 	*addrU = (struct sockaddr_un *) addr;
+
 #ifdef DEBUG_ENABLED
 	logMessage("Création de l'addresse: [%s:%d].\n", DEBUG, adrIP, port);
 #endif
 
-	addr->sin_family = PF_INET;
-	addr->sin_port = htons (port);
-	addr->sin_addr.s_addr = inet_addr(adrIP);
-	memset(&addr->sin_zero, 0, 8);
+	memset(addr, 0, sizeof(struct sockaddr_storage));
+
+	if (estAdrUnix(adrIP)) {
+
+		char *chemin = adrIP + strlen(PREFIXE_UNIX);
+
+		if (strlen(chemin) >= sizeof(addrU->sun_path)) return 0;
+
+		addrU->sun_family = PF_UNIX;
+		strcpy(addrU->sun_path, chemin);
+		return tailleAdr(addr);
+
+	}
+
+	if (inet_pton(AF_INET, adrIP, &addr4->sin_addr) == 1) {
+
+		addr4->sin_family = PF_INET;
+		addr4->sin_port = htons (port);
+		return sizeof(struct sockaddr_in);
+
+	}
+
+	if (inet_pton(AF_INET6, adrIP, &addr6->sin6_addr) == 1) {
+
+		addr6->sin6_family = PF_INET6;
+		addr6->sin6_port = htons (port);
+		return sizeof(struct sockaddr_in6);
+
+	}
+
+	// à l'appelant de décider : une adresse reçue d'un pair ne doit pas arrêter le serveur
+	return 0;
+
+}
+
+
+int struct2adr(const struct sockaddr_storage *addr, char *adrIP, short *port) {
+
+	const struct sockaddr_in 	*addr4 = (const struct sockaddr_in *) addr;
+	const struct sockaddr_in6 	*addr6 = (const struct sockaddr_in6 *) addr;
+
+	switch (addr->ss_family) {
+
+		case PF_INET:
+			inet_ntop(AF_INET, &addr4->sin_addr, adrIP, ADR_SIZE);
+			if (port != NULL) *port = ntohs(addr4->sin_port);
+			break;
+
+		case PF_INET6:
+			// un client IPv4 accepté sur une écoute double pile
+			if (IN6_IS_ADDR_V4MAPPED(&addr6->sin6_addr))
+				inet_ntop(AF_INET, &addr6->sin6_addr.s6_addr[12], adrIP, ADR_SIZE);
+			else
+				inet_ntop(AF_INET6, &addr6->sin6_addr, adrIP, ADR_SIZE);
+			if (port != NULL) *port = ntohs(addr6->sin6_port);
+			break;
+
+		case PF_UNIX:
+			if (port != NULL) *port = 0;
+			// un chemin peut dépasser ADR_SIZE : la troncature est signalée
+			return snprintf(adrIP, ADR_SIZE, PREFIXE_UNIX "%s"
+				, ((const struct sockaddr_un *) addr)->sun_path) < ADR_SIZE;
+
+		default:
+			strcpy(adrIP, "?");
+			if (port != NULL) *port = 0;
+			break;
+
+	}
+
+	return 1;
 
 }
 
 
-socket_t creerSocket(int mode) {
+socklen_t tailleAdr(const struct sockaddr_storage *addr) {
+
+	switch (addr->ss_family) {
+
+		case PF_INET: 	return sizeof(struct sockaddr_in);
+		case PF_INET6: 	return sizeof(struct sockaddr_in6);
+		case PF_UNIX: 	return offsetof(struct sockaddr_un, sun_path)
+							+ strlen(((const struct sockaddr_un *) addr)->sun_path) + 1;
+		default: 		return sizeof(struct sockaddr_storage);
+
+	}
+
+}
+
+
+socket_t creerSocket(int famille, int mode) {
 	
 	socket_t newSocket = {0};
 	
-	CHECK(newSocket.fd=socket(PF_INET, mode, 0), "Can't create");
+	CHECK(newSocket.fd=socket(famille, mode, 0), "Can't create");
 	newSocket.mode = mode;
 
 #ifdef DEBUG_ENABLED
-	logMessage("Création de la socket N°%d de famille [PF_INET] et mode [%d].\n", DEBUG, newSocket.fd, newSocket.mode);
+	logMessage("Création de la socket N°%d de famille [%d] et mode [%d].\n", DEBUG, newSocket.fd, famille, newSocket.mode);
 #endif
 
 	return newSocket;
@@ -58,19 +208,40 @@ socket_t creerSocket(int mode) {
 
 socket_t creerSocketAdr (int mode, char *adrIP, short port) {
 	
-	socket_t newSocket = creerSocket(mode);
+	struct sockaddr_storage	addrLoc;
+	socklen_t				lenLoc = adr2struct(&addrLoc, adrIP, port);
+	socket_t 				newSocket;
+
+	if (lenLoc == 0) {
+		fprintf(stderr, "Adresse invalide: [%s]\n", adrIP);
+		exit(-1);
+	}
 
-	adr2struct(&newSocket.addrLoc, adrIP, port);
+	newSocket = creerSocket(addrLoc.ss_family, mode);
+
+	newSocket.addrLoc = addrLoc;
 
 	// permet de relancer une socket d'écoute à la même addresse
 	// directement après fin de programme.
 	int opt = 1;
 	setsockopt(newSocket.fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+	// équivalent de SO_REUSEADDR pour une socket locale : le fichier
+	// laissé par une exécution précédente empêcherait le bind. Un autre
+	// fichier ou une instance encore en écoute sont laissés : bind échoue
+	if (addrLoc.ss_family == PF_UNIX && estSocketOrpheline(mode, (struct sockaddr_un *) &addrLoc))
+		unlink(((struct sockaddr_un *) &addrLoc)->sun_path);
+
+	// socket INET6 : accepte aussi les clients IPv4 (double pile)
+	if (addrLoc.ss_family == PF_INET6) {
+		opt = 0;
+		setsockopt(newSocket.fd, IPPROTO_IPV6, IPV6_V6ONLY, &opt, sizeof(opt));
+	}
 	
 	CHECK(
 		bind(newSocket.fd
 		, (struct sockaddr *) &newSocket.addrLoc
-		, sizeof(newSocket.addrLoc))
+		, lenLoc)
 		, "Can't bind"
 	);
 
@@ -85,6 +256,9 @@ socket_t creerSocketAdr (int mode, char *adrIP, short port) {
 
 socket_t creerSocketEcoute (char *adrIP, short port) {
 	
+	// repli sur l'écoute IPv4 si la pile IPv6 est absente
+	if (strcmp(adrIP, "::") == 0 && !ipv6Disponible()) adrIP = "0.0.0.0";
+
 	socket_t socketEcoute = creerSocketAdr(SOCK_STREAM, adrIP, port);
 	
 	CHECK(listen(socketEcoute.fd, 5), "Can't listen");
@@ -98,10 +272,26 @@ socket_t creerSocketEcoute (char *adrIP, short port) {
 }
 
 
+int fermerSocketEcoute (socket_t *sockEcoute) {
+
+	int 		sts = close(sockEcoute->fd);
+	const char 	*chemin = ((struct sockaddr_un *) &sockEcoute->addrLoc)->sun_path;
+
+	// le chemin a pu être remplacé depuis le bind : ne supprimer qu'une socket
+	if (sockEcoute->addrLoc.ss_family == PF_UNIX && estFichierSocket(chemin))
+		unlink(chemin);
+
+	return sts;
+
+}
+
+
 socket_t accepterClt (const socket_t sockEcoute) {
 	
-	socket_t sockDialogue = creerSocket(SOCK_STREAM);
-	socklen_t sockLen = sizeof(struct sockaddr_in);
+	socket_t sockDialogue = {0};
+	socklen_t sockLen = sizeof(struct sockaddr_storage);
+
+	sockDialogue.mode = SOCK_STREAM;
 	
 	CHECK(
 		sockDialogue.fd = accept(
@@ -113,12 +303,16 @@ socket_t accepterClt (const socket_t sockEcoute) {
 	);
 	
 #ifdef DEBUG_ENABLED
+	char 	adrDst[ADR_SIZE];
+	short 	portDst;
+
+	struct2adr(&sockDialogue.addrDst, adrDst, &portDst);
 	logMessage(
 		"Création de la socket dialogue n°%d et d'adresse: [%s:%d].\n"
 		, DEBUG
 		, sockDialogue.fd
-		, inet_ntoa(sockDialogue.addrDst.sin_addr)
-		, ntohs(sockDialogue.addrDst.sin_port)
+		, adrDst
+		, portDst
 	);
 #endif
 	
@@ -128,12 +322,38 @@ socket_t accepterClt (const socket_t sockEcoute) {
 }
 
 
+socket_t fd2socket (int fd, int mode) {
+
+	socket_t 	sock = {0};
+	socklen_t 	sockLen = sizeof(struct sockaddr_storage);
+
+	sock.fd 	= fd;
+	sock.mode 	= mode;
+
+	getsockname(fd, (struct sockaddr *) &sock.addrLoc, &sockLen);
+	sockLen = sizeof(struct sockaddr_storage);
+	// une socket non connectée n'a pas d'adresse distante : addrDst reste vide
+	getpeername(fd, (struct sockaddr *) &sock.addrDst, &sockLen);
+
+	return sock;
+
+}
+
+
 socket_t connecterClt2Srv (char *adrIP, short port) {
 	
-	socket_t sockAppel = creerSocket(SOCK_STREAM);
-	socklen_t sockLen = sizeof(struct sockaddr_in);
+	struct sockaddr_storage	addrDst;
+	socklen_t 				sockLen = adr2struct(&addrDst, adrIP, port);
+	socket_t 				sockAppel;
+
+	if (sockLen == 0) {
+		fprintf(stderr, "Adresse invalide: [%s]\n", adrIP);
+		exit(-1);
+	}
+
+	sockAppel = creerSocket(addrDst.ss_family, SOCK_STREAM);
 	
-	adr2struct(&sockAppel.addrDst, adrIP, port);
+	sockAppel.addrDst = addrDst;
 	
 	CHECK(
 		connect(sockAppel.fd
@@ -143,6 +363,8 @@ socket_t connecterClt2Srv (char *adrIP, short port) {
 		, "Can't connect"
 	);
 	
+	sockLen = sizeof(struct sockaddr_storage);
+
 	CHECK(
 		getsockname(
 			sockAppel.fd
@@ -153,15 +375,20 @@ socket_t connecterClt2Srv (char *adrIP, short port) {
 	);
 	
 #ifdef DEBUG_ENABLED
+	char 	adrLoc[ADR_SIZE], adrDst[ADR_SIZE];
+	short 	portLoc, portDst;
+
+	struct2adr(&sockAppel.addrLoc, adrLoc, &portLoc);
+	struct2adr(&sockAppel.addrDst, adrDst, &portDst);
 	logMessage(
 		"- Création de la socket d'appel n°%d et d'adresse: [%s:%d].\n"
 		"- Connectée à [%s:%d]\n"
 		, DEBUG
 		, sockAppel.fd
-		, inet_ntoa(sockAppel.addrLoc.sin_addr)
-		, ntohs(sockAppel.addrLoc.sin_port)
-		, inet_ntoa(sockAppel.addrDst.sin_addr)
-		, ntohs(sockAppel.addrDst.sin_port)
+		, adrLoc
+		, portLoc
+		, adrDst
+		, portDst
 	);
 #endif
 	
@@ -173,17 +400,22 @@ socket_t connecterClt2Srv (char *adrIP, short port) {
 
 void getIpAddress(char *ipBuffer) {
 
-	char hostbuffer[256];
-    struct hostent *host_entry;
-    int hostname;
+	char 					hostbuffer[256];
+	struct addrinfo 		hints = {0};
+	struct addrinfo 		*result;
+
+	hints.ai_family 	= AF_UNSPEC;
+	hints.ai_socktype 	= SOCK_STREAM;
 
-    hostname = gethostname(hostbuffer, sizeof(hostbuffer));
+	gethostname(hostbuffer, sizeof(hostbuffer));
 
-    host_entry = gethostbyname(hostbuffer);
+	if (getaddrinfo(hostbuffer, NULL, &hints, &result) != 0) {
+		strcpy(ipBuffer, "127.0.0.1");
+		return;
+	}
 
-    strcpy(
-    	ipBuffer
-    	, inet_ntoa(*((struct in_addr*) host_entry->h_addr_list[0]))
-    );
+	struct2adr((struct sockaddr_storage *) result->ai_addr, ipBuffer, NULL);
 
-}
\ No newline at end of file
+	freeaddrinfo(result);
+
+}
@@ -0,0 +1,699 @@
+/**
+ *	\file		rejeuTrafic.c
+ *	\brief		rejeu d'une capture du trafic du serveur d'enregistrement (tests de
+ *				non-régression des performances)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+
+#include <session.h>
+#include <repReq.h>
+#include <protocol.h>
+#include <trace.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      adresse du serveur rejoué par défaut
+ */
+#define RETRACE_ADDRESS 	"127.0.0.1"
+/**
+ * @brief      port du serveur rejoué par défaut
+ */
+#define RETRACE_PORT 		50000
+/**
+ * @brief      mot clé du rejeu aussi vite que possible
+ */
+#define MAX_SPEED_KEYWORD 	"max"
+/**
+ * @brief      option de comparaison de deux captures
+ */
+#define COMPARE_OPTION 		"--comparer"
+/**
+ * @brief      réponses attendues au plus par connexion : au-delà, le rejeu attend
+ */
+#define PENDING_MAX 		64
+/**
+ * @brief      attente maximale d'une réponse (ms), en fin de rejeu ou connexion saturée
+ */
+#define DRAIN_TIMEOUT 		2000
+/**
+ * @brief      ligne « autre » des statistiques : requêtes d'action inconnue
+ */
+#define OTHER_ACTION 		ACTION_AMOUNT
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      requête rejouée dont la réponse est attendue
+ */
+typedef struct {
+
+	/** action de la requête */
+	int 		action;
+	/** instant de l'émission (µs) */
+	long long 	sent;
+	/** durée de traitement capturée (µs) */
+	int 		service;
+	/** réponses encore attendues */
+	int 		responses;
+
+} pendingRequest_t;
+/**
+ * @brief      connexion de la capture, rejouée sur sa propre socket
+ */
+typedef struct {
+
+	/** socket vers le serveur rejoué (tampon de réception compris) */
+	socket_t 			sock;
+	/** la connexion est ouverte */
+	int 				open;
+	/** la capture l'a fermée : fermeture dès les réponses reçues */
+	int 				closing;
+	/** réponses attendues, dans l'ordre des requêtes */
+	pendingRequest_t 	pending[PENDING_MAX];
+	/** première réponse attendue et nombre de réponses attendues */
+	int 				head, count;
+
+} replayConn_t;
+/**
+ * @brief      échantillons (µs) d'une action
+ */
+typedef struct {
+
+	/** durées de traitement capturées */
+	int 	*service;
+	/** allers-retours mesurés au rejeu */
+	int 	*rtt;
+	/** aller-retour moins durée capturée, requête par requête */
+	int 	*delta;
+	/** nombre de requêtes et d'allers-retours mesurés */
+	int 	requests, answered;
+
+} actionStats_t;
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ *	\var		progName
+ *	\brief		Nom de l'exécutable : libnet nécessite cette variable qui pointe sur argv[0]
+ */
+char 				*progName;
+/**
+ * @brief      noms des actions (OTHER_ACTION compris)
+ */
+const char 			*actionNames[ACTION_AMOUNT + 1] = {
+	"CONNECT", "CELL", "GAME", "CURRENT_PLAYER", "MATCH", "SPECTATE", "HELLO", "autre"
+};
+/**
+ * @brief      connexions de la capture, indexées par leur numéro
+ */
+replayConn_t 		*conns;
+/**
+ * @brief      échantillons par action
+ */
+actionStats_t 		stats[ACTION_AMOUNT + 1];
+/**
+ * @brief      retards d'émission sur l'horaire de la capture (µs)
+ */
+int 				*lags;
+int 				lagAmount;
+/**
+ * @brief      incidents du rejeu
+ */
+unsigned long 		unsolicited, lost, skipped;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone en microsecondes
+ */
+static long long nowUs() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long long) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+
+}
+/**
+ * @brief      Ordre croissant des durées
+ */
+static int compareDurations(const void *a, const void *b) {
+
+	return *(const int *) a - *(const int *) b;
+
+}
+/**
+ * @brief      Alloue un tableau d'échantillons
+ */
+static int *allocSamples(int amount) {
+
+	int *samples = malloc((amount > 0 ? amount : 1) * sizeof(int));
+
+	if (samples == NULL) {
+		perror("Can't allocate samples");
+		exit(EXIT_FAILURE);
+	}
+
+	return samples;
+
+}
+/**
+ * @brief      Centile d'échantillons triés
+ */
+static int percentile(int *sorted, int amount, double p) {
+
+	return amount > 0 ? sorted[(int) ((amount - 1) * p)] : 0;
+
+}
+/**
+ * @brief      Action d'une requête ou d'une réponse, OTHER_ACTION si inconnue
+ */
+static int actionOf(short status) {
+
+	action_t action = getAction(status);
+
+	return action == ACTION_UNKNOWN ? OTHER_ACTION : action;
+
+}
+/**
+ * @brief      Parcourt une capture : connexions, requêtes par action et durée
+ *
+ * @param      file        la capture
+ * @param      connAmount  nombre de connexions (plus grand numéro + 1)
+ * @param      requests    requêtes par action (ACTION_AMOUNT + 1 cases)
+ *
+ * @return     la durée de la capture (µs)
+ */
+static long long scanTrace(traceFile_t *file, int *connAmount, int *requests) {
+
+	traceRecord_t 	record;
+	req_t 			request;
+	size_t 			pos 	= 0;
+	long long 		length 	= 0;
+
+	*connAmount = 0;
+	memset(requests, 0, (ACTION_AMOUNT + 1) * sizeof(int));
+
+	while (nextTraceRecord(file, &pos, &record, &request)) {
+
+		length += record.delay;
+
+		if ((int) record.conn >= *connAmount) *connAmount = record.conn + 1;
+		if (record.type == TRACE_REQUEST) requests[actionOf(request.id)]++;
+
+	}
+
+	return length;
+
+}
+/**
+ * @brief      Ferme la socket d'une connexion rejouée
+ */
+static void closeConn(replayConn_t *conn) {
+
+	close(conn->sock.fd);
+
+	// réponses qui ne viendront plus
+	lost 		+= conn->count;
+	conn->count = 0;
+	conn->open 	= 0;
+
+}
+/**
+ * @brief      Associe une réponse reçue à la plus ancienne requête en attente : son
+ *             aller-retour se termine avec sa dernière réponse
+ */
+static void matchResponse(replayConn_t *conn, rep_t *response, long long now) {
+
+	pendingRequest_t 	*pending 	= &conn->pending[conn->head];
+	actionStats_t 		*stat;
+	int 				rtt;
+
+	// réponse non sollicitée (mise en relation, événements de partie)
+	if (conn->count == 0 || actionOf(response->id) != pending->action) {
+		unsolicited++;
+		return;
+	}
+
+	if (--pending->responses > 0) return;
+
+	stat 	= &stats[pending->action];
+	rtt 	= now - pending->sent;
+
+	stat->rtt[stat->answered] 		= rtt;
+	stat->delta[stat->answered++] 	= rtt - pending->service;
+
+	conn->head = (conn->head + 1) % PENDING_MAX;
+	conn->count--;
+
+	if (conn->count == 0 && conn->closing) closeConn(conn);
+
+}
+/**
+ * @brief      Lit ce que le serveur a envoyé sur une connexion
+ */
+static void receiveResponses(replayConn_t *conn) {
+
+	socket_t 	*sock = &conn->sock;
+	buffer_t 	buff;
+	rep_t 		response;
+	long long 	now;
+	ssize_t 	n = read(sock->fd, sock->entree + sock->nbEntree, TAILLE_ENTREE - sock->nbEntree);
+
+	if (n == -1 && errno == EINTR) return;
+
+	// fermée par le serveur (DELETE CONNECT, refus...)
+	if (n <= 0) {
+		closeConn(conn);
+		return;
+	}
+
+	now 			= nowUs();
+	sock->nbEntree 	+= n;
+
+	while (conn->open && extraireMessage(sock, buff, MAX_BUFFER)) {
+		str2rep(buff, &response);
+		matchResponse(conn, &response, now);
+	}
+
+}
+/**
+ * @brief      Rejoue un enregistrement de la capture
+ *
+ * @return     0 si la connexion attend déjà PENDING_MAX réponses (à réessayer)
+ */
+static int replayRecord(traceRecord_t *record, req_t *request, char *adrIP, short port) {
+
+	replayConn_t *conn = &conns[record->conn];
+
+	switch (record->type) {
+
+		case TRACE_OPEN:
+
+			conn->sock 		= connecterClt2Srv(adrIP, port);
+			conn->open 		= 1;
+			conn->closing 	= 0;
+			conn->head 		= 0;
+			conn->count 	= 0;
+			break;
+
+		case TRACE_REQUEST:
+
+			if (!conn->open) {
+				skipped++;
+				break;
+			}
+
+			if (conn->count == PENDING_MAX) return 0;
+
+			stats[actionOf(request->id)].service[stats[actionOf(request->id)].requests++] = record->service;
+
+			sendRequest(&conn->sock, request->id, request->verb, request->data, NULL);
+
+			if (record->responses > 0) {
+				conn->pending[(conn->head + conn->count++) % PENDING_MAX] =
+					(pendingRequest_t) {actionOf(request->id), nowUs(), record->service, record->responses};
+			}
+			break;
+
+		case TRACE_CLOSE:
+
+			if (!conn->open) break;
+
+			if (conn->count > 0) conn->closing = 1;
+			else closeConn(conn);
+			break;
+
+	}
+
+	return 1;
+
+}
+/**
+ * @brief      Attend les réponses des connexions ouvertes
+ *
+ * @param[in]  amount   nombre de connexions
+ * @param[in]  timeout  attente maximale (µs, -1 : DRAIN_TIMEOUT)
+ * @param      fds      tableau de amount cases
+ * @param      owners   tableau de amount cases
+ *
+ * @return     le nombre de connexions lues, 0 si l'attente a expiré, -1 si aucune
+ *             connexion n'est ouverte
+ */
+static int waitResponses(int amount, long long timeout, struct pollfd *fds, int *owners) {
+
+	int active = 0;
+	int ready;
+
+	for (int i = 0; i < amount; i++) {
+
+		if (!conns[i].open) continue;
+
+		fds[active].fd 		= conns[i].sock.fd;
+		fds[active].events 	= POLLIN;
+		owners[active++] 	= i;
+
+	}
+
+	if (active == 0) return -1;
+
+	ready = poll(fds, active, timeout < 0 ? DRAIN_TIMEOUT : (int) ((timeout + 999) / 1000));
+
+	if (ready == -1) {
+		if (errno == EINTR) return 1;
+		perror("Can't poll");
+		exit(EXIT_FAILURE);
+	}
+
+	for (int i = 0; i < active; i++) {
+		if (fds[i].revents) receiveResponses(&conns[owners[i]]);
+	}
+
+	return ready;
+
+}
+/**
+ * @brief      Rejoue toute une capture
+ *
+ * @param      file        la capture
+ * @param[in]  connAmount  nombre de connexions
+ * @param[in]  speed       facteur de vitesse (0 : aussi vite que possible)
+ *
+ * @return     la durée du rejeu (µs)
+ */
+static long long replayTrace(traceFile_t *file, int connAmount, double speed, char *adrIP, short port) {
+
+	struct pollfd 	*fds 	= malloc(connAmount * sizeof(struct pollfd));
+	int 			*owners = malloc(connAmount * sizeof(int));
+	traceRecord_t 	record;
+	req_t 			request;
+	size_t 			pos 	= 0;
+	long long 		at 		= 0;
+	long long 		start 	= nowUs();
+	long long 		drainEnd;
+	int 			more;
+
+	if (fds == NULL || owners == NULL) {
+		perror("Can't allocate connections");
+		exit(EXIT_FAILURE);
+	}
+
+	more = nextTraceRecord(file, &pos, &record, &request);
+	if (more) at += record.delay;
+
+	while (more) {
+
+		long long 	due 	= speed > 0 ? start + (long long) (at / speed) : 0;
+		long long 	now 	= nowUs();
+		long long 	wait 	= due - now;
+		int 		blocked = 0;
+
+		if (wait <= 0) {
+
+			blocked = !replayRecord(&record, &request, adrIP, port);
+			wait 	= blocked ? -1 : 0;
+
+			if (!blocked) {
+				if (speed > 0) lags[lagAmount++] = now - due;
+				more = nextTraceRecord(file, &pos, &record, &request);
+				if (more) at += record.delay;
+			}
+
+		}
+
+		// lire même sans attendre : le serveur écrit ses réponses en bloquant
+		switch (waitResponses(connAmount, wait, fds, owners)) {
+
+			case -1:
+				// aucune connexion ouverte : rien à lire d'ici là
+				if (wait > 0) usleep(wait);
+				break;
+
+			case 0:
+				// connexion saturée : sa plus ancienne réponse ne viendra peut-être jamais
+				if (blocked) {
+					conns[record.conn].head = (conns[record.conn].head + 1) % PENDING_MAX;
+					conns[record.conn].count--;
+					lost++;
+				}
+				break;
+
+		}
+
+	}
+
+	// dernières réponses
+	drainEnd = nowUs() + DRAIN_TIMEOUT * 1000LL;
+
+	while (nowUs() < drainEnd) {
+
+		int waiting = 0;
+
+		for (int i = 0; i < connAmount; i++) waiting += conns[i].count;
+		if (waiting == 0) break;
+
+		if (waitResponses(connAmount, drainEnd - nowUs(), fds, owners) == -1) break;
+
+	}
+
+	for (int i = 0; i < connAmount; i++) {
+		if (conns[i].open) closeConn(&conns[i]);
+	}
+
+	free(fds);
+	free(owners);
+
+	return nowUs() - start;
+
+}
+/**
+ * @brief      Affiche les centiles d'échantillons (triés ici)
+ */
+static void printPercentiles(int *samples, int amount) {
+
+	qsort(samples, amount, sizeof(int), compareDurations);
+
+	printf(" %7d %7d %7d", percentile(samples, amount, 0.5),
+		percentile(samples, amount, 0.99), amount > 0 ? samples[amount - 1] : 0);
+
+}
+/**
+ * @brief      Affiche les mesures du rejeu, action par action
+ */
+static void printReplay(long long length, long long elapsed, double speed) {
+
+	printf("Rejeu: %.3f s (capture %.3f s, ", elapsed / 1e6, length / 1e6);
+	if (speed > 0) 	printf("vitesse %gx)\n", speed);
+	else 			printf("aussi vite que possible)\n");
+
+	if (lagAmount > 0) {
+		qsort(lags, lagAmount, sizeof(int), compareDurations);
+		printf("Retard d'émission (µs): p50 %d, p99 %d, max %d\n", percentile(lags, lagAmount, 0.5),
+			percentile(lags, lagAmount, 0.99), lags[lagAmount - 1]);
+	}
+
+	printf("Réponses non sollicitées %lu, manquantes %lu, requêtes sur connexion fermée %lu\n",
+		unsolicited, lost, skipped);
+
+	printf("%-15s %8s | %-23s | %-23s | %-23s\n", "(µs)", "requêtes",
+		"  traitement capturé", "  aller-retour rejoué", "  écart");
+	printf("%-15s %8s |     p50     p99     max |     p50     p99     max |     p50     p99     max\n", "", "");
+
+	for (int action = 0; action <= OTHER_ACTION; action++) {
+
+		actionStats_t *stat = &stats[action];
+
+		if (stat->requests == 0) continue;
+
+		printf("%-15s %8d |", actionNames[action], stat->requests);
+		printPercentiles(stat->service, stat->requests);
+		printf(" |");
+		printPercentiles(stat->rtt, stat->answered);
+		printf(" |");
+		printPercentiles(stat->delta, stat->answered);
+		putchar('\n');
+
+	}
+
+}
+/**
+ * @brief      Durées de traitement d'une capture, par action
+ *
+ * @param      file      la capture
+ * @param      requests  requêtes par action (scanTrace)
+ * @param      samples   échantillons par action (alloués ici)
+ */
+static void loadServices(traceFile_t *file, int *requests, int **samples) {
+
+	traceRecord_t 	record;
+	req_t 			request;
+	size_t 			pos = 0;
+	int 			filled[ACTION_AMOUNT + 1] = {0};
+
+	for (int action = 0; action <= OTHER_ACTION; action++) samples[action] = allocSamples(requests[action]);
+
+	while (nextTraceRecord(file, &pos, &record, &request)) {
+
+		int action = actionOf(request.id);
+
+		if (record.type != TRACE_REQUEST) continue;
+
+		samples[action][filled[action]++] = record.service;
+
+	}
+
+}
+/**
+ * @brief      Compare les durées de traitement de deux captures du même trafic
+ *             (la seconde prise par un serveur rejoué)
+ */
+static void compareTraces(traceFile_t *reference, traceFile_t *candidate) {
+
+	int 	requests[2][ACTION_AMOUNT + 1];
+	int 	*samples[2][ACTION_AMOUNT + 1];
+	int 	connAmount;
+
+	scanTrace(reference, &connAmount, requests[0]);
+	scanTrace(candidate, &connAmount, requests[1]);
+
+	loadServices(reference, requests[0], samples[0]);
+	loadServices(candidate, requests[1], samples[1]);
+
+	printf("%-15s %17s | %-23s | %-23s | %-15s\n", "(µs)", "requêtes",
+		"  référence", "  candidate", "  écart");
+	printf("%-15s %8s %8s |     p50     p99     max |     p50     p99     max |     p50     p99\n",
+		"", "réf.", "cand.");
+
+	for (int action = 0; action <= OTHER_ACTION; action++) {
+
+		if (requests[0][action] == 0 && requests[1][action] == 0) continue;
+
+		printf("%-15s %8d %8d |", actionNames[action], requests[0][action], requests[1][action]);
+		printPercentiles(samples[0][action], requests[0][action]);
+		printf(" |");
+		printPercentiles(samples[1][action], requests[1][action]);
+		printf(" | %+7d %+7d\n",
+			percentile(samples[1][action], requests[1][action], 0.5) - percentile(samples[0][action], requests[0][action], 0.5),
+			percentile(samples[1][action], requests[1][action], 0.99) - percentile(samples[0][action], requests[0][action], 0.99));
+
+	}
+
+	for (int action = 0; action <= OTHER_ACTION; action++) {
+		free(samples[0][action]);
+		free(samples[1][action]);
+	}
+
+}
+/**
+ * @brief      Ouvre une capture ou arrête le programme
+ */
+static void openOrDie(traceFile_t *file, const char *path) {
+
+	if (openTraceFile(file, path) == -1) {
+		fprintf(stderr, "%s : ", path);
+		perror("Can't open trace");
+		exit(EXIT_FAILURE);
+	}
+
+}
+/**
+ * @brief      Point d'entrée : retrace capture [adresse [port [vitesse|max]]]
+ *             ou retrace capture --comparer capture
+ *
+ * 			   rejoue une capture (SRVE_TRACE) contre un serveur : chaque connexion
+ * 			   capturée est rouverte et ses requêtes repartent à l'horaire de la
+ * 			   capture, accéléré ou non ; l'aller-retour de chaque requête est
+ * 			   comparé à sa durée de traitement capturée. Avec SRVE_TRACE, le serveur
+ * 			   rejoué produit une seconde capture à comparer à la première.
+ *
+ * @note       une liste dont la taille dépend du registre au moment du rejeu donne
+ * 			   des réponses manquantes ou non sollicitées, comptées à part
+ */
+int main(int argc, char **argv) {
+
+	traceFile_t file;
+	int 		requests[ACTION_AMOUNT + 1];
+	int 		connAmount 	= 0;
+	int 		total 		= 0;
+	char 		*adrIP 		= argc > 2 ? argv[2] : RETRACE_ADDRESS;
+	short 		port 		= argc > 3 ? atoi(argv[3]) : RETRACE_PORT;
+	double 		speed 		= 1;
+	long long 	length, elapsed;
+
+	progName = argv[0];
+
+	if (argc > 4) speed = strcmp(argv[4], MAX_SPEED_KEYWORD) == 0 ? 0 : atof(argv[4]);
+
+	if (argc < 2 || speed < 0 || (argc > 4 && speed == 0 && strcmp(argv[4], MAX_SPEED_KEYWORD) != 0)) {
+		fprintf(stderr, "Usage: %s capture [adresse [port [vitesse|%s]]]\n", argv[0], MAX_SPEED_KEYWORD);
+		fprintf(stderr, "       %s capture %s capture\n", argv[0], COMPARE_OPTION);
+		exit(EXIT_FAILURE);
+	}
+
+	openOrDie(&file, argv[1]);
+
+	if (argc > 3 && strcmp(argv[2], COMPARE_OPTION) == 0) {
+
+		traceFile_t candidate;
+
+		openOrDie(&candidate, argv[3]);
+		compareTraces(&file, &candidate);
+		closeTraceFile(&candidate);
+		closeTraceFile(&file);
+
+		return 0;
+
+	}
+
+	length = scanTrace(&file, &connAmount, requests);
+
+	for (int action = 0; action <= OTHER_ACTION; action++) {
+		stats[action].service 	= allocSamples(requests[action]);
+		stats[action].rtt 		= allocSamples(requests[action]);
+		stats[action].delta 	= allocSamples(requests[action]);
+		total 					+= requests[action];
+	}
+
+	// au plus un retard par enregistrement : ouverture, requête ou fermeture
+	lags 	= allocSamples(total + 2 * connAmount);
+	conns 	= calloc(connAmount > 0 ? connAmount : 1, sizeof(replayConn_t));
+
+	if (conns == NULL) {
+		perror("Can't allocate connections");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("Capture: %d connexion(s), %d requête(s) en %.3f s\n", connAmount, total, length / 1e6);
+
+	elapsed = replayTrace(&file, connAmount, speed, adrIP, port);
+
+	printReplay(length, elapsed, speed);
+
+	for (int action = 0; action <= OTHER_ACTION; action++) {
+		free(stats[action].service);
+		free(stats[action].rtt);
+		free(stats[action].delta);
+	}
+
+	free(lags);
+	free(conns);
+	closeTraceFile(&file);
+
+	return 0;
+
+}
@@ -0,0 +1,177 @@
+/**
+ *	\file		relecture.c
+ *	\brief		relecture des journaux de parties (litiges et statistiques)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <replay.h>
+#include <interface.h>
+#include <render.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   M A C R O S
+ */
+/**
+ *	\def		CHECK(sts, msg)
+ *	\brief		Macro-fonction qui vérifie que sts est égal -1 (cas d'erreur : sts==-1)
+ *				En cas d'erreur, il y a affichage du message adéquat et fin d'exécution
+ */
+#define CHECK(sts, msg) if ((sts)==-1) {perror(msg); exit(-1);}
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      mot clé de la lecture animée d'une partie
+ */
+#define PLAY_KEYWORD 	"lecture"
+/**
+ * @brief      délai par défaut entre deux tirs de la lecture animée (ms)
+ */
+#define PLAY_DELAY 		200
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ *	\var		progName
+ *	\brief		Nom de l'exécutable : libnet nécessite cette variable qui pointe sur argv[0]
+ */
+char 			*progName;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Statistiques de toutes les parties d'un journal
+ *
+ * @param      file  le journal
+ */
+static void printStats(replayFile_t *file) {
+
+	replayGame_t 	game;
+	size_t 			pos 		= 0;
+	unsigned long 	games 		= 0;
+	unsigned long 	wins[2] 	= {0, 0};
+	unsigned long 	turns 		= 0;
+
+	while (nextReplayGame(file, &pos, &game)) {
+
+		games++;
+		turns += game.turns;
+		if (game.winner != NO_WINNER) wins[game.winner]++;
+
+	}
+
+	printf("Parties: %lu\n", games);
+	if (games == 0) return;
+
+	printf("Tirs par partie: %.1f\n", (double) turns / games);
+	printf("Victoires: joueur 0 %lu, joueur 1 %lu, sans vainqueur %lu\n",
+		wins[0], wins[1], games - wins[0] - wins[1]);
+
+}
+/**
+ * @brief      Rejoue une partie tir par tir : seules les cases changées sont réécrites
+ *
+ * @param      game   la partie
+ * @param[in]  delay  délai entre deux tirs (ms)
+ */
+static void playGame(replayGame_t *game, int delay) {
+
+	renderer_t 		renderer;
+	match_t 		match;
+	unsigned long 	written = 0;
+	int 			result;
+
+	fflush(stdout);
+	createRenderer(&renderer, STDOUT_FILENO);
+
+	for (uint32_t turn = 0; turn <= game->turns; turn++) {
+
+		replayMatchAt(game, turn, &match);
+		drawMatch(&renderer, &match);
+
+		CHECK(result = presentFrame(&renderer), "Can't render");
+		written += result;
+
+		if (turn < game->turns) usleep(delay * 1000);
+
+	}
+
+	printf("Partie %u: %u tirs, %lu octets écrits\n", game->id, game->turns, written);
+
+}
+/**
+ * @brief      Point d'entrée : relecture [journal] [partie [tour | lecture [délai]]]
+ *
+ * 			   sans partie : statistiques du journal, sinon grilles de la partie
+ * 			   après le nombre de tirs donné (par défaut : toute la partie), ou
+ * 			   lecture animée de la partie (délai en ms entre deux tirs)
+ */
+int main(int argc, char **argv) {
+
+	replayFile_t 	file;
+	replayGame_t 	game, candidate;
+	match_t 		match;
+	size_t 			pos 	= 0;
+	int 			found 	= 0;
+	uint32_t 		id;
+	uint32_t 		turn 	= UINT32_MAX;
+
+	progName = argv[0];
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s journal [partie [tour | %s [délai]]]\n", argv[0], PLAY_KEYWORD);
+		exit(EXIT_FAILURE);
+	}
+
+	CHECK(openReplay(&file, argv[1]), "Can't open replay");
+
+	if (argc < 3) {
+		printStats(&file);
+		closeReplay(&file);
+		return 0;
+	}
+
+	id = strtoul(argv[2], NULL, 10);
+	if (argc > 3 && strcmp(argv[3], PLAY_KEYWORD) != 0) turn = strtoul(argv[3], NULL, 10);
+
+	// la dernière partie portant cet identifiant fait foi
+	while (nextReplayGame(&file, &pos, &candidate)) {
+		if (candidate.id == id) {
+			game 	= candidate;
+			found 	= 1;
+		}
+	}
+
+	if (!found) {
+		fprintf(stderr, "Partie %u introuvable.\n", id);
+		closeReplay(&file);
+		exit(EXIT_FAILURE);
+	}
+
+	if (argc > 3 && strcmp(argv[3], PLAY_KEYWORD) == 0) {
+
+		playGame(&game, argc > 4 ? atoi(argv[4]) : PLAY_DELAY);
+		closeReplay(&file);
+		return 0;
+
+	}
+
+	replayMatchAt(&game, turn, &match);
+
+	printf("Partie %u: %u tirs enregistrés\n", game.id, game.turns);
+	displayMatch(&match);
+
+	closeReplay(&file);
+
+	return 0;
+
+}
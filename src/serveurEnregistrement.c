@@ -13,17 +13,29 @@
 #include <time.h>
 
 #include <libgen.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#include <moteur.h>
+#include <pool.h>
+#include <snapshot.h>
 #include <dial.h>
 #include <datastructs.h>
+#include <discovery.h>
+#include <gossip.h>
+#include <matchmaking.h>
+#include <spectate.h>
+#include <nameindex.h>
+#include <trace.h>
 /*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
  */
 /**
  *	\def		IP_ANY
- *	\brief		Adresse IP par défaut du serveur
+ *	\brief		Adresse IP par défaut du serveur (double pile IPv4/IPv6)
  */
-#define IP_ANY		"0.0.0.0"
+#define IP_ANY		"::"
 /**
  *	\def		PORT_SRV
  *	\brief		Numéro de port par défaut du serveur
@@ -33,6 +45,62 @@
  * @brief clients maximum supportés par le serveur d'enregistrement
  */	
 #define MAX_CLIENTS 		64
+/**
+ * @brief connexions maximum suivies par le moteur d'E/S (les connexions au-delà de
+ * 		  MAX_CLIENTS reçoivent un refus avant d'être fermées)
+ */
+#define MAX_CONNEXIONS 		(2 * MAX_CLIENTS)
+/**
+ * @brief fichier d'instantané du registre par défaut
+ */
+#define SNAPSHOT_FILE 		"serveurEnregistrement.snap"
+/**
+ * @brief variable d'environnement remplaçant SNAPSHOT_FILE (vide : pas d'instantané)
+ */
+#define SNAPSHOT_ENV 		"SRVE_SNAPSHOT"
+/**
+ * @brief période d'écriture de l'instantané (ms)
+ */
+#define SNAPSHOT_PERIOD 	1000
+/**
+ * @brief délai de reprise de l'émission vers les spectateurs en retard (ms)
+ */
+#define SPECTATE_RETRY 		50
+/**
+ * @brief délai de grâce laissé aux clients restaurés pour se reconnecter (s)
+ */
+#define SNAPSHOT_GRACE 		30
+/**
+ * @brief variable d'environnement donnant le port UDP de bavardage (absente : pas de
+ * 		  réplication)
+ */
+#define GOSSIP_ENV 			"SRVE_GOSSIP"
+/**
+ * @brief variable d'environnement listant les pairs (ip:port,[ipv6]:port...)
+ */
+#define PEERS_ENV 			"SRVE_PEERS"
+/**
+ * @brief socket de contrôle des mises à jour par défaut
+ */
+#define UPGRADE_FILE 		"serveurEnregistrement.upgrade"
+/**
+ * @brief variable d'environnement remplaçant UPGRADE_FILE (vide : pas de mise à jour)
+ */
+#define UPGRADE_ENV 		"SRVE_UPGRADE"
+/**
+ * @brief option de lancement d'une nouvelle instance reprenant celle en cours
+ */
+#define UPGRADE_OPTION 		"--upgrade"
+/**
+ * @brief variable d'environnement donnant le fichier de capture du trafic reçu
+ * 		  (absente ou vide : pas de capture, suffixé du pid après une passation)
+ */
+#define TRACE_ENV 			"SRVE_TRACE"
+/**
+ * @brief signature de la passation entre instances ("BSH3" : files d'attente et parties
+ * 		  transmises)
+ */
+#define HANDOFF_MAGIC 		0x42534833
 /**
  * @brief temps de rafraichissement entre les affichages des clients
  */
@@ -40,15 +108,106 @@
 /**
  * @brief format de "header" du tableau des clients
  */
-#define DISPLAY_HEADER_FMT 	"| %-15s | %-15s | %-15s | %-15s | %-5s |\n"
+#define DISPLAY_HEADER_FMT 	"| %-15s | %-15s | %-15s | %-39s | %-5s |\n"
 /**
  * @brief format d'affichage des clients dans le tableau
  */
-#define DISPLAY_FMT 		"| %-15s | %-15s | %-15s | %-15s | %-5d |\n"
+#define DISPLAY_FMT 		"| %-15s | %-15s | %-15s | %-39s | %-5d |\n"
 /**
  * @brief séparateur du tableau
  */
-#define DISPLAY_SEP 		"+-------------------------------------------------------------------------------+\n"
+#define DISPLAY_SEP 		"+-----------------------------------------------------------------------------------------------------+\n"
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      premier message de la passation : accompagne la socket d'écoute (et
+ * 			   celle de découverte) transmises à la nouvelle instance
+ */
+typedef struct {
+
+	/** signature HANDOFF_MAGIC (les deux instances doivent partager ce format) */
+	int 			magic;
+	/** nombre de parties transmises à la suite */
+	int 			games;
+	/** nombre de connexions transmises après les parties */
+	int 			connections;
+	/** la socket de découverte est transmise */
+	int 			discovery;
+	/** la socket de bavardage est transmise (après celle de découverte) */
+	int 			gossip;
+	/** port d'écoute annoncé aux sondes de découverte */
+	short 			port;
+	/** fin du délai de grâce des clients restaurés */
+	time_t 			graceDeadline;
+	/** registre des clients */
+	clientInfo_t 	clients[MAX_CLIENTS];
+
+} handoffHeader_t;
+/**
+ * @brief      état d'une connexion transmise avec son descripteur
+ */
+typedef struct {
+
+	/** entrée du registre (-1 : aucune) */
+	int 	id;
+	/** le dialogue se termine dès que sortie est émis */
+	int 	closing;
+	/** protocole convenu avec le client */
+	hello_t hello;
+	/** octets reçus non traités */
+	int 	nbEntree;
+	/** fin d'un message trop long encore à ignorer */
+	int 	rejet;
+	/** octets à émettre */
+	int 	nbSortie;
+	/** buffer de réception */
+	char 	entree[TAILLE_ENTREE];
+	/** buffer d'émission */
+	char 	sortie[TAILLE_SORTIE];
+	/** ticket de mise en relation (owner non NULL : le client attend) */
+	matchTicket_t 	match;
+	/** hôte de la partie regardée (vide : aucune) */
+	char 			spectating[PSEUDO_SIZE];
+	/** prochain événement de la partie à émettre au spectateur */
+	uint32_t 		cursor;
+
+} handoffConnection_t;
+/**
+ * @brief      partie transmise, suivie de ses derniers événements
+ */
+typedef struct {
+
+	/** nom de l'hôte */
+	char 			host[PSEUDO_SIZE];
+	/** état de la partie */
+	gameState_t 	state;
+	/** joueur au trait (vide : aucun) */
+	char 			owner[PSEUDO_SIZE];
+	/** nombre de coups joués */
+	unsigned 		moves;
+	/** nombre d'événements publiés */
+	uint32_t 		published;
+	/** nombre d'événements transmis à la suite */
+	int 			events;
+
+} handoffGame_t;
+/**
+ * @brief      événement d'une partie transmise
+ */
+typedef struct {
+
+	/** numéro de l'événement */
+	uint32_t 		seq;
+	/** c'est le dernier instantané de la partie */
+	int 			snapshot;
+	/** taille de la réponse encodée, \0 compris */
+	int 			len;
+	/** réponse encodée */
+	char 			data[MAX_BUFFER];
+
+} handoffEvent_t;
 /*
 *****************************************************************************************
  *	\noop		D E F I N I T I O N   DES   M A C R O S
@@ -77,6 +236,86 @@ char 			*progName;
  * @brief socket d'écoute de demande de connexion d'un client
  */
 socket_t 		sockEcoute;		
+/**
+ * @brief socket DGRAM de réponse aux sondes de découverte LAN
+ */
+socket_t 		sockDecouverte;
+/**
+ * @brief socket de contrôle sur laquelle une nouvelle instance demande la passation
+ */
+socket_t 		sockUpgrade = {.fd = -1};
+/**
+ * @brief socket de dialogue avec la nouvelle instance (-1 : pas de passation demandée)
+ */
+int 			fdUpgrade = -1;
+/**
+ * @brief la socket d'écoute appartient désormais à une nouvelle instance
+ */
+int 			handedOff = 0;
+/**
+ * @brief la découverte LAN est active (socket sockDecouverte ouverte)
+ */
+int 			discoveryEnabled = 0;
+/**
+ * @brief port d'écoute TCP annoncé aux sondes de découverte
+ */
+short 			portEcoute;
+/**
+ * @brief réplication des hôtes avec les autres serveurs d'enregistrement
+ */
+gossip_t 		gossip;
+/**
+ * @brief la réplication est active
+ */
+int 			gossipEnabled = 0;
+/**
+ * @brief id du thread de réplication
+ */
+pthread_t 		gossipThread;
+/**
+ * @brief id du thread de découverte
+ */
+pthread_t 		discoveryThread;
+/**
+ * @brief moteur d'E/S multiplexant l'écoute et tous les dialogues
+ */
+moteur_t 		*moteur;
+/**
+ * @brief réserve des contextes de connexion (eServConnection_t)
+ */
+pool_t 			connexions;
+/**
+ * @brief file de mise en relation des joueurs et des hôtes connectés
+ */
+matchmaker_t 	matchmaker;
+/**
+ * @brief relais des parties en cours vers leurs spectateurs
+ */
+spectateRelay_t relay;
+/**
+ * @brief index du registre par nom (listes filtrées des hôtes)
+ */
+nameIndex_t 	names;
+/**
+ * @brief connexions actives, chaînées pour pouvoir être transmises
+ */
+eServConnection_t *liveConnections = NULL;
+/**
+ * @brief nombre de connexions actives
+ */
+int 			liveAmount = 0;
+/**
+ * @brief instantané du registre, relu au démarrage
+ */
+registrySnapshot_t 	snapshot;
+/**
+ * @brief capture du trafic reçu (fd -1 : pas de capture)
+ */
+traceLog_t 		traceLog = {.fd = -1};
+/**
+ * @brief fin du délai de grâce des clients restaurés (0 : aucun en attente)
+ */
+time_t 			graceDeadline = 0;
 /**
  * @brief liste des MAX_CLIENTS infos clients du serveur d'enregistrement
  */
@@ -107,8 +346,23 @@ volatile sig_atomic_t stopServer = 0;
  */
 void bye() {
 
-	// Fermer la socket d'écoute
-	CHECK(close(sockEcoute.fd), "-- PB close() --");
+	closeTrace(&traceLog);
+
+	if (sockUpgrade.fd != -1) fermerSocketEcoute(&sockUpgrade);
+
+	// après passation, la socket d'écoute et le registre appartiennent à la nouvelle instance
+	if (handedOff) {
+		close(sockEcoute.fd);
+		printf("Goodbye.\n");
+		return;
+	}
+
+	// Fermer la socket d'écoute (et supprimer son fichier si locale)
+	CHECK(fermerSocketEcoute(&sockEcoute), "-- PB close() --");
+
+	// les clients encore connectés seront restaurés au prochain lancement
+	saveSnapshot(&snapshot, clients, MAX_CLIENTS);
+	closeSnapshot(&snapshot);
 
 	printf("Goodbye.\n");
 
@@ -136,6 +390,13 @@ void initServer() {
 	sa.sa_flags 	= 0;
 	CHECK(sigaction(SIGINT, &sa, NULL), "sigaction();");
 
+	// un pair parti ne doit pas arrêter le serveur : l'écriture échoue (EPIPE) et seule
+	// sa connexion est fermée
+	sa.sa_handler 	= SIG_IGN;
+	CHECK(sigaction(SIGPIPE, &sa, NULL), "sigaction();");
+
+	createNameIndex(&names, clients, MAX_CLIENTS);
+
 }
 /**
  * @brief      Fonction qui vérifie s'il est possible d'accepter un client
@@ -175,6 +436,9 @@ void updateCurrentClient(int *current) {
  */
 void disconnectClient(int id) {
 
+	// l'affichage repart du premier client connecté, quel que soit celui parti
+	(void) id;
+
 	updateCurrentClient(&currentClient);
 
 }
@@ -210,6 +474,7 @@ void displayClient() {
 				case DISCONNECTED: 	continue;
 				case CONNECTING: 	status 		= "CONNECTING"; break;
 				case CONNECTED: 	status 		= "CONNECTED"; 	break;
+				case PENDING: 		status 		= "PENDING"; 	break;
 
 			}
 
@@ -234,8 +499,812 @@ void displayClient() {
 	
 
 }
+/**
+ * @brief      Fonction du thread de réponse aux sondes de découverte LAN
+ */
+void discoveryResponder() {
+
+	serveSrvEDiscovery(&sockDecouverte, portEcoute);
+
+}
+/**
+ * @brief      Ouvre l'instantané du registre
+ *
+ * @param[in]  wait  attendre que l'instance qui le tient le libère (passation)
+ *
+ * @return     son chemin, NULL si le serveur fonctionne sans instantané
+ */
+char *openRegistrySnapshot(int wait) {
+
+	char *path = getenv(SNAPSHOT_ENV);
+
+	if (path == NULL) 	path = SNAPSHOT_FILE;
+	if (*path == '\0') 	return NULL;
+
+	// le serveur fonctionne aussi sans instantané
+	if (openSnapshot(&snapshot, path, MAX_CLIENTS, wait) == -1) {
+		if (errno == EWOULDBLOCK)
+			fprintf(stderr, "Instantané %s utilisé par un autre serveur : ignoré\n", path);
+		else perror("Can't open snapshot");
+		return NULL;
+	}
+
+	return path;
+
+}
+/**
+ * @brief      Ouvre l'instantané du registre et restaure les clients qu'il contient
+ */
+void restoreRegistry() {
+
+	char 	*path = openRegistrySnapshot(0);
+	int 	restored;
+
+	if (path == NULL) return;
+
+	restored = loadSnapshot(&snapshot, clients, MAX_CLIENTS);
+	if (restored == 0) return;
+
+	rebuildNameIndex(&names);
+
+	fprintf(stderr, "%d client(s) restauré(s) depuis %s\n", restored, path);
+
+	graceDeadline 	= time(NULL) + SNAPSHOT_GRACE;
+	startDisplay 	= 1;
+	updateCurrentClient(&currentClient);
+
+}
+/**
+ * @brief      Écrit périodiquement l'instantané et libère les clients restaurés
+ *             qui ne se sont pas reconnectés à temps
+ */
+void maintainRegistry() {
+
+	static time_t 	nextSave = 0;
+	time_t 			now = time(NULL);
+
+	if (graceDeadline != 0 && now >= graceDeadline) {
+
+		for (int i = 0; i < MAX_CLIENTS; i++) {
+
+			if (clients[i].status != PENDING) continue;
+
+			unindexClient(&names, i);
+			clients[i].status = DISCONNECTED;
+
+		}
+
+		graceDeadline = 0;
+		updateCurrentClient(&currentClient);
+
+	}
+
+	// publié d'ici : le registre n'est modifié que par la boucle d'événements
+	if (gossipEnabled) publishGossip(&gossip);
+
+	if (now >= nextSave) {
+
+		saveSnapshot(&snapshot, clients, MAX_CLIENTS);
+		flushTrace(&traceLog);
+		nextSave = now + SNAPSHOT_PERIOD / 1000;
+
+	}
+
+}
+/**
+ * @brief      Fonction du thread de réplication
+ */
+void gossipResponder() {
+
+	serveGossip(&gossip);
+
+}
+/**
+ * @brief      Liste les hôtes enregistrés sur les autres serveurs d'enregistrement
+ *
+ * @param      hosts   tableau à remplir
+ * @param[in]  max     taille du tableau
+ * @param      filter  filtre des hôtes (NULL : tous)
+ *
+ * @return     le nombre d'hôtes
+ */
+int listRemoteHosts(clientInfo_t *hosts, int max, hostFilter_t *filter) {
+
+	return listGossipHosts(&gossip, hosts, max, filter);
+
+}
+/**
+ * @brief      Port de bavardage configuré
+ *
+ * @return     le port, 0 si la réplication est désactivée
+ */
+short gossipPort() {
+
+	char *port = getenv(GOSSIP_ENV);
+
+	return port == NULL ? 0 : atoi(port);
+
+}
+/**
+ * @brief      Démarre la réplication
+ *
+ * @param      sock  socket DGRAM de bavardage, liée au port des pairs
+ */
+void startGossip(socket_t sock) {
+
+	char 	*peers 	= getenv(PEERS_ENV);
+	char 	adrIP[ADR_SIZE];
+	short 	port;
+	int 	amount;
+
+	struct2adr(&sock.addrLoc, adrIP, &port);
+
+	amount = createGossip(&gossip, sock, peers != NULL ? peers : "", clients, MAX_CLIENTS);
+
+	fprintf(stderr, "réplication sur le port %hu avec %d pair(s)\n", (unsigned short) port, amount);
+
+	gossipEnabled = 1;
+	pthread_create(&gossipThread, 0, (void*)(void*) gossipResponder, NULL);
+	pthread_detach(gossipThread);
+
+}
+/**
+ * @brief      Ajoute une connexion à la liste des connexions actives
+ *
+ * @param      conn  contexte de la connexion
+ */
+void linkClient(eServConnection_t *conn) {
+
+	conn->prev = NULL;
+	conn->next = liveConnections;
+	if (liveConnections != NULL) liveConnections->prev = conn;
+	liveConnections = conn;
+	liveAmount++;
+
+}
+/**
+ * @brief      Retire une connexion de la liste des connexions actives
+ *
+ * @param      conn  contexte de la connexion
+ */
+void unlinkClient(eServConnection_t *conn) {
+
+	if (conn->prev != NULL) conn->prev->next = conn->next;
+	else 					liveConnections = conn->next;
+	if (conn->next != NULL) conn->next->prev = conn->prev;
+	liveAmount--;
+
+}
+/**
+ * @brief      Ferme une connexion et rend son contexte à la réserve
+ *
+ * @param      conn  contexte de la connexion
+ */
+void closeClient(eServConnection_t *conn) {
+
+	moteurRetirer(moteur, &conn->sockDial);
+	close(conn->sockDial.fd);
+
+	traceClose(&traceLog, conn->traceId);
+
+	unlinkClient(conn);
+	poolFree(&connexions, conn);
+
+}
+/**
+ * @brief      Traite les requêtes complètes reçues sur une connexion puis arme
+ *             l'opération suivante (émission des réponses ou réception)
+ *
+ * @param      conn  contexte de la connexion
+ */
+void serviceClient(eServConnection_t *conn) {
+
+	eServThreadParams_t *params 	= &conn->params;
+	socket_t 			*sockDial 	= &conn->sockDial;
+	req_t 				request;
+
+	// les réponses d'une requête doivent tenir dans le buffer d'émission : sinon, les
+	// requêtes restantes attendent l'émission de celles déjà empilées
+	while (!params->closing && sockDial->nbSortie + MAX_REPLY_BYTES <= TAILLE_SORTIE
+		&& extractRequest(sockDial, &request)) {
+
+		// sans capture, aucune lecture d'horloge
+		uint64_t 	start 	= traceLog.fd != -1 ? traceClock() : 0;
+		unsigned 	sent 	= sockDial->nbMessages;
+
+		params->closing = !processSrvERequest(params, &request);
+
+		if (traceLog.fd != -1)
+			traceRequest(&traceLog, conn->traceId, &request, start, sockDial->nbMessages - sent);
+
+	}
+
+	// spectateur : ses réponses partent sans le moteur d'E/S, entre deux événements
+	if (params->spectator != NULL) {
+		flushSubscriber(params->spectator);
+		moteurRecevoir(moteur, sockDial);
+		return;
+	}
+
+	if (sockDial->nbSortie > 0) 	moteurEnvoyer(moteur, sockDial);
+	else if (params->closing) 		closeClient(conn);
+	else 							moteurRecevoir(moteur, sockDial);
+
+}
+/**
+ * @brief      Émet les réponses empilées sur une connexion qui attend une requête
+ *             (mise en relation trouvée par une autre connexion)
+ *
+ * @param      params  paramètres du dialogue de la connexion
+ *
+ * @note       l'émission se fait d'abord sans le moteur d'E/S et sans bloquer. Si
+ *             tout ne part pas, la réception armée est remplacée par l'émission du
+ *             reste ; la connexion est ensuite servie comme après une réponse. Si sa
+ *             réception vient d'être rendue, l'événement en attente s'en charge.
+ */
+void wakeClient(eServThreadParams_t *params) {
+
+	socket_t 			*sockDial 	= params->sockDial;
+	// sockDial est le premier champ du contexte de la connexion
+	eServConnection_t 	*conn 		= (eServConnection_t *) sockDial;
+	struct iovec 		morceau 	= {sockDial->sortie, sockDial->nbSortie};
+	int 				n 			= envoyerIovSansAttente(sockDial, &morceau, 1);
+
+	if (n > 0) {
+		sockDial->nbSortie -= n;
+		memmove(sockDial->sortie, sockDial->sortie + n, sockDial->nbSortie);
+	}
+
+	// une erreur sera signalée par l'émission du reste
+	if (sockDial->nbSortie == 0 || !moteurReceptionArmee(moteur, sockDial)) return;
+
+	// ce que la réception annulée a déjà reçu est traité après l'émission ; l'emplacement
+	// libéré par le détachement est aussitôt repris
+	moteurDetacher(moteur, sockDial);
+	moteurAjouter(moteur, sockDial, conn);
+
+	moteurEnvoyer(moteur, sockDial);
+
+}
+/**
+ * @brief      Crée le contexte d'une connexion et le confie au moteur d'E/S
+ *
+ * @param[in]  fd    descripteur de la socket de dialogue
+ * @param[in]  id    entrée du registre du client (-1 : aucune)
+ *
+ * @return     le contexte, NULL si la connexion a dû être fermée
+ */
+eServConnection_t *openClient(int fd, int id) {
+
+	eServConnection_t 	*conn = poolAlloc(&connexions);
+	eServThreadParams_t *params;
+
+	if (conn == NULL) {
+		// trop de connexions simultanées : on ne peut même pas répondre
+		close(fd);
+		return NULL;
+	}
+
+	params 		= &conn->params;
+	conn->sockDial = fd2socket(fd, SOCK_STREAM);
+
+	if (moteurAjouter(moteur, &conn->sockDial, conn) == -1) {
+		close(fd);
+		poolFree(&connexions, conn);
+		return NULL;
+	}
+
+	startDisplay				= 1;
+	conn->traceId 				= traceOpen(&traceLog);
+
+	params->id 					= id;
+	params->sockDial 			= &conn->sockDial;
+	params->clientArray 		= clients;
+	params->clientAmount		= MAX_CLIENTS;
+	params->terminationCallback = disconnectClient;
+	params->canAccept			= canAccept;
+	params->closing 			= 0;
+	params->listRemoteHosts 	= gossipEnabled ? listRemoteHosts : NULL;
+	params->matchmaker 			= &matchmaker;
+	params->matchTicket 		= -1;
+	params->wakeCallback 		= wakeClient;
+	params->relay 				= &relay;
+	params->spectator 			= NULL;
+	// sans négociation : le protocole d'origine
+	params->hello 				= (hello_t) {1, 0};
+	params->names 				= &names;
+
+	linkClient(conn);
+
+	return conn;
+
+}
+/**
+ * @brief      Prend en charge une connexion acceptée par le moteur d'E/S
+ *
+ * @param[in]  fd    descripteur de la socket de dialogue
+ */
+void acceptClient(int fd) {
+
+	// serveur plein : le dialogue répondra par un refus
+	eServConnection_t *conn = openClient(fd, canAccept() ? currentClient : -1);
+
+	if (conn == NULL) return;
+
+	if (conn->params.id >= 0)
+		clients[currentClient].status = CONNECTING;
+
+	updateCurrentClient(&currentClient);
+
+	moteurRecevoir(moteur, &conn->sockDial);
+
+}
+/**
+ * @brief      Réabonne un spectateur à la partie qu'il regardait avant la passation
+ *
+ * @param      params  paramètres du dialogue avec le spectateur
+ * @param      host    hôte de la partie
+ * @param[in]  cursor  prochain événement à lui émettre
+ */
+void resumeSpectator(eServThreadParams_t *params, char *host, uint32_t cursor) {
+
+	params->spectator = subscribeGame(&relay, host, params->sockDial, params);
+
+	// partie perdue en route : prévenu comme d'une fin de partie
+	if (params->spectator == NULL) {
+		queueResponse(params->sockDial, enum2status(ERR, SPECTATE), "Partie terminée.", NULL);
+		return;
+	}
+
+	// reprendre au premier événement qu'il n'a pas reçu, pas au dernier instantané
+	params->spectator->cursor = cursor;
+
+}
+/**
+ * @brief      Reprend une connexion transmise par l'instance précédente
+ *
+ * @param[in]  fd     descripteur de la socket de dialogue
+ * @param      state  état du dialogue au moment de la passation
+ */
+void adoptClient(int fd, handoffConnection_t *state) {
+
+	eServConnection_t 	*conn = openClient(fd, state->id);
+	socket_t 			*sockDial;
+
+	if (conn == NULL) {
+		if (state->id >= 0) {
+			unindexClient(&names, state->id);
+			clients[state->id].status = DISCONNECTED;
+		}
+		return;
+	}
+
+	sockDial 				= &conn->sockDial;
+	sockDial->nbEntree 		= state->nbEntree;
+	sockDial->rejet 		= state->rejet;
+	sockDial->nbSortie 		= state->nbSortie;
+	memcpy(sockDial->entree, state->entree, state->nbEntree);
+	memcpy(sockDial->sortie, state->sortie, state->nbSortie);
+	conn->params.closing 	= state->closing;
+	conn->params.hello 		= state->hello;
+
+	// le client reprend sa place dans la file de mise en relation
+	if (state->match.owner != NULL) {
+		conn->params.matchTicket = adoptTicket(&matchmaker, &state->match, &conn->params);
+		if (conn->params.matchTicket < 0)
+			queueResponse(sockDial, enum2status(ERR, MATCH), "File d'attente pleine.", NULL);
+	}
+
+	if (state->spectating[0] != '\0') resumeSpectator(&conn->params, state->spectating, state->cursor);
+
+	// reprendre là où l'instance précédente s'est arrêtée ; un spectateur n'a jamais
+	// d'émission en cours par le moteur d'E/S
+	if (sockDial->nbSortie > 0 && conn->params.spectator == NULL) moteurEnvoyer(moteur, sockDial);
+	else serviceClient(conn);
+
+}
+/**
+ * @brief      Transmet un événement d'une partie à la nouvelle instance
+ *
+ * @param      ctl       socket de contrôle connectée à la nouvelle instance
+ * @param      event     l'événement
+ * @param[in]  snapshot  1 si c'est le dernier instantané de la partie
+ *
+ * @return     0, -1 si la nouvelle instance a disparu
+ */
+int handOffEvent(socket_t *ctl, spectateEvent_t *event, int snapshot) {
+
+	handoffEvent_t record;
+
+	record.seq 		= event->seq;
+	record.snapshot = snapshot;
+	record.len 		= event->len;
+	memcpy(record.data, event->data, event->len);
+
+	return envoyerDescripteurs(ctl, NULL, 0, &record, sizeof(record));
+
+}
+/**
+ * @brief      Transmet les parties en cours et leurs derniers événements à la
+ *             nouvelle instance
+ *
+ * @param      ctl   socket de contrôle connectée à la nouvelle instance
+ *
+ * @return     0, -1 si la nouvelle instance a disparu
+ */
+int handOffGames(socket_t *ctl) {
+
+	for (spectateGame_t *game = relay.games; game != NULL; game = game->next) {
+
+		handoffGame_t 	record 	= {0};
+		uint32_t 		first 	= game->published > SPECTATE_RING ? game->published - SPECTATE_RING : 0;
+		// dernier instantané sorti de l'anneau : transmis à part, en premier
+		int 			outside = game->snapshot != NULL && game->snapshot->seq < first;
+
+		strcpy(record.host, game->host);
+		strcpy(record.owner, game->flow.owner);
+		record.state 		= game->flow.state;
+		record.moves 		= game->flow.moves;
+		record.published 	= game->published;
+		record.events 		= outside + (game->published - first);
+
+		if (envoyerDescripteurs(ctl, NULL, 0, &record, sizeof(record)) == -1) return -1;
+
+		if (outside && handOffEvent(ctl, game->snapshot, 1) == -1) return -1;
+
+		for (uint32_t seq = first; seq != game->published; seq++) {
+
+			spectateEvent_t *event = game->ring[seq % SPECTATE_RING];
+
+			if (handOffEvent(ctl, event, event == game->snapshot) == -1) return -1;
+
+		}
+
+	}
+
+	return 0;
+
+}
+/**
+ * @brief      Reprend les parties transmises par l'instance précédente
+ *
+ * @param      ctl     socket de contrôle connectée à l'instance précédente
+ * @param[in]  amount  nombre de parties transmises
+ *
+ * @return     0, -1 si l'instance précédente a disparu
+ */
+int adoptGames(socket_t *ctl, int amount) {
+
+	for (int i = 0; i < amount; i++) {
+
+		handoffGame_t 	record;
+		spectateGame_t 	*game;
+
+		if (recevoirDescripteurs(ctl, NULL, 0, &record, sizeof(record)) == -1) return -1;
+
+		game = adoptGame(&relay, record.host, record.state, record.owner, record.moves, record.published);
+
+		for (int j = 0; j < record.events; j++) {
+
+			handoffEvent_t event;
+
+			if (recevoirDescripteurs(ctl, NULL, 0, &event, sizeof(event)) == -1) return -1;
+
+			// partie non allouée : ses événements sont seulement lus
+			if (game != NULL) adoptEvent(game, event.seq, event.data, event.len, event.snapshot);
+
+		}
+
+	}
+
+	return 0;
+
+}
+/**
+ * @brief      Traite les événements rendus par le moteur d'E/S
+ *
+ * @param      evts  les événements
+ * @param[in]  nb    leur nombre
+ */
+void dispatchEvents(evenement_t *evts, int nb) {
+
+	for (int i = 0; i < nb; i++) {
+
+		eServConnection_t *conn = evts[i].ctx;
+
+		switch (evts[i].type) {
+
+			case EV_ACCEPTATION:
+				// nouvelle instance : la passation a lieu après ce lot d'événements
+				if (evts[i].sock == &sockUpgrade) {
+					if (fdUpgrade == -1) 	fdUpgrade = evts[i].res;
+					else 					close(evts[i].res);
+				}
+				else acceptClient(evts[i].res);
+				break;
+
+			case EV_RECEPTION:
+				// connexion fermée ou en erreur sans DELETE : le client est parti
+				if (evts[i].res <= 0) {
+					dropSrvEClient(&conn->params);
+					closeClient(conn);
+				}
+				else serviceClient(conn);
+				break;
+
+			case EV_EMISSION:
+				if (evts[i].res < 0) dropSrvEClient(&conn->params);
+				if (evts[i].res < 0 || conn->params.closing)
+					closeClient(conn);
+				else serviceClient(conn);
+				break;
+
+		}
+
+	}
+
+}
+/**
+ * @brief      Adresse de la socket de contrôle des mises à jour
+ *
+ * @param      adr   l'adresse à remplir (unix:/chemin)
+ * @param[in]  size  taille de adr
+ *
+ * @return     0 si les mises à jour sont désactivées (UPGRADE_ENV vide), 1 sinon
+ */
+int upgradeAddress(char *adr, size_t size) {
+
+	char *path = getenv(UPGRADE_ENV);
+
+	if (path == NULL) 	path = UPGRADE_FILE;
+	if (*path == '\0') 	return 0;
+
+	snprintf(adr, size, "%s%s", PREFIXE_UNIX, path);
+
+	return 1;
+
+}
+/**
+ * @brief      Ouvre la socket de contrôle sur laquelle une nouvelle instance peut
+ *             demander la passation
+ */
+void openUpgradeSocket() {
+
+	char adr[sizeof(((struct sockaddr_un *) 0)->sun_path) + sizeof(PREFIXE_UNIX)];
+
+	if (!upgradeAddress(adr, sizeof(adr))) return;
+
+	sockUpgrade = creerSocketEcoute(adr, 0);
+	moteurAjouter(moteur, &sockUpgrade, NULL);
+	moteurAccepter(moteur, &sockUpgrade);
+
+}
+/**
+ * @brief      Transmet la socket d'écoute, le registre et toutes les connexions à
+ *             la nouvelle instance connectée sur fdUpgrade, puis arrête le serveur
+ * 
+ * @note       en cas d'échec avant la transmission de la socket d'écoute, le
+ * 			   serveur continue comme si de rien n'était
+ */
+void handOff() {
+
+	socket_t 			ctl 	= fd2socket(fdUpgrade, SOCK_STREAM);
+	handoffHeader_t 	header 	= {0};
+	int 				fds[MAX_DESCRIPTEURS];
+	int 				nbFds 	= 0;
+	evenement_t 		evts[MAX_EVENEMENTS];
+	int 				nb;
+
+	fdUpgrade = -1;
+
+	// la nouvelle instance recrée la socket de contrôle à son tour
+	moteurRetirer(moteur, &sockUpgrade);
+	fermerSocketEcoute(&sockUpgrade);
+	sockUpgrade.fd = -1;
+
+	// ne plus accepter, puis traiter les connexions acceptées juste avant
+	moteurDetacher(moteur, &sockEcoute);
+	do {
+		nb = moteurAttendre(moteur, evts, MAX_EVENEMENTS, 0);
+		if (nb > 0) dispatchEvents(evts, nb);
+	} while (nb == MAX_EVENEMENTS);
+
+	header.magic 		= HANDOFF_MAGIC;
+	header.games 		= 0;
+	header.connections 	= liveAmount;
+	header.discovery 	= discoveryEnabled;
+	header.gossip 		= gossipEnabled;
+	header.port 		= portEcoute;
+	header.graceDeadline= graceDeadline;
+	memcpy(header.clients, clients, sizeof(clients));
+
+	for (spectateGame_t *game = relay.games; game != NULL; game = game->next) header.games++;
+
+	fds[nbFds++] = sockEcoute.fd;
+	if (discoveryEnabled) 	fds[nbFds++] = sockDecouverte.fd;
+	if (gossipEnabled) 		fds[nbFds++] = gossip.sock.fd;
+
+	if (envoyerDescripteurs(&ctl, fds, nbFds, &header, sizeof(header)) == -1) {
+		perror("Can't hand off");
+		close(ctl.fd);
+		moteurAjouter(moteur, &sockEcoute, NULL);
+		moteurAccepter(moteur, &sockEcoute);
+		openUpgradeSocket();
+		return;
+	}
+
+	// le registre n'est plus tenu à jour ici : ne plus l'écrire ni le répliquer
+	handedOff = 1;
+	closeSnapshot(&snapshot);
+	if (gossipEnabled) stopGossip(&gossip);
+
+	// une instance disparue en route ne reçoit pas non plus les connexions
+	if (handOffGames(&ctl) == -1) perror("Can't hand off games");
+
+	while (liveConnections != NULL) {
+
+		eServConnection_t 	*conn 		= liveConnections;
+		socket_t 			*sockDial 	= &conn->sockDial;
+		eServThreadParams_t *params 	= &conn->params;
+		handoffConnection_t state;
+
+		moteurDetacher(moteur, sockDial);
+
+		// le client garde sa place dans la file et la partie qu'il regarde ; le reste
+		// d'un événement entamé est recopié devant ses réponses
+		state.match 		= params->matchTicket >= 0
+			? matchmaker.tickets[params->matchTicket] : (matchTicket_t) {0};
+		state.spectating[0] = '\0';
+		state.cursor 		= 0;
+
+		if (params->spectator != NULL) {
+			strcpy(state.spectating, params->spectator->game->host);
+			state.cursor = params->spectator->cursor;
+			cancelSrvESpectate(params, NULL);
+		}
+
+		state.id 		= conn->params.id;
+		state.closing 	= conn->params.closing;
+		state.hello 	= conn->params.hello;
+		state.nbEntree 	= sockDial->nbEntree;
+		state.rejet 	= sockDial->rejet;
+		state.nbSortie 	= sockDial->nbSortie;
+		memcpy(state.entree, sockDial->entree, sockDial->nbEntree);
+		memcpy(state.sortie, sockDial->sortie, sockDial->nbSortie);
+
+		if (envoyerDescripteurs(&ctl, &sockDial->fd, 1, &state, sizeof(state)) == -1) {
+			// la nouvelle instance a disparu : servir soi-même les connexions restantes
+			perror("Can't hand off connection");
+			moteurAjouter(moteur, sockDial, conn);
+			if (state.spectating[0] != '\0') resumeSpectator(params, state.spectating, state.cursor);
+			if (sockDial->nbSortie > 0 && params->spectator == NULL) moteurEnvoyer(moteur, sockDial);
+			else serviceClient(conn);
+			break;
+		}
+
+		// la connexion reste ouverte dans la nouvelle instance, son ticket y est repris
+		cancelSrvEMatch(params, NULL);
+		close(sockDial->fd);
+		unlinkClient(conn);
+		poolFree(&connexions, conn);
+
+	}
+
+	close(ctl.fd);
+
+	if (liveConnections == NULL) stopServer = 1;
+
+}
+
+
+/**
+ * @brief      Démarre la découverte LAN sur une socket DGRAM
+ *
+ * @param      sock  socket de réponse aux sondes
+ * @param[in]  port  port d'écoute TCP annoncé
+ */
+void startDiscovery(socket_t sock, short port) {
+
+	discoveryEnabled 	= 1;
+	portEcoute 			= port;
+	sockDecouverte 		= sock;
+
+	pthread_create(&discoveryThread, 0, (void*)(void*) discoveryResponder, NULL);
+	pthread_detach(discoveryThread);
+
+}
+/**
+ * @brief      Commence la capture du trafic reçu si TRACE_ENV la demande
+ *
+ * @param[in]  takeover  1 si l'instance reprend une instance en cours (passation)
+ *
+ * @note       lors d'une passation, le fichier est suffixé du pid de la nouvelle
+ * 			   instance : la capture de l'instance en cours n'est pas remplacée
+ */
+void openServerTrace(int takeover) {
+
+	char *path = getenv(TRACE_ENV);
+	char suffixed[PATH_MAX];
+
+	if (path == NULL || *path == '\0') return;
+
+	if (takeover) {
+		snprintf(suffixed, sizeof(suffixed), "%s.%d", path, getpid());
+		path = suffixed;
+	}
+
+	// le serveur fonctionne aussi sans capture
+	if (openTrace(&traceLog, path) == -1) perror("Can't open trace");
+	else fprintf(stderr, "capture du trafic dans %s\n", path);
+
+}
+/**
+ * @brief      Crée le moteur d'E/S et lui confie la socket d'écoute
+ *
+ * @param[in]  takeover  1 si l'instance reprend une instance en cours (passation)
+ */
+void startEngine(int takeover) {
+
+	openServerTrace(takeover);
+
+	createPool(&connexions, sizeof(eServConnection_t), MAX_CONNEXIONS);
+	createMatchmaker(&matchmaker, MAX_CONNEXIONS);
+	createRelay(&relay, endSrvESpectate);
+	setupSrvEHandlers();
+
+	// + socket d'écoute et socket de contrôle des mises à jour
+	moteur = creerMoteur(MAX_CONNEXIONS + 2);
+	moteurAjouter(moteur, &sockEcoute, NULL);
+	moteurAccepter(moteur, &sockEcoute);
+
+#ifdef DEBUG_ENABLED
+	logMessage("Moteur d'E/S: %s.\n", DEBUG, nomMoteur());
+#endif
+
+}
+/**
+ * @brief      Boucle d'événements du serveur, jusqu'à SIGINT ou passation
+ */
+void runServer() {
+
+	int late 		= 0;
+	int deadline 	= WHEEL_IDLE;
+
+	openUpgradeSocket();
+
+	while (!stopServer) {
+
+		evenement_t evts[MAX_EVENEMENTS];
+		int 		timeout = late ? SPECTATE_RETRY : SNAPSHOT_PERIOD;
+		int 		nb;
+
+		// la prochaine échéance d'une partie écourte l'attente
+		if (deadline != WHEEL_IDLE && deadline < timeout) timeout = deadline;
+
+		nb = moteurAttendre(moteur, evts, MAX_EVENEMENTS, timeout);
+
+		if (nb == -1 && errno == EINTR) continue;
+		CHECK(nb, "Can't wait");
+
+		maintainRegistry();
+
+		// avant les événements : les échéances qu'ils réarment partent de maintenant
+		deadline = expireGames(&relay, wheelClock());
+		dispatchEvents(evts, nb);
+
+		// les spectateurs en retard sont repris sans jamais retenir les parties
+		late = flushRelay(&relay);
+
+		if (fdUpgrade != -1) handOff();
+
+		// passation incomplète : s'arrêter une fois les connexions restantes terminées
+		if (handedOff && liveConnections == NULL) stopServer = 1;
+
+	}
 
+	exit(EXIT_SUCCESS);
 
+}
 /**
  *	\fn				void serveur (char *adrIP, int port)
  *	\brief			lance un serveur STREAM en écoute sur l'adresse applicative adrIP:port
@@ -252,37 +1321,92 @@ void serveur (char *adrIP, int port) {
 	// sockEcoute est une variable externe
 	sockEcoute = creerSocketEcoute(adrIP, port);
 
-	while (1) {
+	// après l'écoute : une instance qui ne peut écouter ne touche pas à l'instantané
+	restoreRegistry();
+
+	// une socket locale n'est pas joignable depuis le LAN : pas de découverte
+	if (!estAdrUnix(adrIP))
+		startDiscovery(creerSocketAdr(SOCK_DGRAM, adrIP, DISCOVERY_PORT), port);
+
+	// une socket locale n'a pas d'adresse IP : bavarder sur toutes les interfaces
+	if (gossipPort() != 0)
+		startGossip(creerSocketAdr(SOCK_DGRAM, estAdrUnix(adrIP) ? IP_ANY : adrIP, gossipPort()));
+
+	startEngine(0);
+	runServer();
+
+}
+/**
+ * @brief      lance un serveur reprenant la socket d'écoute, le registre et les
+ *             connexions de l'instance en cours, sans interruption de service
+ */
+void takeOverServer() {
 
-		pthread_t 			thread;
-		eServThreadParams_t *params;
-		socket_t 			*sockDial;	// socket de dialogue avec un client	
+	char 				adr[sizeof(((struct sockaddr_un *) 0)->sun_path) + sizeof(PREFIXE_UNIX)];
+	socket_t 			ctl;
+	handoffHeader_t 	header;
+	int 				fds[MAX_DESCRIPTEURS];
+	int 				nbFds;
 
-		sockDial 	= malloc(sizeof(socket_t));
-		params 		= malloc(sizeof(eServThreadParams_t));
+	// même convention que openUpgradeSocket : l'instance en cours n'écoute pas
+	if (!upgradeAddress(adr, sizeof(adr))) {
+		fprintf(stderr, "Passation impossible : mises à jour désactivées (%s vide).\n", UPGRADE_ENV);
+		exit(EXIT_FAILURE);
+	}
 
-		// Accepter une connexion
-		*sockDial 	= accepterClt(sockEcoute);
+	initServer();
 
-		startDisplay				= 1;
+	// tant que la passation n'a pas abouti, la socket d'écoute est à l'instance en cours
+	handedOff 		= 1;
+	sockEcoute.fd 	= -1;
 
-		params->id 					= currentClient;
-		params->sockDial 			= sockDial;
-		params->clientArray 		= clients;
-		params->clientAmount		= MAX_CLIENTS;
-		params->terminationCallback = disconnectClient;
-		params->canAccept			= canAccept;
+	ctl 	= connecterClt2Srv(adr, 0);
+	nbFds 	= recevoirDescripteurs(&ctl, fds, MAX_DESCRIPTEURS, &header, sizeof(header));
 
-		if (canAccept())
-			clients[currentClient].status = CONNECTING;
+	if (nbFds < 1 || header.magic != HANDOFF_MAGIC || nbFds < 1 + header.discovery + header.gossip) {
+		fprintf(stderr, "Passation refusée : instance en cours incompatible.\n");
+		exit(EXIT_FAILURE);
+	}
 
-		pthread_create(&thread, 0, (void*)(void*) dialSrvE2Clt, params);
-		pthread_detach(thread);
+	handedOff 	= 0;
+	sockEcoute 	= fd2socket(fds[0], SOCK_STREAM);
+	if (header.discovery) startDiscovery(fd2socket(fds[1], SOCK_DGRAM), header.port);
 
-		updateCurrentClient(&currentClient);
+	memcpy(clients, header.clients, sizeof(clients));
+	rebuildNameIndex(&names);
+	graceDeadline = header.graceDeadline;
+	updateCurrentClient(&currentClient);
+
+	// le registre vient de l'instance précédente : l'instantané est seulement réécrit,
+	// une fois fermé par celle-ci (juste après l'en-tête de passation)
+	openRegistrySnapshot(1);
+
+	// même socket, nouvelle identité : les pairs oublieront celle de l'instance précédente
+	if (header.gossip) startGossip(fd2socket(fds[1 + header.discovery], SOCK_DGRAM));
+	startEngine(1);
+
+	// les parties d'abord : les spectateurs transmis ensuite s'y réabonnent
+	if (adoptGames(&ctl, header.games) == -1) header.connections = 0;
+
+	for (int i = 0; i < header.connections; i++) {
+
+		handoffConnection_t state;
+		int 				fd;
+
+		if (recevoirDescripteurs(&ctl, &fd, 1, &state, sizeof(state)) != 1) break;
+		adoptClient(fd, &state);
 
 	}
 
+	close(ctl.fd);
+
+	fprintf(stderr, "reprise du serveur [PID:%d] : %d connexion(s)\n", getpid(), liveAmount);
+
+	startDisplay = 1;
+	pthread_create(&displayThread, 0, (void*)(void*) displayClient, NULL);
+	pthread_detach(displayThread);
+
+	runServer();
 
 }
 
@@ -292,13 +1416,24 @@ void serveur (char *adrIP, int port) {
  * @param[in]  argc  The count of arguments
  * @param      argv  The arguments array
  *
+ * @return     0
  */
-void main(int argc, char **argv) {
+int main(int argc, char **argv) {
 
 	progName = argv[0];
 
-	if (argc<3) {
-		fprintf(stderr, "usage: %s @IP port\n", basename(progName));
+	if (argc == 2 && strcmp(argv[1], UPGRADE_OPTION) == 0) {
+		// nouvelle version : reprendre l'instance en cours
+		takeOverServer();
+	}
+	else if (argc == 2 && estAdrUnix(argv[1])) {
+		// socket locale : pas de port
+		fprintf(stderr,"lancement du serveur [PID:%d] sur l'adresse applicative [%s]\n",
+			getpid(), argv[1]);
+		serveur(argv[1], 0);
+	}
+	else if (argc<3) {
+		fprintf(stderr, "usage: %s @IP port | %s/chemin | %s\n", basename(progName), PREFIXE_UNIX, UPGRADE_OPTION);
 		/*exit(-1);*/
 		fprintf(stderr,"lancement du serveur [PID:%d] sur l'adresse applicative [%s:%d]\n",
 			getpid(), IP_ANY, PORT_SRV);
@@ -310,4 +1445,6 @@ void main(int argc, char **argv) {
 		serveur(argv[1], atoi(argv[2]));
 	}
 
+	return 0;
+
 }
\ No newline at end of file
@@ -0,0 +1,333 @@
+/**
+ *	\file		tournoi.c
+ *	\brief		tournoi entre les stratégies des bots, joué en mémoire sur tous les
+ *				cœurs (réglage des bots)
+ *	\author		ARCELON Louis
+ *	\date		19 octobre 2026
+ *	\version	1.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <math.h>
+
+#include <placement.h>
+#include <bot.h>
+/*
+*****************************************************************************************
+ *	\noop		D E F I N I T I O N   DES   C O N S T A N T E S
+ */
+/**
+ * @brief      parties par rencontre par défaut
+ */
+#define TOURNAMENT_GAMES 	10000
+/**
+ * @brief      graine par défaut du tournoi
+ */
+#define TOURNAMENT_SEED 	0x243F6A8885A308D3ULL
+/**
+ * @brief      parties réservées d'un coup par un thread
+ */
+#define TOURNAMENT_CHUNK 	256
+/**
+ * @brief      mot clé de la règle de placement sans contact entre navires
+ */
+#define NO_TOUCH_KEYWORD 	"isoles"
+/**
+ * @brief      quantile de la loi normale des intervalles de confiance à 95 %
+ */
+#define Z_95 				1.96
+/**
+ * @brief      nombre de rencontres : chaque paire de stratégies différentes
+ */
+#define PAIRINGS 			(BOT_STRATEGIES * (BOT_STRATEGIES - 1) / 2)
+/*
+*****************************************************************************************
+ *	\noop		S T R C T U R E S   DE   D O N N E E S
+ */
+/**
+ * @brief      résultats d'une stratégie dans une rencontre (ou sur tout le tournoi)
+ *
+ * @note       que des entiers : les totaux ne dépendent pas du nombre de threads
+ */
+typedef struct {
+
+	/** parties jouées */
+	unsigned long 		games;
+	/** parties gagnées */
+	unsigned long 		wins;
+	/** somme des tirs des parties gagnées */
+	unsigned long long 	shots;
+	/** somme de leurs carrés */
+	unsigned long long 	shotsSq;
+
+} score_t;
+/**
+ * @brief      thread du tournoi : ses propres totaux, fusionnés à la fin
+ */
+typedef struct {
+
+	/** totaux de chaque rencontre, pour chacune des deux stratégies */
+	score_t 	scores[PAIRINGS][2];
+	/** le thread */
+	pthread_t 	thread;
+
+} worker_t;
+/*
+*****************************************************************************************
+ *	\noop		D E C L A R A T I O N   DES   V A R I A B L E S    G L O B A L E S
+ */
+/**
+ *	\var		progName
+ *	\brief		Nom de l'exécutable : libnet nécessite cette variable qui pointe sur argv[0]
+ */
+char 				*progName;
+/**
+ * @brief      stratégies de chaque rencontre
+ */
+botStrategy_t 		pairings[PAIRINGS][2];
+/**
+ * @brief      parties par rencontre, graine du tournoi et règle de placement
+ */
+unsigned long 		gamesPerPairing = TOURNAMENT_GAMES;
+uint64_t 			tournamentSeed 	= TOURNAMENT_SEED;
+int 				placementRules 	= PLACE_ALLOW_TOUCH;
+/**
+ * @brief      prochaine partie à jouer (toutes rencontres confondues)
+ */
+unsigned long 		nextGame;
+/*
+*****************************************************************************************
+ *	\noop		I M P L E M E N T A T I O N   DES   F O N C T I O N S
+ */
+/**
+ * @brief      Horloge monotone en secondes
+ */
+static double nowS() {
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + now.tv_nsec / 1e9;
+
+}
+/**
+ * @brief      Graine d'une partie (splitmix64) : la même quel que soit le thread
+ */
+static uint64_t gameSeed(unsigned long game) {
+
+	uint64_t z = tournamentSeed + (game + 1) * 0x9E3779B97F4A7C15ULL;
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return z ^ (z >> 31);
+
+}
+/**
+ * @brief      Joue une partie entre deux stratégies
+ *
+ * @param      strategies  stratégie de chaque joueur (le joueur 0 commence)
+ * @param[in]  seed        graine de la partie
+ * @param      shots       tirs du vainqueur
+ *
+ * @return     le vainqueur
+ */
+static int playGame(botStrategy_t *strategies, uint64_t seed, int *shots) {
+
+	match_t match;
+	fleet_t fleet;
+	bot_t 	bots[2];
+
+	createMatch(&match, NULL);
+
+	for (int player = 0; player < 2; player++) {
+		randomFleet(&fleet, placementRules, &seed);
+		applyFleet(&match, player, &fleet);
+		createBot(&bots[player], strategies[player], nextRandom(&seed));
+	}
+
+	while (match.winner == NO_WINNER) {
+
+		int 			player 	= match.current;
+		int 			cell 	= botShot(&bots[player]);
+		shotResult_t 	result 	= fireAt(&match, player, cell);
+
+		botRecord(&bots[player], cell, result);
+
+	}
+
+	// le joueur 0 a tiré en premier
+	*shots = match.winner == 0 ? (match.turn + 1) / 2 : match.turn / 2;
+
+	return match.winner;
+
+}
+/**
+ * @brief      Thread du tournoi : réserve des parties tant qu'il en reste
+ *
+ * @param      worker  ses totaux
+ */
+void playTournament(worker_t *worker) {
+
+	unsigned long total = PAIRINGS * gamesPerPairing;
+
+	while (1) {
+
+		unsigned long first = __atomic_fetch_add(&nextGame, TOURNAMENT_CHUNK, __ATOMIC_RELAXED);
+
+		if (first >= total) return;
+
+		for (unsigned long game = first; game < first + TOURNAMENT_CHUNK && game < total; game++) {
+
+			int 			pairing = game / gamesPerPairing;
+			int 			swap 	= game % 2;
+			botStrategy_t 	strategies[2];
+			int 			winner, shots;
+			score_t 		*score;
+
+			// chaque stratégie commence une partie sur deux
+			strategies[0] 	= pairings[pairing][swap];
+			strategies[1] 	= pairings[pairing][1 - swap];
+
+			winner 	= playGame(strategies, gameSeed(game), &shots);
+			score 	= &worker->scores[pairing][winner ^ swap];
+
+			worker->scores[pairing][0].games++;
+			worker->scores[pairing][1].games++;
+
+			score->wins++;
+			score->shots 	+= shots;
+			score->shotsSq 	+= shots * shots;
+
+		}
+
+	}
+
+}
+/**
+ * @brief      Ajoute des totaux à d'autres
+ */
+static void addScore(score_t *to, score_t *from) {
+
+	to->games 	+= from->games;
+	to->wins 	+= from->wins;
+	to->shots 	+= from->shots;
+	to->shotsSq += from->shotsSq;
+
+}
+/**
+ * @brief      Affiche le taux de victoire (intervalle de Wilson) et les tirs moyens
+ *             pour gagner (intervalle normal) d'une stratégie
+ */
+static void printScore(botStrategy_t strategy, score_t *score) {
+
+	double n 		= score->games;
+	double p 		= n > 0 ? score->wins / n : 0;
+	double z2 		= Z_95 * Z_95;
+	double center 	= (p + z2 / (2 * n)) / (1 + z2 / n);
+	double half 	= Z_95 * sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / (1 + z2 / n);
+
+	printf("  %-8s victoires %5.1f %% [%5.1f ; %5.1f]", botStrategyName(strategy),
+		100 * p, 100 * (center - half), 100 * (center + half));
+
+	if (score->wins > 0) {
+
+		double mean 	= (double) score->shots / score->wins;
+		double var 		= score->wins > 1
+			? ((double) score->shotsSq - score->wins * mean * mean) / (score->wins - 1) : 0;
+
+		printf(", tirs pour gagner %.2f ± %.2f", mean, Z_95 * sqrt(var / score->wins));
+
+	}
+
+	putchar('\n');
+
+}
+/**
+ * @brief      Point d'entrée : tournament [parties [threads [graine [isoles]]]]
+ *
+ * 			   chaque paire de stratégies joue le nombre de parties donné par
+ * 			   rencontre ; les graines des parties ne dépendent que de la graine du
+ * 			   tournoi, les résultats sont donc les mêmes quel que soit le nombre de
+ * 			   threads (par défaut : un par cœur)
+ */
+int main(int argc, char **argv) {
+
+	worker_t 	*workers;
+	score_t 	totals[BOT_STRATEGIES];
+	int 		threads = argc > 2 ? atoi(argv[2]) : sysconf(_SC_NPROCESSORS_ONLN);
+	int 		pairing = 0;
+	double 		start, elapsed;
+
+	progName = argv[0];
+
+	if (argc > 1) gamesPerPairing 	= strtoul(argv[1], NULL, 10);
+	if (argc > 3) tournamentSeed 	= strtoull(argv[3], NULL, 0);
+	if (argc > 4 && strcmp(argv[4], NO_TOUCH_KEYWORD) == 0) placementRules = PLACE_NO_TOUCH;
+
+	if (gamesPerPairing == 0 || threads <= 0) {
+		fprintf(stderr, "Usage: %s [parties [threads [graine [%s]]]]\n", argv[0], NO_TOUCH_KEYWORD);
+		exit(EXIT_FAILURE);
+	}
+
+	for (int a = 0; a < BOT_STRATEGIES; a++) {
+		for (int b = a + 1; b < BOT_STRATEGIES; b++) {
+			pairings[pairing][0] 	= a;
+			pairings[pairing++][1] 	= b;
+		}
+	}
+
+	workers = calloc(threads, sizeof(worker_t));
+	if (workers == NULL) {
+		perror("Can't allocate workers");
+		exit(EXIT_FAILURE);
+	}
+
+	start = nowS();
+
+	for (int i = 0; i < threads; i++)
+		pthread_create(&workers[i].thread, 0, (void*)(void*) playTournament, &workers[i]);
+
+	for (int i = 0; i < threads; i++) pthread_join(workers[i].thread, NULL);
+
+	elapsed = nowS() - start;
+
+	memset(totals, 0, sizeof(totals));
+
+	for (pairing = 0; pairing < PAIRINGS; pairing++) {
+
+		score_t scores[2];
+
+		memset(scores, 0, sizeof(scores));
+
+		for (int i = 0; i < threads; i++) {
+			addScore(&scores[0], &workers[i].scores[pairing][0]);
+			addScore(&scores[1], &workers[i].scores[pairing][1]);
+		}
+
+		printf("%s - %s\n", botStrategyName(pairings[pairing][0]), botStrategyName(pairings[pairing][1]));
+
+		for (int side = 0; side < 2; side++) {
+			printScore(pairings[pairing][side], &scores[side]);
+			addScore(&totals[pairings[pairing][side]], &scores[side]);
+		}
+
+	}
+
+	printf("Classement\n");
+	for (int strategy = 0; strategy < BOT_STRATEGIES; strategy++) printScore(strategy, &totals[strategy]);
+
+	printf("Parties: %lu en %.2f s sur %d threads (%.0f parties/s, %.1f millions/h)\n",
+		PAIRINGS * gamesPerPairing, elapsed, threads,
+		PAIRINGS * gamesPerPairing / elapsed, PAIRINGS * gamesPerPairing / elapsed * 3600 / 1e6);
+
+	free(workers);
+
+	return 0;
+
+}